@@ -164,10 +164,32 @@ class V8_PLATFORM_EXPORT TraceBuffer {
   virtual TraceObject* GetEventByHandle(uint64_t handle) = 0;
   virtual bool Flush() = 0;
 
+  // Called after the event with |handle| has been initialized. Buffers that
+  // write events out while tracing is still running use this and
+  // UpdateTraceEventDuration() to find out when an event is final.
+  virtual void CommitTraceEvent(uint64_t handle) {}
+  // Updates the duration of the complete event with |handle| unless it has
+  // been dropped or flushed already.
+  virtual void UpdateTraceEventDuration(uint64_t handle, int64_t timestamp,
+                                        int64_t cpu_timestamp) {
+    TraceObject* trace_object = GetEventByHandle(handle);
+    if (trace_object) trace_object->UpdateDuration(timestamp, cpu_timestamp);
+  }
+  // Whether events are only accessed by the thread that added them until they
+  // are committed, and the buffer synchronizes Flush() with such threads. The
+  // TracingController serializes the initialization of events otherwise.
+  virtual bool IsPerThread() const { return false; }
+
   static const size_t kRingBufferChunks = 1024;
 
   static TraceBuffer* CreateTraceBufferRingBuffer(size_t max_chunks,
                                                   TraceWriter* trace_writer);
+  // Creates a buffer in which every thread adds events to its own chunk
+  // without contending with other threads. Full chunks are written to
+  // |trace_writer| on a background thread, the remaining ones on Flush().
+  // Events are dropped if all |max_chunks| chunks are in use.
+  static TraceBuffer* CreateTraceBufferPerThread(size_t max_chunks,
+                                                 TraceWriter* trace_writer);
 
  private:
   // Disallow copy and assign
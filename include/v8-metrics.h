@@ -48,7 +48,75 @@ struct WasmModulesPerIsolate {
   size_t count = 0;
 };
 
+struct GarbageCollectionPhases {
+  int64_t compact_wall_clock_duration_in_us = -1;
+  int64_t mark_wall_clock_duration_in_us = -1;
+  int64_t sweep_wall_clock_duration_in_us = -1;
+  int64_t weak_wall_clock_duration_in_us = -1;
+};
+
+struct GarbageCollectionSizes {
+  int64_t bytes_before = -1;
+  int64_t bytes_after = -1;
+  int64_t bytes_freed = -1;
+};
+
+struct GarbageCollectionFullCycle {
+  // Static string describing why the collection was triggered.
+  const char* reason = nullptr;
+  bool reduce_memory = false;
+  // Time spent on the main thread in the final atomic pause and in the
+  // incremental marking steps leading up to it.
+  int64_t atomic_pause_wall_clock_duration_in_us = -1;
+  int64_t incremental_marking_wall_clock_duration_in_us = -1;
+  // Breakdown of the atomic pause.
+  GarbageCollectionPhases main_thread;
+  // Time spent by background threads, summed over all threads. Background
+  // work on weak objects is not tracked separately.
+  GarbageCollectionPhases background;
+  GarbageCollectionSizes objects;
+  GarbageCollectionSizes memory;
+};
+
+struct GarbageCollectionYoungCycle {
+  // Static string describing why the collection was triggered.
+  const char* reason = nullptr;
+  int64_t total_wall_clock_duration_in_us = -1;
+  int64_t background_wall_clock_duration_in_us = -1;
+  int64_t young_object_bytes_before = -1;
+  int64_t survived_bytes = -1;
+  GarbageCollectionSizes objects;
+};
+
+struct TurbofanCompileJob {
+  bool success = false;
+  bool osr = false;
+  bool concurrent = false;
+  size_t bytecode_size_in_bytes = 0;
+  size_t code_size_in_bytes = 0;
+  // Prepare and finalize run on the main thread, execute runs on a background
+  // thread for concurrent jobs.
+  int64_t prepare_wall_clock_duration_in_us = -1;
+  int64_t execute_wall_clock_duration_in_us = -1;
+  int64_t finalize_wall_clock_duration_in_us = -1;
+};
+
+struct Deoptimization {
+  // Static strings describing the kind of the deoptimization, e.g.
+  // "deopt-eager", and its reason, e.g. "wrong map".
+  const char* kind = nullptr;
+  const char* reason = nullptr;
+  // Script and offset in the script of the deoptimization point, -1 if
+  // unknown.
+  int script_id = -1;
+  int position = -1;
+};
+
 #define V8_MAIN_THREAD_METRICS_EVENTS(V) \
+  V(GarbageCollectionFullCycle)          \
+  V(GarbageCollectionYoungCycle)         \
+  V(TurbofanCompileJob)                  \
+  V(Deoptimization)                      \
   V(WasmModuleDecoded)                   \
   V(WasmModuleCompiled)                  \
   V(WasmModuleInstantiated)              \
@@ -81,6 +149,10 @@ struct WasmModulesPerIsolate {
  * The embedder is expected to call v8::Isolate::SetMetricsRecorder()
  * providing its implementation and have the virtual methods overwritten
  * for the events it cares about.
+ *
+ * Garbage collection and deoptimization events are delivered while V8 is in
+ * the middle of the operation, so their handlers must not call into V8
+ * other than through Recorder::GetContext().
  */
 class V8_EXPORT Recorder {
  public:
@@ -55,6 +55,16 @@ template class V8_EXPORT std::vector<v8::CpuProfileDeoptInfo>;
 
 namespace v8 {
 
+/**
+ * Hardware performance counters which can drive CPU profiling, see
+ * CpuProfiler::SetHardwareCounterSampling.
+ */
+enum CpuProfilingCounter {
+  kCpuCycles,
+  kCpuCacheMisses,
+  kCpuBranchMisses,
+};
+
 /**
  * CpuProfileNode represents a node in a call graph.
  */
@@ -145,6 +155,13 @@ class V8_EXPORT CpuProfileNode {
     */
   unsigned GetHitCount() const;
 
+  /**
+   * Returns the number of |counter| events attributed to samples where the
+   * function was currently executing. Always zero unless the profile was
+   * recorded with CpuProfiler::SetHardwareCounterSampling.
+   */
+  uint64_t GetCounterValue(CpuProfilingCounter counter) const;
+
   /** Returns id of the node. The id is unique within the tree */
   unsigned GetNodeId() const;
 
@@ -289,6 +306,32 @@ class V8_EXPORT CpuProfilingOptions {
   int sampling_interval_us_;
 };
 
+/**
+ * Receives the output of continuous CPU profiling, see
+ * CpuProfiler::StartContinuousProfiling.
+ */
+class V8_EXPORT ContinuousProfileDelegate {
+ public:
+  virtual ~ContinuousProfileDelegate() = default;
+
+  /**
+   * Called with one serialized pprof Profile message
+   * (https://github.com/google/pprof/blob/master/proto/profile.proto)
+   * covering the samples taken since the previous call. Each chunk is self
+   * contained, with its own string, function and location tables. The data
+   * is only valid for the duration of the call.
+   *
+   * Called on the profiler thread after the chunk has been taken out of the
+   * profiler, so starting and stopping profiles is not blocked by the call.
+   * No further samples are processed until it returns, though, so
+   * implementations should hand the data off and return quickly. The last
+   * chunk is delivered from StopContinuousProfiling (or DeleteAllProfiles,
+   * which stops continuous profiling), which also waits for a call in
+   * progress on the profiler thread.
+   */
+  virtual void OnProfileChunk(const uint8_t* data, size_t size) = 0;
+};
+
 /**
  * Interface for controlling CPU profiling. Instance of the
  * profiler can be created using v8::CpuProfiler::New method.
@@ -332,6 +375,22 @@ class V8_EXPORT CpuProfiler {
    */
   void SetUsePreciseSampling(bool);
 
+  /**
+   * Takes samples on the overflow of a hardware performance counter instead
+   * of on a timer: a sample is taken every |period| |trigger| events on the
+   * profiled thread. All counters are read with every sample and the events
+   * since the previous sample are attributed to its top node, see
+   * CpuProfileNode::GetCounterValue. A period of zero restores timer based
+   * sampling.
+   *
+   * Only supported on Linux, where it needs access to perf_event_open(2) for
+   * the profiled thread. Returns false if the counters cannot be opened, in
+   * which case timer based sampling is used. This method must be called when
+   * there are no profiles being recorded.
+   */
+  bool SetHardwareCounterSampling(CpuProfilingCounter trigger,
+                                  uint64_t period);
+
   /**
    * Starts collecting a CPU profile. Title may be an empty string. Several
    * profiles may be collected at once. Attempts to start collecting several
@@ -366,6 +425,28 @@ class V8_EXPORT CpuProfiler {
    */
   CpuProfile* StopProfiling(Local<String> title);
 
+  /**
+   * Starts continuous profiling. Rather than building a profile tree until
+   * profiling is stopped, samples are aggregated by stack in a bounded
+   * window which is handed to |delegate| as a pprof profile whenever it
+   * spans |flush_interval_ms| or holds |max_stacks| distinct stacks. A due
+   * window is delivered even if no further samples are taken. Samples
+   * are taken at the profiler's sampling interval, which should be chosen to
+   * keep the overhead acceptable for always-on use.
+   *
+   * Continuous profiling can run alongside regular profiles. Returns false if
+   * continuous profiling is already active.
+   */
+  bool StartContinuousProfiling(ContinuousProfileDelegate* delegate,
+                                int flush_interval_ms = 10000,
+                                size_t max_stacks = 10000);
+
+  /**
+   * Stops continuous profiling and flushes the remaining samples to the
+   * delegate before returning.
+   */
+  void StopContinuousProfiling();
+
   /**
    * Generate more detailed source positions to code objects. This results in
    * better results when mapping profiling samples to script source.
@@ -503,7 +584,8 @@ class V8_EXPORT OutputStream {  // NOLINT
 class V8_EXPORT HeapSnapshot {
  public:
   enum SerializationFormat {
-    kJSON = 0  // See format description near 'Serialize' method.
+    kJSON = 0,   // See format description near 'Serialize' method.
+    kBinary = 1  // See format description near 'Serialize' method.
   };
 
   /** Returns the root node of the heap graph. */
@@ -553,6 +635,26 @@ class V8_EXPORT HeapSnapshot {
    *
    * Nodes reference strings, other nodes, and edges by their indexes
    * in corresponding arrays.
+   *
+   * The binary format carries the same nodes, edges, locations and strings
+   * in a more compact form that is considerably cheaper to produce. It is
+   * written through WriteAsciiChunk, but chunks may contain arbitrary bytes.
+   * Every integer is an unsigned LEB128 varint:
+   *
+   *    "V8HS" magic, version, string_slots, node_count, edge_count,
+   *    nodes: node_count x (type, name, id, self_size, edge_count,
+   *                         trace_node_id, detachedness),
+   *    edges: edge_count x (type, name_or_index, to_node),
+   *    location_count, locations: (node, script_id, line, column)
+   *
+   * Strings (node names and the names of edges other than element and
+   * hidden edges) are written inline: a varint (slot << 1 | 1) followed by
+   * byte_length and the UTF-8 bytes stores the string in |slot|, and a
+   * varint (slot << 1) refers to the string last stored there. A reader
+   * therefore only needs to keep |string_slots| strings.
+   *
+   * Unlike the JSON format, |to_node| and location |node| fields are node
+   * ordinals, and allocation trace data is not included.
    */
   void Serialize(OutputStream* stream,
                  SerializationFormat format = kJSON) const;
@@ -794,6 +896,11 @@ class V8_EXPORT HeapProfiler {
   enum SamplingFlags {
     kSamplingNoFlags = 0,
     kSamplingForceGC = 1 << 0,
+    /**
+     * Only keep per allocation site totals instead of individual samples,
+     * see GetAllocationSiteUpdates.
+     */
+    kSamplingAggregateBySite = 1 << 1,
   };
 
   /**
@@ -867,6 +974,33 @@ class V8_EXPORT HeapProfiler {
       ObjectNameResolver* global_object_name_resolver = nullptr,
       bool treat_global_objects_as_roots = true);
 
+  /**
+   * Aggregated retained size information for all objects sharing a
+   * constructor name. Objects without a JS constructor are grouped into
+   * categories such as "(string)" or "(compiled code)".
+   */
+  struct RetainedSizeSummaryEntry {
+    std::string name;
+    size_t count;
+    size_t self_size;
+    size_t retained_size;
+  };
+
+  /**
+   * Computes retained sizes aggregated by constructor name and returns the
+   * |max_entries| largest ones. An object only adds to the retained size of
+   * its constructor if it is not dominated by another object with the same
+   * constructor, so the numbers are comparable to the DevTools summary view.
+   *
+   * This computes exact dominators for all objects reachable from the roots
+   * and blocks the isolate until it is done: it walks the heap twice in a
+   * single pause. The pause and the temporary memory, about 50 bytes per
+   * object and 4 bytes per reference, grow with the heap. It does not
+   * create a HeapSnapshot and does not trigger a GC.
+   */
+  std::vector<RetainedSizeSummaryEntry> GetRetainedSizeSummary(
+      size_t max_entries = 20);
+
   /**
    * Starts tracking of heap objects population statistics. After calling
    * this method, all heap objects relocations done by the garbage collector
@@ -945,6 +1079,37 @@ class V8_EXPORT HeapProfiler {
    */
   AllocationProfile* GetAllocationProfile();
 
+  /**
+   * Totals of an allocation site, i.e. a node of the sampled allocation
+   * profile tree, as reported by GetAllocationSiteUpdates. Counts and sizes
+   * are estimates scaled from the samples. |name| is owned by the profiler
+   * and valid until StopSamplingHeapProfiler is called.
+   */
+  struct AllocationSiteUpdate {
+    uint32_t node_id;
+    // 0 for children of the root node.
+    uint32_t parent_id;
+    const char* name;
+    int script_id;
+    int start_position;
+    size_t allocated_count;
+    size_t allocated_bytes;
+    size_t live_count;
+    size_t live_bytes;
+  };
+
+  /**
+   * Returns the allocation sites whose totals changed since the previous
+   * call, when sampling was started with kSamplingAggregateBySite. In that
+   * mode sampled objects are only referenced from a weak table, and the live
+   * totals are updated after each mark-compact GC, so polling this is cheap
+   * even at small sampling intervals. Sampled objects survive scavenges until
+   * the next mark-compact GC. Node ids match those of GetAllocationProfile, which
+   * keeps working but returns no samples. Returns an empty vector if the
+   * sampling heap profiler is not active in that mode.
+   */
+  std::vector<AllocationSiteUpdate> GetAllocationSiteUpdates();
+
   /**
    * Deletes all snapshots taken. All previously returned pointers to
    * snapshots and their contents become invalid after this call.
@@ -7750,6 +7750,69 @@ class V8_EXPORT HeapCodeStatistics {
   friend class Isolate;
 };
 
+/**
+ * Deoptimizations of an optimized function for a single reason, see
+ * Isolate::GetDeoptimizationStatistics().
+ */
+struct DeoptimizationStatisticsEntry {
+  /** Name of the function, only valid during VisitEntry(). */
+  const char* function_name;
+  /** Script of the function and offset of the function in the script. */
+  int script_id;
+  int function_position;
+  /** Static string describing the reason, e.g. "wrong map". */
+  const char* reason;
+  /** Number of deoptimizations for this reason. */
+  size_t count;
+  /**
+   * Script and offset in the script of the last deoptimization for this
+   * reason, -1 if unknown. The deoptimization point may lie in a function
+   * that has been inlined into this one.
+   */
+  int last_script_id;
+  int last_position;
+  /**
+   * Number of times the function has been optimized again after it has been
+   * deoptimized for the first time, for any reason.
+   */
+  size_t reoptimization_count;
+};
+
+class V8_EXPORT DeoptimizationStatisticsVisitor {
+ public:
+  virtual ~DeoptimizationStatisticsVisitor() = default;
+  virtual void VisitEntry(const DeoptimizationStatisticsEntry& entry) = 0;
+};
+
+/**
+ * A property access inline cache that has seen several receiver maps, see
+ * Isolate::GetInlineCacheCensus().
+ */
+struct InlineCacheSite {
+  /** Name of the function, only valid during VisitSite(). */
+  const char* function_name;
+  /** Script and offset in the script of the property access, -1 if unknown. */
+  int script_id;
+  int position;
+  /** Static string describing the kind of access, e.g. "LoadProperty". */
+  const char* kind;
+  /**
+   * Whether the cache has given up on tracking maps, in which case accesses
+   * go through the megamorphic stub cache.
+   */
+  bool megamorphic;
+  /** Number of receiver maps of a polymorphic site, 0 if megamorphic. */
+  int map_count;
+  /** Number of invocations of the function, as a measure of hotness. */
+  int invocation_count;
+};
+
+class V8_EXPORT InlineCacheSiteVisitor {
+ public:
+  virtual ~InlineCacheSiteVisitor() = default;
+  virtual void VisitSite(const InlineCacheSite& site) = 0;
+};
+
 /**
  * A JIT code event is issued each time code is added, moved or removed.
  *
@@ -8763,6 +8826,30 @@ class V8_EXPORT Isolate {
    */
   bool GetHeapCodeAndMetadataStatistics(HeapCodeStatistics* object_statistics);
 
+  /**
+   * Reports the deoptimizations of each function by reason, recorded since
+   * the isolate has been created or the statistics have been reset. Functions
+   * caught in a deoptimization loop show up with high counts for the same
+   * reason and matching reoptimization counts. The visitor must not call
+   * into V8.
+   */
+  void GetDeoptimizationStatistics(DeoptimizationStatisticsVisitor* visitor);
+
+  /**
+   * Clears the statistics reported by GetDeoptimizationStatistics().
+   */
+  void ResetDeoptimizationStatistics();
+
+  /**
+   * Reports up to |max_sites| polymorphic and megamorphic property access
+   * inline caches. Megamorphic sites are reported first, then sites are
+   * ordered by how often their function has been invoked. Walks all feedback
+   * in the heap, so this is expensive, but nothing is recorded in between.
+   * The visitor must not call into V8.
+   */
+  void GetInlineCacheCensus(InlineCacheSiteVisitor* visitor,
+                            size_t max_sites);
+
   /**
    * This API is experimental and may change significantly.
    *
@@ -37,6 +37,7 @@
 #include "src/debug/debug-type-profile.h"
 #include "src/debug/debug.h"
 #include "src/debug/liveedit.h"
+#include "src/deoptimizer/deoptimization-statistics.h"
 #include "src/deoptimizer/deoptimizer.h"
 #include "src/diagnostics/gdb-jit.h"
 #include "src/execution/execution.h"
@@ -52,6 +53,7 @@
 #include "src/handles/persistent-handles.h"
 #include "src/heap/embedder-tracing.h"
 #include "src/heap/heap-inl.h"
+#include "src/ic/ic-census.h"
 #include "src/init/bootstrapper.h"
 #include "src/init/icu_util.h"
 #include "src/init/startup-data-util.h"
@@ -8688,6 +8690,26 @@ bool Isolate::GetHeapCodeAndMetadataStatistics(
   return true;
 }
 
+void Isolate::GetDeoptimizationStatistics(
+    DeoptimizationStatisticsVisitor* visitor) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->deoptimization_statistics()->Visit(visitor);
+}
+
+void Isolate::ResetDeoptimizationStatistics() {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->deoptimization_statistics()->Reset();
+}
+
+void Isolate::GetInlineCacheCensus(InlineCacheSiteVisitor* visitor,
+                                   size_t max_sites) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::HandleScope scope(isolate);
+  i::ICCensus census(isolate);
+  census.Collect(max_sites);
+  census.Report(visitor);
+}
+
 v8::MaybeLocal<v8::Promise> Isolate::MeasureMemory(
     v8::Local<v8::Context> context, MeasureMemoryMode mode) {
   return v8::MaybeLocal<v8::Promise>();
@@ -10262,6 +10284,30 @@ void debug::EnumerateRuntimeCallCounters(v8::Isolate* v8_isolate,
   }
 }
 
+void debug::StartSampledRuntimeCallStats(unsigned sampling_interval) {
+  DCHECK_LT(0u, sampling_interval);
+  i::TracingFlags::runtime_stats_sampling_interval.store(
+      sampling_interval, std::memory_order_relaxed);
+  i::TracingFlags::runtime_stats.fetch_or(
+      v8::tracing::TracingCategoryObserver::ENABLED_BY_SAMPLED_STATS,
+      std::memory_order_relaxed);
+}
+
+void debug::StopSampledRuntimeCallStats() {
+  i::TracingFlags::runtime_stats.fetch_and(
+      ~v8::tracing::TracingCategoryObserver::ENABLED_BY_SAMPLED_STATS,
+      std::memory_order_relaxed);
+  i::TracingFlags::runtime_stats_sampling_interval.store(
+      0, std::memory_order_relaxed);
+}
+
+void debug::TakeRuntimeCallHistograms(v8::Isolate* v8_isolate,
+                                      RuntimeCallHistogramCallback callback) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(v8_isolate);
+  if (!isolate->counters()) return;
+  isolate->counters()->runtime_call_stats()->TakeHistograms(callback);
+}
+
 int debug::GetDebuggingId(v8::Local<v8::Function> function) {
   i::Handle<i::JSReceiver> callable = v8::Utils::OpenHandle(*function);
   if (!callable->IsJSFunction()) return i::DebugInfo::kNoDebuggingId;
@@ -10599,6 +10645,10 @@ unsigned CpuProfileNode::GetHitCount() const {
   return reinterpret_cast<const i::ProfileNode*>(this)->self_ticks();
 }
 
+uint64_t CpuProfileNode::GetCounterValue(CpuProfilingCounter counter) const {
+  return reinterpret_cast<const i::ProfileNode*>(this)->counter(counter);
+}
+
 unsigned CpuProfileNode::GetNodeId() const {
   return reinterpret_cast<const i::ProfileNode*>(this)->id();
 }
@@ -10705,6 +10755,12 @@ void CpuProfiler::SetUsePreciseSampling(bool use_precise_sampling) {
       use_precise_sampling);
 }
 
+bool CpuProfiler::SetHardwareCounterSampling(CpuProfilingCounter trigger,
+                                             uint64_t period) {
+  return reinterpret_cast<i::CpuProfiler*>(this)->SetHardwareCounterSampling(
+      trigger, period);
+}
+
 void CpuProfiler::StartProfiling(Local<String> title,
                                  CpuProfilingOptions options) {
   reinterpret_cast<i::CpuProfiler*>(this)->StartProfiling(
@@ -10732,6 +10788,24 @@ CpuProfile* CpuProfiler::StopProfiling(Local<String> title) {
           *Utils::OpenHandle(*title)));
 }
 
+bool CpuProfiler::StartContinuousProfiling(ContinuousProfileDelegate* delegate,
+                                           int flush_interval_ms,
+                                           size_t max_stacks) {
+  Utils::ApiCheck(delegate != nullptr,
+                  "v8::CpuProfiler::StartContinuousProfiling",
+                  "delegate must not be null");
+  Utils::ApiCheck(flush_interval_ms > 0 && max_stacks > 0,
+                  "v8::CpuProfiler::StartContinuousProfiling",
+                  "flush limits must be positive");
+  return reinterpret_cast<i::CpuProfiler*>(this)->StartContinuousProfiling(
+      delegate, base::TimeDelta::FromMilliseconds(flush_interval_ms),
+      max_stacks);
+}
+
+void CpuProfiler::StopContinuousProfiling() {
+  reinterpret_cast<i::CpuProfiler*>(this)->StopContinuousProfiling();
+}
+
 void CpuProfiler::UseDetailedSourcePositionsForProfiling(Isolate* isolate) {
   reinterpret_cast<i::Isolate*>(isolate)
       ->set_detailed_source_positions_for_profiling(true);
@@ -10918,10 +10992,16 @@ SnapshotObjectId HeapSnapshot::GetMaxSnapshotJSObjectId() const {
 
 void HeapSnapshot::Serialize(OutputStream* stream,
                              HeapSnapshot::SerializationFormat format) const {
-  Utils::ApiCheck(format == kJSON, "v8::HeapSnapshot::Serialize",
+  Utils::ApiCheck(format == kJSON || format == kBinary,
+                  "v8::HeapSnapshot::Serialize",
                   "Unknown serialization format");
   Utils::ApiCheck(stream->GetChunkSize() > 0, "v8::HeapSnapshot::Serialize",
                   "Invalid stream chunk size");
+  if (format == kBinary) {
+    i::HeapSnapshotBinarySerializer serializer(ToInternal(this));
+    serializer.Serialize(stream);
+    return;
+  }
   i::HeapSnapshotJSONSerializer serializer(ToInternal(this));
   serializer.Serialize(stream);
 }
@@ -10967,6 +11047,12 @@ const HeapSnapshot* HeapProfiler::TakeHeapSnapshot(
           control, resolver, treat_global_objects_as_roots));
 }
 
+std::vector<HeapProfiler::RetainedSizeSummaryEntry>
+HeapProfiler::GetRetainedSizeSummary(size_t max_entries) {
+  return reinterpret_cast<i::HeapProfiler*>(this)->GetRetainedSizeSummary(
+      max_entries);
+}
+
 void HeapProfiler::StartTrackingHeapObjects(bool track_allocations) {
   reinterpret_cast<i::HeapProfiler*>(this)->StartHeapObjectsTracking(
       track_allocations);
@@ -10997,6 +11083,11 @@ AllocationProfile* HeapProfiler::GetAllocationProfile() {
   return reinterpret_cast<i::HeapProfiler*>(this)->GetAllocationProfile();
 }
 
+std::vector<HeapProfiler::AllocationSiteUpdate>
+HeapProfiler::GetAllocationSiteUpdates() {
+  return reinterpret_cast<i::HeapProfiler*>(this)->GetAllocationSiteUpdates();
+}
+
 void HeapProfiler::DeleteAllHeapSnapshots() {
   reinterpret_cast<i::HeapProfiler*>(this)->DeleteAllSnapshots();
 }
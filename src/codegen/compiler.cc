@@ -26,6 +26,7 @@
 #include "src/compiler/pipeline.h"
 #include "src/debug/debug.h"
 #include "src/debug/liveedit.h"
+#include "src/deoptimizer/deoptimization-statistics.h"
 #include "src/diagnostics/code-tracer.h"
 #include "src/execution/frames-inl.h"
 #include "src/execution/isolate-inl.h"
@@ -39,6 +40,7 @@
 #include "src/init/bootstrapper.h"
 #include "src/interpreter/interpreter.h"
 #include "src/logging/log-inl.h"
+#include "src/logging/metrics.h"
 #include "src/objects/feedback-cell-inl.h"
 #include "src/objects/js-function-inl.h"
 #include "src/objects/map.h"
@@ -442,6 +444,33 @@ void OptimizedCompilationJob::RecordCompilationStats(CompilationMode mode,
   }
 }
 
+void OptimizedCompilationJob::RecordMetricsEvent(CompilationMode mode,
+                                                 Isolate* isolate) const {
+  if (!isolate->metrics_recorder()->HasEmbedderRecorder()) return;
+  HandleScope scope(isolate);
+  v8::metrics::TurbofanCompileJob event;
+  event.success = state() == State::kSucceeded;
+  event.osr = compilation_info()->is_osr();
+  event.concurrent = mode == kConcurrent;
+  if (compilation_info()->has_bytecode_array()) {
+    event.bytecode_size_in_bytes =
+        compilation_info()->bytecode_array()->length();
+  }
+  if (event.success) {
+    event.code_size_in_bytes = compilation_info()->code()->InstructionSize();
+  }
+  event.prepare_wall_clock_duration_in_us =
+      time_taken_to_prepare_.InMicroseconds();
+  event.execute_wall_clock_duration_in_us =
+      time_taken_to_execute_.InMicroseconds();
+  event.finalize_wall_clock_duration_in_us =
+      time_taken_to_finalize_.InMicroseconds();
+  Handle<NativeContext> native_context(
+      compilation_info()->closure()->native_context(), isolate);
+  isolate->metrics_recorder()->AddMainThreadEvent(
+      event, isolate->GetOrRegisterRecorderContextId(native_context));
+}
+
 void OptimizedCompilationJob::RecordFunctionCompilation(
     CodeEventListener::LogEventsAndTags tag, Isolate* isolate) const {
   Handle<AbstractCode> abstract_code =
@@ -956,11 +985,15 @@ bool GetOptimizedCodeNow(OptimizedCompilationJob* job, Isolate* isolate,
           CompilationJob::SUCCEEDED ||
       job->FinalizeJob(isolate) != CompilationJob::SUCCEEDED) {
     CompilerTracer::TraceAbortedJob(isolate, compilation_info);
+    job->RecordMetricsEvent(OptimizedCompilationJob::kSynchronous, isolate);
     return false;
   }
 
   // Success!
   job->RecordCompilationStats(OptimizedCompilationJob::kSynchronous, isolate);
+  job->RecordMetricsEvent(OptimizedCompilationJob::kSynchronous, isolate);
+  isolate->deoptimization_statistics()->RecordOptimization(
+      *compilation_info->shared_info());
   DCHECK(!isolate->has_pending_exception());
   InsertCodeIntoOptimizedCodeCache(compilation_info);
   job->RecordFunctionCompilation(CodeEventListener::LAZY_COMPILE_TAG, isolate);
@@ -1811,6 +1844,8 @@ bool Compiler::Compile(Handle<JSFunction> function, ClearExceptionFlag flag,
 
   // Initialize the feedback cell for this JSFunction.
   JSFunction::InitializeFeedbackCell(function, is_compiled_scope);
+  isolate->runtime_profiler()->MarkHotInProfileForOptimization(
+      function, is_compiled_scope);
 
   // Optimize now if --always-opt is enabled.
   if (FLAG_always_opt && !function->shared().HasAsmWasmData()) {
@@ -3007,6 +3042,7 @@ bool Compiler::FinalizeOptimizedCompilationJob(OptimizedCompilationJob* job,
     } else if (job->FinalizeJob(isolate) == CompilationJob::SUCCEEDED) {
       job->RecordCompilationStats(OptimizedCompilationJob::kConcurrent,
                                   isolate);
+      job->RecordMetricsEvent(OptimizedCompilationJob::kConcurrent, isolate);
       job->RecordFunctionCompilation(CodeEventListener::LAZY_COMPILE_TAG,
                                      isolate);
       InsertCodeIntoOptimizedCodeCache(compilation_info);
@@ -3014,6 +3050,7 @@ bool Compiler::FinalizeOptimizedCompilationJob(OptimizedCompilationJob* job,
       CompilerTracer::TraceCompletedJob(isolate, compilation_info);
       if (should_install_code_on_function) {
         compilation_info->closure()->set_code(*compilation_info->code());
+        isolate->deoptimization_statistics()->RecordOptimization(*shared);
       }
       return CompilationJob::SUCCEEDED;
     }
@@ -3021,6 +3058,7 @@ bool Compiler::FinalizeOptimizedCompilationJob(OptimizedCompilationJob* job,
 
   DCHECK_EQ(job->state(), CompilationJob::State::kFailed);
   CompilerTracer::TraceAbortedJob(isolate, compilation_info);
+  job->RecordMetricsEvent(OptimizedCompilationJob::kConcurrent, isolate);
   compilation_info->closure()->set_code(shared->GetCode());
   // Clear the InOptimizationQueue marker, if it exists.
   if (UsesOptimizationMarker(code_kind) &&
@@ -3051,6 +3089,9 @@ void Compiler::PostInstantiation(Handle<JSFunction> function) {
       function->set_code(code);
     }
 
+    isolate->runtime_profiler()->MarkHotInProfileForOptimization(
+        function, &is_compiled_scope);
+
     if (FLAG_always_opt && shared->allows_lazy_compilation() &&
         !shared->optimization_disabled() &&
         !function->HasAvailableOptimizedCode()) {
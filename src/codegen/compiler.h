@@ -349,6 +349,9 @@ class OptimizedCompilationJob : public CompilationJob {
   void RecordCompilationStats(CompilationMode mode, Isolate* isolate) const;
   void RecordFunctionCompilation(CodeEventListener::LogEventsAndTags tag,
                                  Isolate* isolate) const;
+  // Reports the finished job, successful or not, to the embedder's metrics
+  // recorder.
+  void RecordMetricsEvent(CompilationMode mode, Isolate* isolate) const;
 
   OptimizedCompilationInfo* compilation_info() const {
     return compilation_info_;
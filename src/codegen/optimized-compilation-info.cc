@@ -7,6 +7,7 @@
 #include "src/api/api.h"
 #include "src/codegen/source-position.h"
 #include "src/debug/debug.h"
+#include "src/diagnostics/allocation-site-profiler.h"
 #include "src/execution/isolate.h"
 #include "src/objects/objects-inl.h"
 #include "src/objects/shared-function-info.h"
@@ -196,6 +197,16 @@ OptimizedCompilationInfo::ReleaseWasmCompilationResult() {
   return std::move(wasm_compilation_result_);
 }
 
+void OptimizedCompilationInfo::SetAllocationSiteProfilerData(
+    std::unique_ptr<AllocationSiteProfilerData> data) {
+  allocation_site_profiler_data_ = std::move(data);
+}
+
+std::unique_ptr<AllocationSiteProfilerData>
+OptimizedCompilationInfo::ReleaseAllocationSiteProfilerData() {
+  return std::move(allocation_site_profiler_data_);
+}
+
 bool OptimizedCompilationInfo::has_context() const {
   return !closure().is_null();
 }
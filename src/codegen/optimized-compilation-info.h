@@ -28,6 +28,7 @@ class TracedValue;
 
 namespace internal {
 
+class AllocationSiteProfilerData;
 class FunctionLiteral;
 class Isolate;
 class JavaScriptFrame;
@@ -66,7 +67,8 @@ class V8_EXPORT_PRIVATE OptimizedCompilationInfo final {
   V(TraceTurboAllocation, trace_turbo_allocation, 16)                \
   V(TraceHeapBroker, trace_heap_broker, 17)                          \
   V(WasmRuntimeExceptionSupport, wasm_runtime_exception_support, 18) \
-  V(ConcurrentInlining, concurrent_inlining, 19)
+  V(ConcurrentInlining, concurrent_inlining, 19)                     \
+  V(LoopUnrolling, loop_unrolling, 20)
 
   enum Flag {
 #define DEF_ENUM(Camel, Lower, Bit) k##Camel = 1 << Bit,
@@ -234,6 +236,14 @@ class V8_EXPORT_PRIVATE OptimizedCompilationInfo final {
     profiler_data_ = profiler_data;
   }
 
+  AllocationSiteProfilerData* allocation_site_profiler_data() const {
+    return allocation_site_profiler_data_.get();
+  }
+  void SetAllocationSiteProfilerData(
+      std::unique_ptr<AllocationSiteProfilerData> data);
+  std::unique_ptr<AllocationSiteProfilerData>
+  ReleaseAllocationSiteProfilerData();
+
   std::unique_ptr<PersistentHandles> DetachPersistentHandles() {
     DCHECK_NOT_NULL(ph_);
     return std::move(ph_);
@@ -272,6 +282,10 @@ class V8_EXPORT_PRIVATE OptimizedCompilationInfo final {
   // Basic block profiling support.
   BasicBlockProfilerData* profiler_data_ = nullptr;
 
+  // Allocation site profiling support. Owned by the compilation until the
+  // code is finalized, and by the AllocationSiteProfiler after that.
+  std::unique_ptr<AllocationSiteProfilerData> allocation_site_profiler_data_;
+
   // The WebAssembly compilation result, not published in the NativeModule yet.
   std::unique_ptr<wasm::WasmCompilationResult> wasm_compilation_result_;
 
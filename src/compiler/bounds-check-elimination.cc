@@ -0,0 +1,80 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/bounds-check-elimination.h"
+
+#include "src/compiler/all-nodes.h"
+#include "src/compiler/common-operator.h"
+#include "src/compiler/graph.h"
+#include "src/compiler/loop-variable-optimizer.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/node.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+#define TRACE(...)                                  \
+  do {                                              \
+    if (FLAG_trace_turbo_loop) PrintF(__VA_ARGS__); \
+  } while (false)
+
+// static
+bool BoundsCheckElimination::IsAtMost(Node* bound, Node* length, int depth) {
+  if (bound == length) return true;
+  if (bound->opcode() == IrOpcode::kSelect && depth < 2) {
+    return IsAtMost(bound->InputAt(1), length, depth + 1) &&
+           IsAtMost(bound->InputAt(2), length, depth + 1);
+  }
+  if (!NodeProperties::IsTyped(bound) || !NodeProperties::IsTyped(length)) {
+    return false;
+  }
+  Type const bound_type = NodeProperties::GetType(bound);
+  Type const length_type = NodeProperties::GetType(length);
+  if (bound_type.IsNone() || !bound_type.Is(Type::OrderedNumber()) ||
+      length_type.IsNone() || !length_type.Is(Type::OrderedNumber())) {
+    return false;
+  }
+  return bound_type.Max() <= length_type.Min();
+}
+
+size_t BoundsCheckElimination::Run() {
+  LoopVariableOptimizer induction_vars(graph_, common_, zone_);
+  induction_vars.Run();
+
+  size_t eliminated = 0;
+  AllNodes all(zone_, graph_);
+  NodeVector limits(zone_);
+  for (Node* node : all.reachable) {
+    if (node->opcode() != IrOpcode::kCheckBounds) continue;
+    Node* index = NodeProperties::GetValueInput(node, 0);
+    Node* length = NodeProperties::GetValueInput(node, 1);
+    if (!NodeProperties::IsTyped(node) || !NodeProperties::IsTyped(index) ||
+        !NodeProperties::GetType(index).Is(Type::Unsigned32())) {
+      continue;
+    }
+
+    limits.clear();
+    induction_vars.CollectStrictUpperLimits(
+        NodeProperties::GetControlInput(node), index, &limits);
+    for (Node* limit : limits) {
+      if (!IsAtMost(limit, length)) continue;
+      TRACE("Eliminating bounds check #%d of #%d against #%d (limit #%d)\n",
+            node->id(), index->id(), length->id(), limit->id());
+      // Keep the type of the checked index for its uses.
+      Type const type = NodeProperties::GetType(node);
+      node->RemoveInput(1);
+      NodeProperties::ChangeOp(node, common_->TypeGuard(type));
+      eliminated++;
+      break;
+    }
+  }
+  return eliminated;
+}
+
+#undef TRACE
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
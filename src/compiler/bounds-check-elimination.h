@@ -0,0 +1,58 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_BOUNDS_CHECK_ELIMINATION_H_
+#define V8_COMPILER_BOUNDS_CHECK_ELIMINATION_H_
+
+#include "src/base/compiler-specific.h"
+#include "src/common/globals.h"
+
+namespace v8 {
+namespace internal {
+
+class Zone;
+
+namespace compiler {
+
+class CommonOperatorBuilder;
+class Graph;
+class Node;
+
+// Eliminates CheckBounds nodes whose index is an induction variable that is
+// known to be below the length by the loop condition, as in
+//
+//   for (let i = 0; i < a.length; ++i) a[i];
+//
+// The typer cannot prove such checks redundant, since the type of the length
+// does not bound the type of {i}. Instead, the constraints on the induction
+// variables collected by the LoopVariableOptimizer are matched against the
+// length input of the check. The loop condition may also compare against a
+// select between the length and zero, as produced for the length of typed
+// arrays whose buffer might be detached.
+//
+// Eliminated checks are turned into TypeGuards of the type of the check, so
+// the uses keep their precise index type.
+class V8_EXPORT_PRIVATE BoundsCheckElimination final {
+ public:
+  BoundsCheckElimination(Graph* graph, CommonOperatorBuilder* common,
+                         Zone* zone)
+      : graph_(graph), common_(common), zone_(zone) {}
+
+  // Returns the number of eliminated checks.
+  size_t Run();
+
+ private:
+  // Returns whether {bound} is known to be at most {length}.
+  static bool IsAtMost(Node* bound, Node* length, int depth = 0);
+
+  Graph* const graph_;
+  CommonOperatorBuilder* const common_;
+  Zone* const zone_;
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_BOUNDS_CHECK_ELIMINATION_H_
@@ -313,6 +313,13 @@ class BytecodeGraphBuilder {
   void BuildJumpIfNotHole();
   void BuildJumpIfJSReceiver();
 
+  // Computes the branch hints of all conditional jumps from the branch
+  // counters at their target and fall-through (see --branch-feedback).
+  void ComputeBranchHints();
+  // Returns the hint for the condition that the current conditional jump is
+  // taken on.
+  BranchHint GetJumpBranchHint() const;
+
   void BuildUpdateInterruptBudget(int delta);
 
   void BuildSwitchOnSmi(Node* condition);
@@ -449,6 +456,10 @@ class BytecodeGraphBuilder {
   // the "resuming" ones. They are indexed by the suspend id of the resume.
   ZoneMap<int, Environment*> generator_merge_environments_;
 
+  // Branch hints of the conditional jumps, indexed by the bytecode offset of
+  // the jump. Jumps without a hint are not in the map.
+  ZoneMap<int, BranchHint> branch_hints_;
+
   // Exception handlers currently entered by the iteration.
   ZoneStack<ExceptionHandler> exception_handlers_;
   int current_exception_handler_;
@@ -1024,6 +1035,7 @@ BytecodeGraphBuilder::BytecodeGraphBuilder(
                               BytecodeGraphBuilderFlag::kSkipFirstStackCheck),
       merge_environments_(local_zone),
       generator_merge_environments_(local_zone),
+      branch_hints_(local_zone),
       exception_handlers_(local_zone),
       current_exception_handler_(0),
       input_buffer_size_(0),
@@ -1459,6 +1471,8 @@ void BytecodeGraphBuilder::VisitSingleBytecode() {
 }
 
 void BytecodeGraphBuilder::VisitBytecodes() {
+  if (FLAG_branch_feedback) ComputeBranchHints();
+
   if (!bytecode_analysis().resume_jump_targets().empty()) {
     environment()->BindGeneratorState(
         jsgraph()->SmiConstant(JSGeneratorObject::kGeneratorExecuting));
@@ -3574,6 +3588,10 @@ void BytecodeGraphBuilder::VisitIncBlockCounter() {
   NewNode(op, closure, coverage_array_slot);
 }
 
+void BytecodeGraphBuilder::VisitIncBranchCounter() {
+  // The counts are only used as branch hints, see GetJumpBranchHint.
+}
+
 void BytecodeGraphBuilder::VisitForInEnumerate() {
   Node* receiver =
       environment()->LookupRegister(bytecode_iterator().GetRegisterOperand(0));
@@ -3954,8 +3972,85 @@ void BytecodeGraphBuilder::BuildJump() {
   MergeIntoSuccessorEnvironment(bytecode_iterator().GetJumpTargetOffset());
 }
 
+void BytecodeGraphBuilder::ComputeBranchHints() {
+  // A jump is only considered likely or unlikely if it was observed often
+  // enough and one branch was taken much more often than the other.
+  static const int kMinimumCount = 100;
+  static const int kRatio = 100;
+
+  // The counters at a jump target and at the bytecode following the jump
+  // only count the jump itself if no other control flow reaches them, e.g.
+  // the other conditional jumps of a logical expression. So count the
+  // predecessors of every bytecode offset first.
+  struct ConditionalJump {
+    int offset;
+    int target_offset;
+    int fall_through_offset;
+  };
+  ZoneVector<ConditionalJump> conditional_jumps(local_zone());
+  ZoneMap<int, FeedbackSlot> counters(local_zone());
+  ZoneMap<int, int> predecessor_counts(local_zone());
+  bool falls_through = false;
+  interpreter::BytecodeArrayIterator& iterator = bytecode_iterator();
+  DCHECK_EQ(iterator.current_offset(), 0);
+  for (; !iterator.done(); iterator.Advance()) {
+    int offset = iterator.current_offset();
+    interpreter::Bytecode bytecode = iterator.current_bytecode();
+    if (falls_through) predecessor_counts[offset]++;
+    if (bytecode == interpreter::Bytecode::kIncBranchCounter) {
+      counters.emplace(offset, iterator.GetSlotOperand(0));
+    }
+    if (interpreter::Bytecodes::IsJump(bytecode)) {
+      predecessor_counts[iterator.GetJumpTargetOffset()]++;
+      if (interpreter::Bytecodes::IsConditionalJump(bytecode)) {
+        conditional_jumps.push_back(
+            {offset, iterator.GetJumpTargetOffset(),
+             offset + iterator.current_bytecode_size()});
+      }
+    } else if (interpreter::Bytecodes::IsSwitch(bytecode)) {
+      for (const auto& entry : iterator.GetJumpTableTargetOffsets()) {
+        predecessor_counts[entry.target_offset]++;
+      }
+    }
+    falls_through = !interpreter::Bytecodes::IsUnconditionalJump(bytecode) &&
+                    !interpreter::Bytecodes::Returns(bytecode) &&
+                    bytecode != interpreter::Bytecode::kThrow &&
+                    bytecode != interpreter::Bytecode::kReThrow &&
+                    bytecode != interpreter::Bytecode::kAbort;
+  }
+  iterator.SetOffset(0);
+
+  // Returns the count of the counter at {offset} if the jump is its only
+  // predecessor, or -1 otherwise.
+  auto count_at = [&](int offset) {
+    auto counter = counters.find(offset);
+    if (counter == counters.end() || predecessor_counts[offset] != 1) {
+      return -1;
+    }
+    return broker()->GetFeedbackForBranchCounter(
+        CreateFeedbackSource(counter->second));
+  };
+  for (const ConditionalJump& jump : conditional_jumps) {
+    int jump_count = count_at(jump.target_offset);
+    int fall_through_count = count_at(jump.fall_through_offset);
+    if (jump_count < 0 || fall_through_count < 0) continue;
+    if (jump_count >= kMinimumCount &&
+        jump_count / kRatio > fall_through_count) {
+      branch_hints_.emplace(jump.offset, BranchHint::kTrue);
+    } else if (fall_through_count >= kMinimumCount &&
+               fall_through_count / kRatio > jump_count) {
+      branch_hints_.emplace(jump.offset, BranchHint::kFalse);
+    }
+  }
+}
+
+BranchHint BytecodeGraphBuilder::GetJumpBranchHint() const {
+  auto hint = branch_hints_.find(bytecode_iterator_.current_offset());
+  return hint == branch_hints_.end() ? BranchHint::kNone : hint->second;
+}
+
 void BytecodeGraphBuilder::BuildJumpIf(Node* condition) {
-  NewBranch(condition, BranchHint::kNone, IsSafetyCheck::kNoSafetyCheck);
+  NewBranch(condition, GetJumpBranchHint(), IsSafetyCheck::kNoSafetyCheck);
   {
     SubEnvironment sub_environment(this);
     NewIfTrue();
@@ -3967,7 +4062,8 @@ void BytecodeGraphBuilder::BuildJumpIf(Node* condition) {
 }
 
 void BytecodeGraphBuilder::BuildJumpIfNot(Node* condition) {
-  NewBranch(condition, BranchHint::kNone, IsSafetyCheck::kNoSafetyCheck);
+  NewBranch(condition, NegateBranchHint(GetJumpBranchHint()),
+            IsSafetyCheck::kNoSafetyCheck);
   {
     SubEnvironment sub_environment(this);
     NewIfFalse();
@@ -3993,7 +4089,8 @@ void BytecodeGraphBuilder::BuildJumpIfNotEqual(Node* comperand) {
 }
 
 void BytecodeGraphBuilder::BuildJumpIfFalse() {
-  NewBranch(environment()->LookupAccumulator(), BranchHint::kNone,
+  NewBranch(environment()->LookupAccumulator(),
+            NegateBranchHint(GetJumpBranchHint()),
             IsSafetyCheck::kNoSafetyCheck);
   {
     SubEnvironment sub_environment(this);
@@ -4008,7 +4105,7 @@ void BytecodeGraphBuilder::BuildJumpIfFalse() {
 }
 
 void BytecodeGraphBuilder::BuildJumpIfTrue() {
-  NewBranch(environment()->LookupAccumulator(), BranchHint::kNone,
+  NewBranch(environment()->LookupAccumulator(), GetJumpBranchHint(),
             IsSafetyCheck::kNoSafetyCheck);
   {
     SubEnvironment sub_environment(this);
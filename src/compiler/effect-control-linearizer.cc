@@ -192,10 +192,12 @@ class EffectControlLinearizer {
   Node* LowerLoadMessage(Node* node);
   Node* LowerFastApiCall(Node* node);
   Node* LowerLoadTypedElement(Node* node);
+  Node* LowerLoadTypedElementSimd128(Node* node);
   Node* LowerLoadDataViewElement(Node* node);
   Node* LowerLoadStackArgument(Node* node);
   void LowerStoreMessage(Node* node);
   void LowerStoreTypedElement(Node* node);
+  void LowerStoreTypedElementSimd128(Node* node);
   void LowerStoreDataViewElement(Node* node);
   void LowerStoreSignedSmallElement(Node* node);
   Node* LowerFindOrderedHashMapEntry(Node* node);
@@ -242,6 +244,8 @@ class EffectControlLinearizer {
   Node* IsElementsKindGreaterThan(Node* kind, ElementsKind reference_kind);
 
   Node* BuildTypedArrayDataPointer(Node* base, Node* external);
+  Node* BuildTypedArrayElementOffset(ExternalArrayType array_type,
+                                     Node* index);
 
   template <typename... Args>
   Node* CallBuiltin(Builtins::Name builtin, Operator::Properties properties,
@@ -1290,6 +1294,9 @@ bool EffectControlLinearizer::TryWireInStateEffect(Node* node,
     case IrOpcode::kLoadTypedElement:
       result = LowerLoadTypedElement(node);
       break;
+    case IrOpcode::kLoadTypedElementSimd128:
+      result = LowerLoadTypedElementSimd128(node);
+      break;
     case IrOpcode::kLoadDataViewElement:
       result = LowerLoadDataViewElement(node);
       break;
@@ -1299,6 +1306,9 @@ bool EffectControlLinearizer::TryWireInStateEffect(Node* node,
     case IrOpcode::kStoreTypedElement:
       LowerStoreTypedElement(node);
       break;
+    case IrOpcode::kStoreTypedElementSimd128:
+      LowerStoreTypedElementSimd128(node);
+      break;
     case IrOpcode::kStoreDataViewElement:
       LowerStoreDataViewElement(node);
       break;
@@ -5534,6 +5544,15 @@ Node* EffectControlLinearizer::BuildTypedArrayDataPointer(Node* base,
   }
 }
 
+// Compute the byte offset of the element at {index} from the data pointer.
+Node* EffectControlLinearizer::BuildTypedArrayElementOffset(
+    ExternalArrayType array_type, Node* index) {
+  MachineRepresentation const rep =
+      AccessBuilder::ForTypedArrayElement(array_type, true)
+          .machine_type.representation();
+  return __ WordShl(index, __ IntPtrConstant(ElementSizeLog2Of(rep)));
+}
+
 Node* EffectControlLinearizer::LowerLoadTypedElement(Node* node) {
   ExternalArrayType array_type = ExternalArrayTypeOf(node->op());
   Node* buffer = node->InputAt(0);
@@ -5553,6 +5572,24 @@ Node* EffectControlLinearizer::LowerLoadTypedElement(Node* node) {
                         data_ptr, index);
 }
 
+Node* EffectControlLinearizer::LowerLoadTypedElementSimd128(Node* node) {
+  ExternalArrayType array_type = ExternalArrayTypeOf(node->op());
+  Node* buffer = node->InputAt(0);
+  Node* base = node->InputAt(1);
+  Node* external = node->InputAt(2);
+  Node* index = node->InputAt(3);
+
+  // We need to keep the {buffer} alive so that the GC will not release the
+  // ArrayBuffer (if there's any) as long as we are still operating on it.
+  __ Retain(buffer);
+
+  Node* data_ptr = BuildTypedArrayDataPointer(base, external);
+
+  // The vector need not be aligned to its size.
+  return __ Load(MachineType::Simd128(), data_ptr,
+                 BuildTypedArrayElementOffset(array_type, index));
+}
+
 Node* EffectControlLinearizer::LowerLoadStackArgument(Node* node) {
   Node* base = node->InputAt(0);
   Node* index = node->InputAt(1);
@@ -5582,6 +5619,26 @@ void EffectControlLinearizer::LowerStoreTypedElement(Node* node) {
                   data_ptr, index, value);
 }
 
+void EffectControlLinearizer::LowerStoreTypedElementSimd128(Node* node) {
+  ExternalArrayType array_type = ExternalArrayTypeOf(node->op());
+  Node* buffer = node->InputAt(0);
+  Node* base = node->InputAt(1);
+  Node* external = node->InputAt(2);
+  Node* index = node->InputAt(3);
+  Node* value = node->InputAt(4);
+
+  // We need to keep the {buffer} alive so that the GC will not release the
+  // ArrayBuffer (if there's any) as long as we are still operating on it.
+  __ Retain(buffer);
+
+  Node* data_ptr = BuildTypedArrayDataPointer(base, external);
+
+  // The vector need not be aligned to its size.
+  __ Store(StoreRepresentation(MachineRepresentation::kSimd128,
+                               kNoWriteBarrier),
+           data_ptr, BuildTypedArrayElementOffset(array_type, index), value);
+}
+
 void EffectControlLinearizer::TransitionElementsTo(Node* node, Node* array,
                                                    ElementsKind from,
                                                    ElementsKind to) {
@@ -4,6 +4,9 @@
 
 #include "src/compiler/escape-analysis.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "src/codegen/tick-counter.h"
 #include "src/compiler/linkage.h"
 #include "src/compiler/node-matchers.h"
@@ -502,6 +505,10 @@ VariableTracker::State VariableTracker::MergeInputs(Node* effect_phi) {
 
 namespace {
 
+// The maximal number of elements that a LoadElement with a variable index
+// from a virtual object selects from.
+constexpr int kMaxElementsForVariableIndexLoad = 4;
+
 int OffsetOfFieldAccess(const Operator* op) {
   DCHECK(op->opcode() == IrOpcode::kLoadField ||
          op->opcode() == IrOpcode::kStoreField);
@@ -639,50 +646,66 @@ void ReduceNode(const Operator* op, EscapeAnalysisTracker::Scope* current,
         int const length =
             (vobject->size() - access.header_size) >>
             ElementSizeLog2Of(access.machine_type.representation());
-        Variable var0, var1;
-        Node* value0;
-        Node* value1;
-        if (length == 1 &&
-            vobject->FieldAt(OffsetOfElementAt(access, 0)).To(&var) &&
-            current->Get(var).To(&value) &&
-            (value == nullptr ||
-             NodeProperties::GetType(value).Is(access.type))) {
-          // The {object} has no elements, and we know that the LoadElement
-          // {index} must be within bounds, thus it must always yield this
-          // one element of {object}.
-          current->SetReplacement(value);
-          break;
-        } else if (length == 2 &&
-                   vobject->FieldAt(OffsetOfElementAt(access, 0)).To(&var0) &&
-                   current->Get(var0).To(&value0) &&
-                   (value0 == nullptr ||
-                    NodeProperties::GetType(value0).Is(access.type)) &&
-                   vobject->FieldAt(OffsetOfElementAt(access, 1)).To(&var1) &&
-                   current->Get(var1).To(&value1) &&
-                   (value1 == nullptr ||
-                    NodeProperties::GetType(value1).Is(access.type))) {
-          if (value0 && value1) {
-            // The {object} has exactly two elements, so the LoadElement
-            // must return one of them (i.e. either the element at index
-            // 0 or the one at index 1). So we can turn the LoadElement
-            // into a Select operation instead (still allowing the {object}
-            // to be scalar replaced). We must however mark the elements
-            // of the {object} itself as escaping.
-            Node* check =
-                jsgraph->graph()->NewNode(jsgraph->simplified()->NumberEqual(),
-                                          index, jsgraph->ZeroConstant());
-            NodeProperties::SetType(check, Type::Boolean());
-            Node* select = jsgraph->graph()->NewNode(
-                jsgraph->common()->Select(access.machine_type.representation()),
-                check, value0, value1);
-            NodeProperties::SetType(select, access.type);
+        // We know that the LoadElement {index} must be within bounds, so it
+        // can only yield one of the elements of {object} in the range of the
+        // {index} type. If there are few of them, we turn the LoadElement
+        // into a chain of Select operations instead (still allowing the
+        // {object} to be scalar replaced). We must however mark the selected
+        // elements of the {object} itself as escaping.
+        int first = 0;
+        int last = length - 1;
+        Type const index_type = NodeProperties::GetType(index);
+        if (index_type.Is(Type::OrderedNumber()) && !index_type.IsNone()) {
+          double const min = std::min(std::max(index_type.Min(), 0.0),
+                                      static_cast<double>(length));
+          double const max = std::max(std::min(index_type.Max(),
+                                               static_cast<double>(last)),
+                                      -1.0);
+          first = static_cast<int>(std::ceil(min));
+          last = static_cast<int>(std::floor(max));
+        }
+        if (first <= last && last - first < kMaxElementsForVariableIndexLoad) {
+          Node* values[kMaxElementsForVariableIndexLoad];
+          bool has_values = true;
+          bool can_select = true;
+          for (int i = first; i <= last; ++i) {
+            Node* element;
+            if (!vobject->FieldAt(OffsetOfElementAt(access, i)).To(&var) ||
+                !current->Get(var).To(&element) ||
+                (element != nullptr &&
+                 !NodeProperties::GetType(element).Is(access.type))) {
+              can_select = false;
+              break;
+            }
+            if (element == nullptr) has_values = false;
+            values[i - first] = element;
+          }
+          if (can_select) {
+            // If the variables have no values, we have not reached the
+            // fixed-point yet.
+            if (!has_values) break;
+            Node* select = values[last - first];
+            for (int i = last - 1; i >= first; --i) {
+              Node* constant = jsgraph->Constant(i);
+              if (!NodeProperties::IsTyped(constant)) {
+                NodeProperties::SetType(
+                    constant, Type::Constant(i, jsgraph->graph()->zone()));
+              }
+              Node* check = jsgraph->graph()->NewNode(
+                  jsgraph->simplified()->NumberEqual(), index, constant);
+              NodeProperties::SetType(check, Type::Boolean());
+              select = jsgraph->graph()->NewNode(
+                  jsgraph->common()->Select(
+                      access.machine_type.representation()),
+                  check, values[i - first], select);
+              NodeProperties::SetType(select, access.type);
+            }
             current->SetReplacement(select);
-            current->SetEscaped(value0);
-            current->SetEscaped(value1);
-            break;
-          } else {
-            // If the variables have no values, we have
-            // not reached the fixed-point yet.
+            if (first != last) {
+              for (int i = first; i <= last; ++i) {
+                current->SetEscaped(values[i - first]);
+              }
+            }
             break;
           }
         }
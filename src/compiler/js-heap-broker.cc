@@ -1729,7 +1729,9 @@ ScopeInfoData::ScopeInfoData(JSHeapBroker* broker, ObjectData** storage,
       context_length_(object->ContextLength()),
       has_outer_scope_info_(object->HasOuterScopeInfo()),
       flags_(object->Flags()),
-      outer_scope_info_(nullptr) {}
+      outer_scope_info_(nullptr) {
+  DCHECK(!FLAG_turbo_direct_heap_access);
+}
 
 void ScopeInfoData::SerializeScopeInfoChain(JSHeapBroker* broker) {
   if (outer_scope_info_) return;
@@ -4878,6 +4880,15 @@ ProcessedFeedback const& JSHeapBroker::ReadFeedbackForForIn(
   return *zone()->New<ForInFeedback>(hint, nexus.kind());
 }
 
+ProcessedFeedback const& JSHeapBroker::ReadFeedbackForBranchCounter(
+    FeedbackSource const& source) const {
+  FeedbackNexus nexus(source.vector, source.slot);
+  if (!CanUseFeedback(nexus)) return NewInsufficientFeedback(nexus.kind());
+  int count = nexus.GetBranchCount();
+  DCHECK_NE(count, 0);  // Not uninitialized.
+  return *zone()->New<BranchCounterFeedback>(count, nexus.kind());
+}
+
 ProcessedFeedback const& JSHeapBroker::ReadFeedbackForInstanceOf(
     FeedbackSource const& source) {
   FeedbackNexus nexus(source.vector, source.slot);
@@ -4985,6 +4996,16 @@ ForInHint JSHeapBroker::GetFeedbackForForIn(FeedbackSource const& source) {
                                    : feedback.AsForIn().value();
 }
 
+int JSHeapBroker::GetFeedbackForBranchCounter(FeedbackSource const& source) {
+  // The serializer only visits the counters of live branches, so the feedback
+  // may be missing in concurrent inlining mode.
+  if (is_concurrent_inlining_ && !HasFeedback(source)) return 0;
+  ProcessedFeedback const& feedback =
+      is_concurrent_inlining_ ? GetFeedback(source)
+                              : ProcessFeedbackForBranchCounter(source);
+  return feedback.IsInsufficient() ? 0 : feedback.AsBranchCounter().value();
+}
+
 ProcessedFeedback const& JSHeapBroker::GetFeedbackForPropertyAccess(
     FeedbackSource const& source, AccessMode mode,
     base::Optional<NameRef> static_name) {
@@ -5079,6 +5100,14 @@ ProcessedFeedback const& JSHeapBroker::ProcessFeedbackForForIn(
   return feedback;
 }
 
+ProcessedFeedback const& JSHeapBroker::ProcessFeedbackForBranchCounter(
+    FeedbackSource const& source) {
+  if (HasFeedback(source)) return GetFeedback(source);
+  ProcessedFeedback const& feedback = ReadFeedbackForBranchCounter(source);
+  SetFeedback(source, &feedback);
+  return feedback;
+}
+
 ProcessedFeedback const& JSHeapBroker::ProcessFeedbackForPropertyAccess(
     FeedbackSource const& source, AccessMode mode,
     base::Optional<NameRef> static_name) {
@@ -5264,6 +5293,11 @@ BinaryOperationFeedback const& ProcessedFeedback::AsBinaryOperation() const {
   return *static_cast<BinaryOperationFeedback const*>(this);
 }
 
+BranchCounterFeedback const& ProcessedFeedback::AsBranchCounter() const {
+  CHECK_EQ(kBranchCounter, kind());
+  return *static_cast<BranchCounterFeedback const*>(this);
+}
+
 CallFeedback const& ProcessedFeedback::AsCall() const {
   CHECK_EQ(kCall, kind());
   return *static_cast<CallFeedback const*>(this);
@@ -164,6 +164,9 @@ class V8_EXPORT_PRIVATE JSHeapBroker {
       FeedbackSource const& source);
   ForInHint GetFeedbackForForIn(FeedbackSource const& source);
 
+  // Returns how often the branch was entered, zero if unknown.
+  int GetFeedbackForBranchCounter(FeedbackSource const& source);
+
   ProcessedFeedback const& GetFeedbackForCall(FeedbackSource const& source);
   ProcessedFeedback const& GetFeedbackForGlobalAccess(
       FeedbackSource const& source);
@@ -181,6 +184,8 @@ class V8_EXPORT_PRIVATE JSHeapBroker {
 
   ProcessedFeedback const& ProcessFeedbackForBinaryOperation(
       FeedbackSource const& source);
+  ProcessedFeedback const& ProcessFeedbackForBranchCounter(
+      FeedbackSource const& source);
   ProcessedFeedback const& ProcessFeedbackForCall(FeedbackSource const& source);
   ProcessedFeedback const& ProcessFeedbackForCompareOperation(
       FeedbackSource const& source);
@@ -300,6 +305,8 @@ class V8_EXPORT_PRIVATE JSHeapBroker {
       FeedbackSource const& source);
   ProcessedFeedback const& ReadFeedbackForBinaryOperation(
       FeedbackSource const& source) const;
+  ProcessedFeedback const& ReadFeedbackForBranchCounter(
+      FeedbackSource const& source) const;
   ProcessedFeedback const& ReadFeedbackForCall(FeedbackSource const& source);
   ProcessedFeedback const& ReadFeedbackForCompareOperation(
       FeedbackSource const& source) const;
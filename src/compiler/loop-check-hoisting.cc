@@ -0,0 +1,244 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-check-hoisting.h"
+
+#include "src/compiler/access-builder.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/node.h"
+#include "src/compiler/simplified-operator.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+namespace {
+
+// Element stores are the only writes allowed in a loop with hoisted checks:
+// they neither change maps nor the lengths of arrays and backing stores.
+bool IsAllowedInLoop(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kCheckpoint:
+    case IrOpcode::kEffectPhi:
+    case IrOpcode::kStoreElement:
+    case IrOpcode::kStoreTypedElement:
+    case IrOpcode::kTerminate:
+      return true;
+    default:
+      return node->op()->HasProperty(Operator::kNoWrite);
+  }
+}
+
+// Loads of the fields that describe the extent and the location of the
+// elements of arrays and typed arrays.
+bool IsHoistableField(FieldAccess const& access) {
+  if (access.base_is_tagged != kTaggedBase) return false;
+  for (FieldAccess const& field :
+       {AccessBuilder::ForJSObjectElements(),
+        AccessBuilder::ForJSArrayLength(PACKED_ELEMENTS),
+        AccessBuilder::ForFixedArrayLength(),
+        AccessBuilder::ForJSTypedArrayLength(),
+        AccessBuilder::ForJSTypedArrayBasePointer(),
+        AccessBuilder::ForJSTypedArrayExternalPointer()}) {
+    if (access.offset == field.offset) return true;
+  }
+  return false;
+}
+
+// Checks in front of the loop deoptimize to the frame state of the last
+// checkpoint, so there must not be any visible effect in between.
+bool HasCheckpointBefore(Node* effect) {
+  while (effect->opcode() != IrOpcode::kCheckpoint) {
+    if (!effect->op()->HasProperty(Operator::kNoWrite) ||
+        effect->op()->EffectInputCount() != 1) {
+      return false;
+    }
+    effect = NodeProperties::GetEffectInput(effect);
+  }
+  return true;
+}
+
+Node* FindEffectPhi(Node* loop_node) {
+  for (Node* use : loop_node->uses()) {
+    if (use->opcode() == IrOpcode::kEffectPhi) return use;
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+bool LoopCheckHoisting::HasWritesInLoop(LoopTree::Loop* loop) {
+  for (Node* node : loop_tree_->LoopNodes(loop)) {
+    if (node->op()->EffectOutputCount() > 0 && !IsAllowedInLoop(node)) {
+      if (FLAG_trace_turbo_loop) {
+        PrintF("Cannot hoist checks of loop %i. #%d:%s writes.\n",
+               loop_tree_->GetLoopControl(loop)->id(), node->id(),
+               node->op()->mnemonic());
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+void LoopCheckHoisting::ComputeAlwaysExecutedControl(LoopTree::Loop* loop,
+                                                     Node* loop_node,
+                                                     NodeSet* always,
+                                                     NodeSet* before_exit) {
+  Node* control = loop_node;
+  bool passed_exit = false;
+  while (control != nullptr) {
+    always->insert(control);
+    if (!passed_exit) before_exit->insert(control);
+    Node* next = nullptr;
+    for (Node* use : control->uses()) {
+      if (use->op()->ControlOutputCount() == 0 ||
+          use->opcode() == IrOpcode::kTerminate ||
+          !loop_tree_->Contains(loop, use)) {
+        continue;
+      }
+      if (next != nullptr) return;
+      next = use;
+    }
+    if (next == nullptr) return;
+
+    switch (next->opcode()) {
+      case IrOpcode::kBranch: {
+        // Follow the branch if its other projection leaves the loop.
+        Node* projections[2];
+        NodeProperties::CollectControlProjections(next, projections, 2);
+        bool const stays0 = loop_tree_->Contains(loop, projections[0]);
+        bool const stays1 = loop_tree_->Contains(loop, projections[1]);
+        if (stays0 == stays1) return;
+        control = stays0 ? projections[0] : projections[1];
+        passed_exit = true;
+        break;
+      }
+      case IrOpcode::kLoop:
+      case IrOpcode::kMerge:
+      case IrOpcode::kSwitch:
+        return;
+      default:
+        control = next;
+        break;
+    }
+  }
+}
+
+bool LoopCheckHoisting::IsInvariant(LoopTree::Loop* loop, Node* node,
+                                    const NodeSet& hoisted) {
+  return hoisted.count(node) != 0 || !loop_tree_->Contains(loop, node);
+}
+
+bool LoopCheckHoisting::CanHoist(LoopTree::Loop* loop, Node* node,
+                                 const NodeSet& hoisted,
+                                 const NodeSet& checked, bool before_exit) {
+  switch (node->opcode()) {
+    // Checks behind the exit branch are not executed if the loop is left
+    // right away. Hoisting them would deoptimize calls that do not enter the
+    // loop, and the reoptimized code would do the same again.
+    case IrOpcode::kCheckMaps:
+      return before_exit && IsInvariant(loop, node->InputAt(0), hoisted);
+    case IrOpcode::kCheckBounds:
+      return before_exit && IsInvariant(loop, node->InputAt(0), hoisted) &&
+             IsInvariant(loop, node->InputAt(1), hoisted);
+    case IrOpcode::kLoadField:
+      // Only load from objects whose maps are checked before the loop, as
+      // the load might be executed when it would not have been before.
+      return IsHoistableField(FieldAccessOf(node->op())) &&
+             checked.count(node->InputAt(0)) != 0;
+    default:
+      return false;
+  }
+}
+
+size_t LoopCheckHoisting::HoistChecks(LoopTree::Loop* loop) {
+  Node* loop_node = loop_tree_->GetLoopControl(loop);
+  Node* effect_phi = FindEffectPhi(loop_node);
+  if (effect_phi == nullptr) return 0;
+  if (HasWritesInLoop(loop)) return 0;
+  if (!HasCheckpointBefore(effect_phi->InputAt(kAssumedLoopEntryIndex))) {
+    return 0;
+  }
+
+  NodeSet always(tmp_zone_);
+  NodeSet before_exit(tmp_zone_);
+  ComputeAlwaysExecutedControl(loop, loop_node, &always, &before_exit);
+
+  // Walk the effect chain from the loop header as long as it is executed on
+  // every iteration, and collect the hoistable nodes in order.
+  NodeSet hoisted(tmp_zone_);
+  NodeSet checked(tmp_zone_);
+  NodeVector candidates(tmp_zone_);
+  Node* effect = effect_phi;
+  while (true) {
+    Node* next = nullptr;
+    for (Edge edge : effect->use_edges()) {
+      Node* use = edge.from();
+      if (!NodeProperties::IsEffectEdge(edge) ||
+          use->opcode() == IrOpcode::kTerminate ||
+          !loop_tree_->Contains(loop, use)) {
+        continue;
+      }
+      if (next != nullptr) {
+        next = nullptr;
+        break;
+      }
+      next = use;
+    }
+    if (next == nullptr || next->opcode() == IrOpcode::kEffectPhi) break;
+    if (next->op()->ControlInputCount() != 1) break;
+    Node* control = NodeProperties::GetControlInput(next);
+    if (always.count(control) == 0) break;
+    if (CanHoist(loop, next, hoisted, checked,
+                 before_exit.count(control) != 0)) {
+      candidates.push_back(next);
+      hoisted.insert(next);
+      if (next->opcode() == IrOpcode::kCheckMaps) {
+        checked.insert(next->InputAt(0));
+      } else if (next->opcode() == IrOpcode::kLoadField &&
+                 FieldAccessOf(next->op()).offset ==
+                     AccessBuilder::ForJSObjectElements().offset) {
+        checked.insert(next);
+      }
+    }
+    effect = next;
+  }
+
+  // Move the nodes in front of the loop, preserving their order.
+  Node* entry_control = loop_node->InputAt(kAssumedLoopEntryIndex);
+  for (Node* node : candidates) {
+    if (FLAG_trace_turbo_loop) {
+      PrintF("Hoisting #%d:%s out of loop %i\n", node->id(),
+             node->op()->mnemonic(), loop_node->id());
+    }
+    Node* effect_input = NodeProperties::GetEffectInput(node);
+    for (Edge edge : node->use_edges()) {
+      if (NodeProperties::IsEffectEdge(edge)) edge.UpdateTo(effect_input);
+    }
+    NodeProperties::ReplaceEffectInput(
+        node, effect_phi->InputAt(kAssumedLoopEntryIndex));
+    NodeProperties::ReplaceControlInput(node, entry_control);
+    effect_phi->ReplaceInput(kAssumedLoopEntryIndex, node);
+  }
+  return candidates.size();
+}
+
+size_t LoopCheckHoisting::HoistChecksOfLoops(
+    const ZoneVector<LoopTree::Loop*>& loops) {
+  size_t count = 0;
+  for (LoopTree::Loop* loop : loops) {
+    count += HoistChecksOfLoops(loop->children());
+    count += HoistChecks(loop);
+  }
+  return count;
+}
+
+size_t LoopCheckHoisting::HoistChecksOfTree() {
+  return HoistChecksOfLoops(loop_tree_->outer_loops());
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
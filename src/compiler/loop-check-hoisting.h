@@ -0,0 +1,64 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_LOOP_CHECK_HOISTING_H_
+#define V8_COMPILER_LOOP_CHECK_HOISTING_H_
+
+#include "src/base/compiler-specific.h"
+#include "src/common/globals.h"
+#include "src/compiler/loop-analysis.h"
+#include "src/zone/zone-containers.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Moves loop-invariant map checks, bounds checks and loads of elements and
+// lengths out of loops, in front of the loop header. Such nodes are effectful,
+// so neither load elimination nor the scheduler moves them across the loop
+// header on their own.
+//
+// A node is only hoisted if
+//  - nothing in the loop writes to the heap, except for element stores,
+//    which neither change maps nor the lengths of arrays and backing stores,
+//  - it is executed on every iteration of the loop, that is its effect and
+//    control chains lead straight from the loop header to it, possibly past
+//    the branch that exits the loop for loads,
+//  - it is executed before the branch that exits the loop for checks, so that
+//    calls that do not enter the loop do not deoptimize on a hoisted check,
+//  - its inputs are defined outside the loop (or have been hoisted), and
+//  - a checkpoint is available in front of the loop, so that a failing
+//    check deoptimizes to the state before the loop.
+class V8_EXPORT_PRIVATE LoopCheckHoisting {
+ public:
+  LoopCheckHoisting(LoopTree* loop_tree, Zone* tmp_zone)
+      : loop_tree_(loop_tree), tmp_zone_(tmp_zone) {}
+
+  // Hoists the invariant checks of {loop} and returns the number of hoisted
+  // nodes.
+  size_t HoistChecks(LoopTree::Loop* loop);
+  // Hoists the invariant checks of all loops in the tree, returns the total
+  // number of hoisted nodes.
+  size_t HoistChecksOfTree();
+
+ private:
+  using NodeSet = ZoneUnorderedSet<Node*>;
+
+  bool HasWritesInLoop(LoopTree::Loop* loop);
+  void ComputeAlwaysExecutedControl(LoopTree::Loop* loop, Node* loop_node,
+                                    NodeSet* always, NodeSet* before_exit);
+  bool IsInvariant(LoopTree::Loop* loop, Node* node, const NodeSet& hoisted);
+  bool CanHoist(LoopTree::Loop* loop, Node* node, const NodeSet& hoisted,
+                const NodeSet& checked, bool before_exit);
+  size_t HoistChecksOfLoops(const ZoneVector<LoopTree::Loop*>& loops);
+
+  LoopTree* const loop_tree_;
+  Zone* const tmp_zone_;
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_LOOP_CHECK_HOISTING_H_
@@ -0,0 +1,307 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-unrolling.h"
+
+#include <algorithm>
+
+#include "src/compiler/common-operator.h"
+#include "src/compiler/compiler-source-position-table.h"
+#include "src/compiler/graph.h"
+#include "src/compiler/loop-peeling.h"
+#include "src/compiler/node-origin-table.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/node.h"
+#include "src/zone/zone-containers.h"
+
+// Loop unrolling chains copies of the loop body. Beginning with a loop as
+// follows, with a single backedge:
+//
+//           E
+//           |            A
+//           |            |
+//        ( Loop )<---- ( phiA )<-----------+
+//           |            |                 |
+//      ((===P============U====))           |
+//      ((       body          ))           |
+//      ((===K=====L===========))           |
+//           |     |                        |
+//           |     +---- (backedge) --------+
+//           |
+//          exit
+//
+// each copy of the body uses the backedge values of the previous copy in
+// place of the loop header, and the last copy feeds the backedge of the loop:
+//
+//           E
+//           |            A
+//           |            |
+//        ( Loop )<---- ( phiA )<-----------------------+
+//           |            |                             |
+//      ((===P============U====))                       |
+//      ((       body          ))                       |
+//      ((===K=====L===========))                       |
+//           |     |                                    |
+//           |   ((L'==========))                       |
+//           |   ((    body'   ))                       |
+//           |   ((===K'===L'==))                       |
+//           |        |    |                            |
+//           |        |    +-------- (backedge) --------+
+//           |        |
+//          Merge <---+
+//           |
+//          exit
+//
+// The exits K' of the copies are marked as exits of the original loop, and
+// merged (with phis for exit values) with the original exits.
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+const size_t LoopUnroller::kMaxUnrolledNodes;
+const size_t LoopUnroller::kMaxUnrollingCount;
+
+class UnrolledIterationsImpl : public UnrolledIterations {
+ public:
+  UnrolledIterationsImpl(LoopTree* loop_tree, LoopTree::Loop* loop,
+                         size_t copies, Zone* zone)
+      : copies_(copies),
+        indices_(zone),
+        nodes_(loop->TotalSize() * copies, nullptr, zone) {
+    size_t index = 0;
+    for (Node* node : loop_tree->LoopNodes(loop)) {
+      indices_.emplace(node, index++);
+    }
+  }
+
+  // Returns the copy of {node} in {iteration}, or {node} itself if there is
+  // no such copy (yet).
+  Node* Get(Node* node, size_t iteration) {
+    if (iteration == 0) return node;
+    auto it = indices_.find(node);
+    if (it == indices_.end()) return node;
+    Node* copy = nodes_[it->second * copies_ + iteration - 1];
+    return copy == nullptr ? node : copy;
+  }
+
+  void Set(Node* node, size_t iteration, Node* copy) {
+    DCHECK_LT(0u, iteration);
+    DCHECK_LE(iteration, copies_);
+    nodes_[indices_.at(node) * copies_ + iteration - 1] = copy;
+  }
+
+ private:
+  const size_t copies_;
+  ZoneUnorderedMap<Node*, size_t> indices_;
+  NodeVector nodes_;
+};
+
+Node* UnrolledIterations::map(Node* node, size_t iteration) {
+  return static_cast<UnrolledIterationsImpl*>(this)->Get(node, iteration);
+}
+
+namespace {
+
+bool IsIterationBodyStackCheck(Node* node) {
+  return node->opcode() == IrOpcode::kJSStackCheck &&
+         OpParameter<StackCheckKind>(node->op()) ==
+             StackCheckKind::kJSIterationBody;
+}
+
+// Interrupts only need to be checked once per trip around the loop, so the
+// stack checks of the copies are removed unless they are covered by an
+// exception handler.
+void RemoveStackCheck(Node* node) {
+  DCHECK(IsIterationBodyStackCheck(node));
+  for (Node* use : node->uses()) {
+    if (use->opcode() == IrOpcode::kIfSuccess ||
+        use->opcode() == IrOpcode::kIfException) {
+      return;
+    }
+  }
+  NodeProperties::ReplaceUses(node, nullptr,
+                              NodeProperties::GetEffectInput(node),
+                              NodeProperties::GetControlInput(node));
+  node->Kill();
+}
+
+}  // namespace
+
+bool LoopUnroller::CanUnroll(LoopTree::Loop* loop) {
+  if (!loop->children().empty()) return false;
+  // The copies are chained through the single backedge.
+  Node* loop_node = loop_tree_->GetLoopControl(loop);
+  if (loop_node->InputCount() != 2) {
+    if (FLAG_trace_turbo_loop) {
+      PrintF("Cannot unroll loop %i. Loop has %i backedges.\n", loop_node->id(),
+             loop_node->InputCount() - 1);
+    }
+    return false;
+  }
+  // All exits need to be marked to merge them with the exits of the copies,
+  // which is the same requirement as for peeling.
+  return LoopPeeler(graph_, common_, loop_tree_, tmp_zone_, source_positions_,
+                    node_origins_)
+      .CanPeel(loop);
+}
+
+UnrolledIterations* LoopUnroller::Unroll(LoopTree::Loop* loop, size_t count) {
+  DCHECK_LE(2u, count);
+  if (!CanUnroll(loop)) return nullptr;
+
+  Node* loop_node = loop_tree_->GetLoopControl(loop);
+  UnrolledIterationsImpl* iterations =
+      tmp_zone_->New<UnrolledIterationsImpl>(loop_tree_, loop, count - 1,
+                                              tmp_zone_);
+
+  //============================================================================
+  // Construct the copies of the body, including the exit markers.
+  //============================================================================
+  NodeVector inputs(tmp_zone_);
+  for (size_t i = 1; i < count; i++) {
+    // The header of this iteration is the backedge of the previous one.
+    for (Node* node : loop_tree_->HeaderNodes(loop)) {
+      iterations->Set(node, i, iterations->map(node->InputAt(1), i - 1));
+    }
+
+    // Copy all the nodes first.
+    for (NodeRange nodes :
+         {loop_tree_->BodyNodes(loop), loop_tree_->ExitNodes(loop)}) {
+      for (Node* node : nodes) {
+        SourcePositionTable::Scope position(
+            source_positions_, source_positions_->GetSourcePosition(node));
+        NodeOriginTable::Scope origin_scope(node_origins_, "unroll loop",
+                                            node);
+        inputs.clear();
+        for (Node* input : node->inputs()) {
+          inputs.push_back(iterations->map(input, i));
+        }
+        Node* copy =
+            graph_->NewNode(node->op(), node->InputCount(), &inputs[0]);
+        if (NodeProperties::IsTyped(node)) {
+          NodeProperties::SetType(copy, NodeProperties::GetType(node));
+        }
+        iterations->Set(node, i, copy);
+      }
+    }
+
+    // Fix remaining inputs of the copies. The exits of the copy leave the
+    // original loop.
+    for (NodeRange nodes :
+         {loop_tree_->BodyNodes(loop), loop_tree_->ExitNodes(loop)}) {
+      for (Node* original : nodes) {
+        Node* copy = iterations->map(original, i);
+        for (int j = 0; j < copy->InputCount(); j++) {
+          copy->ReplaceInput(j, iterations->map(original->InputAt(j), i));
+        }
+        if (original->opcode() == IrOpcode::kLoopExit) {
+          copy->ReplaceInput(1, loop_node);
+        }
+      }
+    }
+  }
+
+  //============================================================================
+  // Merge the exits of all iterations.
+  //============================================================================
+  int const iteration_count = static_cast<int>(count);
+  NodeVector markers(tmp_zone_);
+  for (Node* exit : loop_tree_->ExitNodes(loop)) {
+    if (exit->opcode() != IrOpcode::kLoopExit) continue;
+
+    markers.clear();
+    for (Node* use : exit->uses()) {
+      if (use->opcode() == IrOpcode::kLoopExitValue ||
+          use->opcode() == IrOpcode::kLoopExitEffect) {
+        markers.push_back(use);
+      }
+    }
+
+    inputs.clear();
+    for (size_t i = 0; i < count; i++) {
+      inputs.push_back(iterations->map(exit, i));
+    }
+    Node* merge = graph_->NewNode(common_->Merge(iteration_count),
+                                  iteration_count, &inputs[0]);
+    for (Edge edge : exit->use_edges()) {
+      Node* use = edge.from();
+      if (use == merge || use->opcode() == IrOpcode::kLoopExitValue ||
+          use->opcode() == IrOpcode::kLoopExitEffect) {
+        continue;
+      }
+      edge.UpdateTo(merge);
+    }
+
+    for (Node* marker : markers) {
+      inputs.clear();
+      for (size_t i = 0; i < count; i++) {
+        inputs.push_back(iterations->map(marker, i));
+      }
+      inputs.push_back(merge);
+      const Operator* op =
+          marker->opcode() == IrOpcode::kLoopExitValue
+              ? common_->Phi(MachineRepresentation::kTagged, iteration_count)
+              : common_->EffectPhi(iteration_count);
+      Node* phi = graph_->NewNode(op, iteration_count + 1, &inputs[0]);
+      if (NodeProperties::IsTyped(marker)) {
+        NodeProperties::SetType(phi, NodeProperties::GetType(marker));
+      }
+      for (Edge edge : marker->use_edges()) {
+        if (edge.from() != phi) edge.UpdateTo(phi);
+      }
+    }
+  }
+
+  //============================================================================
+  // Feed the backedge of the loop from the last iteration.
+  //============================================================================
+  for (Node* node : loop_tree_->HeaderNodes(loop)) {
+    node->ReplaceInput(1, iterations->map(node->InputAt(1), count - 1));
+  }
+
+  for (Node* node : loop_tree_->BodyNodes(loop)) {
+    if (!IsIterationBodyStackCheck(node)) continue;
+    for (size_t i = 1; i < count; i++) {
+      RemoveStackCheck(iterations->map(node, i));
+    }
+  }
+  return iterations;
+}
+
+// static
+size_t LoopUnroller::UnrollingCount(LoopTree::Loop* loop) {
+  if (!loop->children().empty()) return 0;
+  return std::min(kMaxUnrolledNodes / loop->TotalSize(), kMaxUnrollingCount);
+}
+
+bool LoopUnroller::UnrollInnerLoops(LoopTree::Loop* loop) {
+  // If the loop has nested loops, unroll inside those.
+  if (!loop->children().empty()) {
+    bool unrolled = false;
+    for (LoopTree::Loop* inner_loop : loop->children()) {
+      if (UnrollInnerLoops(inner_loop)) unrolled = true;
+    }
+    return unrolled;
+  }
+  size_t count = UnrollingCount(loop);
+  if (count < 2) return false;
+  if (FLAG_trace_turbo_loop) {
+    PrintF("Unrolling loop with header %i %zu times\n",
+           loop_tree_->GetLoopControl(loop)->id(), count);
+  }
+  return Unroll(loop, count) != nullptr;
+}
+
+bool LoopUnroller::UnrollInnerLoopsOfTree() {
+  bool unrolled = false;
+  for (LoopTree::Loop* loop : loop_tree_->outer_loops()) {
+    if (UnrollInnerLoops(loop)) unrolled = true;
+  }
+  return unrolled;
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
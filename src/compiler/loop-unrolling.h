@@ -0,0 +1,83 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_LOOP_UNROLLING_H_
+#define V8_COMPILER_LOOP_UNROLLING_H_
+
+#include "src/base/compiler-specific.h"
+#include "src/common/globals.h"
+#include "src/compiler/loop-analysis.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class CommonOperatorBuilder;
+class NodeOriginTable;
+class SourcePositionTable;
+
+// Represents the output of unrolling a loop, which is the mapping from the
+// nodes of the loop to their copies in each additional iteration.
+class V8_EXPORT_PRIVATE UnrolledIterations
+    : public NON_EXPORTED_BASE(ZoneObject) {
+ public:
+  // Maps {node} to its copy in the {iteration}th iteration of the unrolled
+  // loop, where iteration 0 is the original body. Returns {node} if it is not
+  // part of the loop.
+  Node* map(Node* node, size_t iteration);
+
+ protected:
+  UnrolledIterations() = default;
+};
+
+// Implements loop unrolling of small innermost loops. The body of the loop is
+// copied {count - 1} times and the copies are chained, such that every trip
+// around the loop executes {count} iterations of the original loop. Each copy
+// keeps its own exit condition, so no trip count is required; the unrolled
+// loop saves the backedge and the phi moves of all but the last iteration,
+// and the copies are subject to the redundancy elimination of later phases.
+//
+// Exits from the copies are marked as exits of the unrolled loop and merged
+// with the original exits, so the result can be peeled.
+class V8_EXPORT_PRIVATE LoopUnroller {
+ public:
+  LoopUnroller(Graph* graph, CommonOperatorBuilder* common, LoopTree* loop_tree,
+               Zone* tmp_zone, SourcePositionTable* source_positions,
+               NodeOriginTable* node_origins)
+      : graph_(graph),
+        common_(common),
+        loop_tree_(loop_tree),
+        tmp_zone_(tmp_zone),
+        source_positions_(source_positions),
+        node_origins_(node_origins) {}
+
+  bool CanUnroll(LoopTree::Loop* loop);
+  UnrolledIterations* Unroll(LoopTree::Loop* loop, size_t count);
+  // Unrolls all innermost loops that are small enough, returns whether any
+  // loop was unrolled.
+  bool UnrollInnerLoopsOfTree();
+
+  // The number of iterations an unrolled {loop} should execute per trip, or
+  // a value below 2 if the loop should not be unrolled.
+  static size_t UnrollingCount(LoopTree::Loop* loop);
+
+  static const size_t kMaxUnrolledNodes = 200;
+  static const size_t kMaxUnrollingCount = 4;
+
+ private:
+  Graph* const graph_;
+  CommonOperatorBuilder* const common_;
+  LoopTree* const loop_tree_;
+  Zone* const tmp_zone_;
+  SourcePositionTable* const source_positions_;
+  NodeOriginTable* const node_origins_;
+
+  bool UnrollInnerLoops(LoopTree::Loop* loop);
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_LOOP_UNROLLING_H_
@@ -345,6 +345,17 @@ void LoopVariableOptimizer::ChangeToPhisAndInsertGuards() {
   }
 }
 
+void LoopVariableOptimizer::CollectStrictUpperLimits(Node* control,
+                                                     Node* left,
+                                                     NodeVector* limits) {
+  for (Constraint constraint : limits_.Get(control)) {
+    if (constraint.left == left &&
+        constraint.kind == InductionVariable::kStrict) {
+      limits->push_back(constraint.right);
+    }
+  }
+}
+
 #undef TRACE
 
 }  // namespace compiler
@@ -7,6 +7,7 @@
 
 #include "src/compiler/functional-list.h"
 #include "src/compiler/node-aux-data.h"
+#include "src/compiler/node.h"
 #include "src/zone/zone-containers.h"
 
 namespace v8 {
@@ -15,7 +16,6 @@ namespace compiler {
 
 class CommonOperatorBuilder;
 class Graph;
-class Node;
 
 class InductionVariable : public ZoneObject {
  public:
@@ -81,6 +81,11 @@ class LoopVariableOptimizer {
   void ChangeToInductionVariablePhis();
   void ChangeToPhisAndInsertGuards();
 
+  // Collects the nodes {right} for which the strict constraint
+  // {left} < {right} holds whenever {control} is reached. Only constraints
+  // involving induction variables are tracked.
+  void CollectStrictUpperLimits(Node* control, Node* left, NodeVector* limits);
+
  private:
   const int kAssumedLoopEntryIndex = 0;
   const int kFirstBackedge = 1;
@@ -0,0 +1,892 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-vectorization.h"
+
+#include "src/compiler/common-operator.h"
+#include "src/compiler/compiler-source-position-table.h"
+#include "src/compiler/js-graph.h"
+#include "src/compiler/machine-operator.h"
+#include "src/compiler/node-matchers.h"
+#include "src/compiler/node-origin-table.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/node.h"
+#include "src/compiler/simplified-operator.h"
+#include "src/zone/zone-containers.h"
+
+// Loop vectorization copies the loop into a vector loop in front of it. Each
+// iteration of the vector loop executes the iterations {j} to {j + lanes - 1}
+// of the original loop, which then executes the remaining iterations:
+//
+//          E
+//          |
+//       ( Branch )-- overlapping arrays --+
+//          |                              |
+//       ( VLoop )<---- ( phiJ )<-----+    |
+//          |                         |    |
+//     ((== c(j + lanes - 1) ==))     |    |
+//     ((   vector body        ))     |    |
+//     ((======================))     |    |
+//          |         |               |    |
+//          |         +-- j + lanes --+    |
+//          |                              |
+//       ( Merge )<------------------------+
+//          |
+//       ( Loop )<---- ( phiI )<----+
+//          |                       |
+//     ((== c(i) ==============))   |
+//     ((   original body      ))   |
+//     ((======================))   |
+//          |         |             |
+//          |         +-- i + 1 ----+
+//          |
+//         exit
+//
+// The vector loop is exited into the original loop as soon as the condition
+// {c} of the loop does not hold for the last lane. The exits of the original
+// loop are the only exits, so the code after the loop is unaffected.
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+#define TRACE(...)                                  \
+  do {                                              \
+    if (FLAG_trace_turbo_loop) PrintF(__VA_ARGS__); \
+  } while (false)
+
+const size_t LoopVectorizer::kMaxVectorizedNodes;
+
+namespace {
+
+enum class LaneShape { kNone, kFloat64x2, kInt32x4 };
+
+LaneShape LaneShapeOf(ExternalArrayType array_type) {
+  switch (array_type) {
+    case kExternalFloat64Array:
+      return LaneShape::kFloat64x2;
+    case kExternalInt32Array:
+    case kExternalUint32Array:
+      return LaneShape::kInt32x4;
+    default:
+      return LaneShape::kNone;
+  }
+}
+
+int LaneCount(LaneShape shape) {
+  DCHECK_NE(LaneShape::kNone, shape);
+  return shape == LaneShape::kFloat64x2 ? 2 : 4;
+}
+
+// Returns the SIMD operator that applies {op} to all lanes of {shape}, or
+// nullptr if there is none.
+const Operator* LaneWiseOperator(MachineOperatorBuilder* machine,
+                                 const Operator* op, LaneShape shape) {
+  if (shape == LaneShape::kFloat64x2) {
+    switch (op->opcode()) {
+      case IrOpcode::kFloat64Add:
+        return machine->F64x2Add();
+      case IrOpcode::kFloat64Sub:
+        return machine->F64x2Sub();
+      case IrOpcode::kFloat64Mul:
+        return machine->F64x2Mul();
+      case IrOpcode::kFloat64Div:
+        return machine->F64x2Div();
+      case IrOpcode::kFloat64Abs:
+        return machine->F64x2Abs();
+      case IrOpcode::kFloat64Neg:
+        return machine->F64x2Neg();
+      case IrOpcode::kFloat64Sqrt:
+        return machine->F64x2Sqrt();
+      default:
+        return nullptr;
+    }
+  }
+  if (shape == LaneShape::kInt32x4) {
+    switch (op->opcode()) {
+      case IrOpcode::kInt32Add:
+        return machine->I32x4Add();
+      case IrOpcode::kInt32Sub:
+        return machine->I32x4Sub();
+      case IrOpcode::kInt32Mul:
+        return machine->I32x4Mul();
+      case IrOpcode::kWord32And:
+        return machine->S128And();
+      case IrOpcode::kWord32Or:
+        return machine->S128Or();
+      case IrOpcode::kWord32Xor:
+        return machine->S128Xor();
+      case IrOpcode::kWord32Shl:
+        return machine->I32x4Shl();
+      case IrOpcode::kWord32Sar:
+        return machine->I32x4ShrS();
+      case IrOpcode::kWord32Shr:
+        return machine->I32x4ShrU();
+      default:
+        return nullptr;
+    }
+  }
+  return nullptr;
+}
+
+// The SIMD shifts shift all lanes by the same scalar amount.
+bool IsShift(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kWord32Shl:
+    case IrOpcode::kWord32Sar:
+    case IrOpcode::kWord32Shr:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsLessThan(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kInt32LessThan:
+    case IrOpcode::kInt32LessThanOrEqual:
+    case IrOpcode::kUint32LessThan:
+    case IrOpcode::kUint32LessThanOrEqual:
+    case IrOpcode::kInt64LessThan:
+    case IrOpcode::kInt64LessThanOrEqual:
+    case IrOpcode::kUint64LessThan:
+    case IrOpcode::kUint64LessThanOrEqual:
+    case IrOpcode::kFloat64LessThan:
+    case IrOpcode::kFloat64LessThanOrEqual:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Conversions that preserve the order of int32 values in [0, kMaxInt].
+bool IsMonotoneConversion(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kChangeInt32ToFloat64:
+    case IrOpcode::kChangeUint32ToFloat64:
+    case IrOpcode::kChangeInt32ToInt64:
+    case IrOpcode::kChangeUint32ToUint64:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsBoundsCheck(Node* node) {
+  return node->opcode() == IrOpcode::kCheckedUint32Bounds ||
+         node->opcode() == IrOpcode::kCheckedUint64Bounds;
+}
+
+bool IsStateNode(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kFrameState:
+    case IrOpcode::kStateValues:
+    case IrOpcode::kTypedStateValues:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// The analysis and the transformation of a single loop.
+class VectorizationCandidate {
+ public:
+  VectorizationCandidate(JSGraph* jsgraph, LoopTree* loop_tree,
+                         LoopTree::Loop* loop, Zone* zone,
+                         SourcePositionTable* source_positions,
+                         NodeOriginTable* node_origins)
+      : jsgraph_(jsgraph),
+        loop_tree_(loop_tree),
+        loop_(loop),
+        zone_(zone),
+        source_positions_(source_positions),
+        node_origins_(node_origins),
+        loop_node_(loop_tree->GetLoopControl(loop)),
+        kinds_(zone),
+        effects_(zone),
+        arrays_(zone),
+        copies_(zone),
+        splats_(zone) {}
+
+  int lane_count() const { return LaneCount(shape_); }
+
+  // Returns whether the loop can be vectorized.
+  bool Analyze();
+  void Vectorize();
+
+ private:
+  // The values in the loop are either the same for all lanes, the induction
+  // variable or derived from it, or vectors of elements.
+  enum class Kind { kUniform, kIndex, kVector, kInvalid };
+
+  struct TypedArray {
+    Node* buffer;
+    Node* base;
+    Node* external;
+    bool stored;
+  };
+
+  Graph* graph() const { return jsgraph_->graph(); }
+  CommonOperatorBuilder* common() const { return jsgraph_->common(); }
+  MachineOperatorBuilder* machine() const { return jsgraph_->machine(); }
+  SimplifiedOperatorBuilder* simplified() const {
+    return jsgraph_->simplified();
+  }
+
+  bool Fail(const char* reason) {
+    TRACE("Cannot vectorize loop %i. %s.\n", loop_node_->id(), reason);
+    return false;
+  }
+  bool Contains(Node* node) { return loop_tree_->Contains(loop_, node); }
+
+  bool AnalyzeHeader();
+  bool AnalyzeControl();
+  bool AnalyzeEffects();
+  bool AnalyzeAccess(Node* node);
+  bool AnalyzeFrameState(Node* frame_state, bool after_store);
+  bool AnalyzeVectorUses();
+
+  Kind Classify(Node* node);
+  Kind ComputeKind(Node* node);
+  bool IsIndex(Node* node);
+  template <typename Predicate>
+  bool Reaches(Node* from, Node* stop, Predicate predicate);
+
+  Node* Map(Node* node);
+  Node* RebuildIndex(Node* node, Node* index);
+  Node* Splat(Node* value);
+  Node* ExtractFirstLane(Node* vector);
+  Node* BuildNoOverlap(const TypedArray& a, const TypedArray& b);
+  Node* BuildNoOverlap();
+
+  JSGraph* const jsgraph_;
+  LoopTree* const loop_tree_;
+  LoopTree::Loop* const loop_;
+  Zone* const zone_;
+  SourcePositionTable* const source_positions_;
+  NodeOriginTable* const node_origins_;
+
+  Node* const loop_node_;
+  Node* phi_ = nullptr;
+  Node* effect_phi_ = nullptr;
+  Node* increment_ = nullptr;
+  Node* branch_ = nullptr;
+  Node* condition_ = nullptr;
+  Node* exit_effect_ = nullptr;
+  LaneShape shape_ = LaneShape::kNone;
+
+  ZoneUnorderedMap<Node*, Kind> kinds_;
+  NodeVector effects_;
+  ZoneVector<TypedArray> arrays_;
+  ZoneUnorderedMap<Node*, Node*> copies_;
+  ZoneUnorderedMap<Node*, Node*> splats_;
+};
+
+VectorizationCandidate::Kind VectorizationCandidate::Classify(Node* node) {
+  if (!Contains(node)) return Kind::kUniform;
+  auto it = kinds_.find(node);
+  if (it != kinds_.end()) return it->second;
+  // Guard against cycles, which only exist through the rejected phis.
+  kinds_[node] = Kind::kInvalid;
+  Kind const kind = ComputeKind(node);
+  kinds_[node] = kind;
+  return kind;
+}
+
+VectorizationCandidate::Kind VectorizationCandidate::ComputeKind(Node* node) {
+  if (node == phi_) return Kind::kIndex;
+  switch (node->opcode()) {
+    case IrOpcode::kPhi:
+    case IrOpcode::kEffectPhi:
+      return Kind::kInvalid;
+    case IrOpcode::kLoadTypedElement:
+      return IsIndex(node->InputAt(3)) ? Kind::kVector : Kind::kInvalid;
+    default:
+      break;
+  }
+  bool const lane_wise =
+      LaneWiseOperator(machine(), node->op(), shape_) != nullptr;
+  Kind kind = Kind::kUniform;
+  for (int i = 0; i < node->op()->ValueInputCount(); ++i) {
+    switch (Classify(node->InputAt(i))) {
+      case Kind::kUniform:
+        break;
+      case Kind::kIndex:
+        if (kind == Kind::kVector) return Kind::kInvalid;
+        kind = Kind::kIndex;
+        break;
+      case Kind::kVector:
+        // Frame states refer to the elements of the first lane.
+        if (IsStateNode(node)) {
+          kind = Kind::kIndex;
+          break;
+        }
+        if (!lane_wise || kind == Kind::kIndex) return Kind::kInvalid;
+        if (IsShift(node) && i == 1) return Kind::kInvalid;
+        kind = Kind::kVector;
+        break;
+      case Kind::kInvalid:
+        return Kind::kInvalid;
+    }
+  }
+  return kind;
+}
+
+// The index of an element access in the current iteration is the induction
+// variable, possibly converted to a word and checked against a length.
+bool VectorizationCandidate::IsIndex(Node* node) {
+  while (node != phi_) {
+    switch (node->opcode()) {
+      case IrOpcode::kChangeInt32ToInt64:
+      case IrOpcode::kChangeUint32ToUint64:
+      case IrOpcode::kCheckedUint32Bounds:
+      case IrOpcode::kCheckedUint64Bounds:
+        node = node->InputAt(0);
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+// Returns whether {from} or one of its transitive value inputs in the loop
+// satisfies {predicate}, without looking through {stop}.
+template <typename Predicate>
+bool VectorizationCandidate::Reaches(Node* from, Node* stop,
+                                     Predicate predicate) {
+  ZoneUnorderedSet<Node*> visited(zone_);
+  NodeVector stack(zone_);
+  stack.push_back(from);
+  while (!stack.empty()) {
+    Node* node = stack.back();
+    stack.pop_back();
+    if (node == stop || !Contains(node) || !visited.insert(node).second) {
+      continue;
+    }
+    if (predicate(node)) return true;
+    for (int i = 0; i < node->op()->ValueInputCount(); ++i) {
+      stack.push_back(node->InputAt(i));
+    }
+  }
+  return false;
+}
+
+bool VectorizationCandidate::AnalyzeHeader() {
+  if (loop_node_->InputCount() != 2) return Fail("It has several backedges");
+  for (Node* node : loop_tree_->HeaderNodes(loop_)) {
+    switch (node->opcode()) {
+      case IrOpcode::kLoop:
+        break;
+      case IrOpcode::kPhi:
+        if (phi_ != nullptr) return Fail("It has several phis");
+        phi_ = node;
+        break;
+      case IrOpcode::kEffectPhi:
+        effect_phi_ = node;
+        break;
+      default:
+        return Fail("It has an unsupported phi");
+    }
+  }
+  if (phi_ == nullptr || effect_phi_ == nullptr) {
+    return Fail("It has no induction variable");
+  }
+  if (PhiRepresentationOf(phi_->op()) != MachineRepresentation::kWord32) {
+    return Fail("The induction variable is not a word32");
+  }
+
+  // The induction variable is incremented by one.
+  increment_ = phi_->InputAt(1);
+  if ((increment_->opcode() != IrOpcode::kInt32Add &&
+       increment_->opcode() != IrOpcode::kCheckedInt32Add) ||
+      increment_->InputAt(0) != phi_ ||
+      !Int32Matcher(increment_->InputAt(1)).Is(1)) {
+    return Fail("The induction variable is not incremented by one");
+  }
+  for (Edge edge : increment_->use_edges()) {
+    Node* use = edge.from();
+    if (use == phi_ || !Contains(use) || !NodeProperties::IsValueEdge(edge)) {
+      continue;
+    }
+    if (!IsStateNode(use)) return Fail("The increment is used in the body");
+  }
+  return true;
+}
+
+bool VectorizationCandidate::AnalyzeControl() {
+  // The only branch in the loop is the exit.
+  for (Node* node : loop_tree_->BodyNodes(loop_)) {
+    if (node->op()->ControlOutputCount() == 0) continue;
+    switch (node->opcode()) {
+      case IrOpcode::kBranch:
+        if (branch_ != nullptr) return Fail("It has control flow");
+        branch_ = node;
+        break;
+      case IrOpcode::kIfTrue:
+      case IrOpcode::kIfFalse:
+        break;
+      case IrOpcode::kJSStackCheck:
+        for (Node* use : node->uses()) {
+          if (use->opcode() == IrOpcode::kIfSuccess ||
+              use->opcode() == IrOpcode::kIfException) {
+            return Fail("The stack check has an exception handler");
+          }
+        }
+        break;
+      default:
+        return Fail("It has control flow");
+    }
+  }
+  if (branch_ == nullptr) return Fail("It has no exit");
+  Node* projections[2];
+  NodeProperties::CollectControlProjections(branch_, projections, 2);
+  if (!Contains(projections[0]) || Contains(projections[1])) {
+    return Fail("It is not exited if the condition is false");
+  }
+
+  // The loop is executed while {phi} is less than some invariant value.
+  condition_ = branch_->InputAt(0);
+  if (!IsLessThan(condition_)) return Fail("The condition is no comparison");
+  Node* left = condition_->InputAt(0);
+  while (IsMonotoneConversion(left)) left = left->InputAt(0);
+  if (left != phi_) return Fail("The condition does not bound the phi");
+  return true;
+}
+
+bool VectorizationCandidate::AnalyzeAccess(Node* node) {
+  for (int i = 0; i < 3; ++i) {
+    if (Contains(node->InputAt(i))) return Fail("An array is not invariant");
+  }
+  if (!IsIndex(node->InputAt(3))) return Fail("An access is not element-wise");
+  bool const store = node->opcode() == IrOpcode::kStoreTypedElement;
+  if (store) {
+    Kind const value = Classify(node->InputAt(4));
+    if (value != Kind::kVector && value != Kind::kUniform) {
+      return Fail("A stored value cannot be vectorized");
+    }
+  }
+  for (TypedArray& array : arrays_) {
+    if (array.buffer == node->InputAt(0) && array.base == node->InputAt(1) &&
+        array.external == node->InputAt(2)) {
+      array.stored |= store;
+      return true;
+    }
+  }
+  arrays_.push_back(
+      {node->InputAt(0), node->InputAt(1), node->InputAt(2), store});
+  return true;
+}
+
+// The vector loop deoptimizes to the state of the first lane before the first
+// store, and to the state after the last lane from there on.
+bool VectorizationCandidate::AnalyzeFrameState(Node* frame_state,
+                                               bool after_store) {
+  if (Classify(frame_state) == Kind::kInvalid) {
+    return Fail("A frame state cannot be vectorized");
+  }
+  bool const other_iteration =
+      after_store ? Reaches(frame_state, increment_,
+                            [this](Node* node) {
+                              return node == phi_ ||
+                                     Classify(node) == Kind::kVector;
+                            })
+                  : Reaches(frame_state, nullptr,
+                            [this](Node* node) { return node == increment_; });
+  if (other_iteration) {
+    return Fail("A frame state refers to another iteration");
+  }
+  return true;
+}
+
+bool VectorizationCandidate::AnalyzeEffects() {
+  // The effect chain is a straight line from the effect phi to the backedge.
+  Node* effect = effect_phi_;
+  while (effect != effect_phi_->InputAt(1)) {
+    Node* next = nullptr;
+    for (Edge edge : effect->use_edges()) {
+      Node* use = edge.from();
+      if (!NodeProperties::IsEffectEdge(edge) || !Contains(use) ||
+          use == effect_phi_) {
+        continue;
+      }
+      if (next != nullptr) return Fail("The effect chain is split");
+      next = use;
+    }
+    if (next == nullptr || next->op()->EffectInputCount() != 1) {
+      return Fail("The effect chain is split");
+    }
+    effects_.push_back(next);
+    effect = next;
+  }
+  size_t effect_count = 0;
+  for (Node* node : loop_tree_->BodyNodes(loop_)) {
+    if (node->op()->EffectOutputCount() > 0) effect_count++;
+  }
+  if (effect_count != effects_.size()) return Fail("The effect chain is split");
+
+  // The code after the loop continues from a single effect, which has to be
+  // before any access to the elements.
+  size_t exit_position = 0;
+  for (size_t i = 0; i <= effects_.size(); ++i) {
+    Node* node = i == 0 ? effect_phi_ : effects_[i - 1];
+    for (Edge edge : node->use_edges()) {
+      Node* use = edge.from();
+      if (!NodeProperties::IsEffectEdge(edge) || Contains(use) ||
+          use->opcode() == IrOpcode::kTerminate) {
+        continue;
+      }
+      if (exit_effect_ != nullptr && exit_effect_ != node) {
+        return Fail("It has several exit effects");
+      }
+      exit_effect_ = node;
+      exit_position = i;
+    }
+  }
+  if (exit_effect_ == nullptr) return Fail("It has no exit effect");
+
+  // All element accesses are of the same shape.
+  for (Node* node : effects_) {
+    if (node->opcode() != IrOpcode::kLoadTypedElement &&
+        node->opcode() != IrOpcode::kStoreTypedElement) {
+      continue;
+    }
+    LaneShape const shape = LaneShapeOf(ExternalArrayTypeOf(node->op()));
+    if (shape == LaneShape::kNone) {
+      return Fail("The element type is unsupported");
+    }
+    if (shape_ != LaneShape::kNone && shape != shape_) {
+      return Fail("It mixes element types");
+    }
+    shape_ = shape;
+  }
+
+  bool after_store = false;
+  for (size_t i = 0; i < effects_.size(); ++i) {
+    Node* node = effects_[i];
+    switch (node->opcode()) {
+      case IrOpcode::kCheckpoint:
+      case IrOpcode::kJSStackCheck:
+        if (!AnalyzeFrameState(NodeProperties::GetFrameStateInput(node),
+                               after_store)) {
+          return false;
+        }
+        break;
+      case IrOpcode::kLoadTypedElement:
+      case IrOpcode::kStoreTypedElement:
+        if (i < exit_position) return Fail("It accesses elements before exit");
+        if (!AnalyzeAccess(node)) return false;
+        if (node->opcode() == IrOpcode::kStoreTypedElement) after_store = true;
+        break;
+      default:
+        if (node == increment_) break;
+        if (after_store && !node->op()->HasProperty(Operator::kNoDeopt)) {
+          return Fail("It deoptimizes after a store");
+        }
+        if (IsBoundsCheck(node) && Classify(node->InputAt(0)) == Kind::kIndex) {
+          if (i < exit_position) return Fail("It checks an index before exit");
+          if (!IsIndex(node->InputAt(0)) ||
+              Classify(node->InputAt(1)) != Kind::kUniform) {
+            return Fail("A bounds check is not element-wise");
+          }
+          break;
+        }
+        if (!node->op()->HasProperty(Operator::kNoWrite) ||
+            Classify(node) != Kind::kUniform) {
+          TRACE("Cannot vectorize loop %i. #%d:%s is not supported.\n",
+                loop_node_->id(), node->id(), node->op()->mnemonic());
+          return false;
+        }
+        break;
+    }
+  }
+  if (!after_store) return Fail("It does not store elements");
+  if (Classify(condition_->InputAt(1)) != Kind::kUniform) {
+    return Fail("The bound of the condition is not invariant");
+  }
+  return true;
+}
+
+// Vectors of elements are only used in lane-wise operations, stores and frame
+// states.
+bool VectorizationCandidate::AnalyzeVectorUses() {
+  NodeVector vectors(zone_);
+  for (Node* node : loop_tree_->BodyNodes(loop_)) {
+    if (Classify(node) == Kind::kVector) vectors.push_back(node);
+  }
+  for (Node* node : vectors) {
+    for (Edge edge : node->use_edges()) {
+      Node* use = edge.from();
+      if (!NodeProperties::IsValueEdge(edge)) continue;
+      if (!Contains(use)) return Fail("An element is used after the loop");
+      if (IsStateNode(use)) continue;
+      if (use->opcode() == IrOpcode::kStoreTypedElement && edge.index() == 4) {
+        continue;
+      }
+      if (Classify(use) != Kind::kVector ||
+          use->opcode() == IrOpcode::kLoadTypedElement) {
+        return Fail("An element is used in a scalar operation");
+      }
+    }
+  }
+  return true;
+}
+
+bool VectorizationCandidate::Analyze() {
+  if (!loop_->children().empty()) return Fail("It is not innermost");
+  if (loop_->TotalSize() > LoopVectorizer::kMaxVectorizedNodes) {
+    return Fail("It is too large");
+  }
+  return AnalyzeHeader() && AnalyzeControl() && AnalyzeEffects() &&
+         AnalyzeVectorUses();
+}
+
+Node* VectorizationCandidate::Map(Node* node) {
+  auto it = copies_.find(node);
+  return it == copies_.end() ? node : it->second;
+}
+
+// Applies the conversions between {phi} and {node} to {index}.
+Node* VectorizationCandidate::RebuildIndex(Node* node, Node* index) {
+  if (node == phi_) return index;
+  Node* input = RebuildIndex(node->InputAt(0), index);
+  if (IsBoundsCheck(node)) return input;
+  return graph()->NewNode(node->op(), input);
+}
+
+Node* VectorizationCandidate::Splat(Node* value) {
+  auto it = splats_.find(value);
+  if (it != splats_.end()) return it->second;
+  const Operator* op = shape_ == LaneShape::kFloat64x2
+                           ? machine()->F64x2Splat()
+                           : machine()->I32x4Splat();
+  Node* splat = graph()->NewNode(op, value);
+  splats_.emplace(value, splat);
+  return splat;
+}
+
+Node* VectorizationCandidate::ExtractFirstLane(Node* vector) {
+  const Operator* op = shape_ == LaneShape::kFloat64x2
+                           ? machine()->F64x2ExtractLane(0)
+                           : machine()->I32x4ExtractLane(0);
+  return graph()->NewNode(op, vector);
+}
+
+// Typed arrays with different on-heap backing stores, or with an on-heap and
+// an off-heap backing store, do not overlap. Otherwise their data pointers
+// have to be the same or at least one vector apart.
+Node* VectorizationCandidate::BuildNoOverlap(const TypedArray& a,
+                                             const TypedArray& b) {
+  const Operator* tagged_equal = COMPRESS_POINTERS_BOOL
+                                     ? machine()->Word32Equal()
+                                     : machine()->WordEqual();
+  Node* different_base = graph()->NewNode(
+      machine()->Word32Equal(), graph()->NewNode(tagged_equal, a.base, b.base),
+      jsgraph_->Int32Constant(0));
+  Node* same_start =
+      graph()->NewNode(machine()->WordEqual(), a.external, b.external);
+  Node* const distance = jsgraph_->IntPtrConstant(kSimd128Size - 1);
+  Node* a_before_b = graph()->NewNode(
+      machine()->UintLessThan(),
+      graph()->NewNode(machine()->IntAdd(), a.external, distance), b.external);
+  Node* b_before_a = graph()->NewNode(
+      machine()->UintLessThan(),
+      graph()->NewNode(machine()->IntAdd(), b.external, distance), a.external);
+  return graph()->NewNode(
+      machine()->Word32Or(),
+      graph()->NewNode(machine()->Word32Or(), different_base, same_start),
+      graph()->NewNode(machine()->Word32Or(), a_before_b, b_before_a));
+}
+
+// Returns the condition that no stored typed array overlaps with another one,
+// or nullptr if there is nothing to check.
+Node* VectorizationCandidate::BuildNoOverlap() {
+  Node* condition = nullptr;
+  for (size_t i = 0; i < arrays_.size(); ++i) {
+    for (size_t j = i + 1; j < arrays_.size(); ++j) {
+      if (!arrays_[i].stored && !arrays_[j].stored) continue;
+      Node* no_overlap = BuildNoOverlap(arrays_[i], arrays_[j]);
+      condition = condition == nullptr
+                      ? no_overlap
+                      : graph()->NewNode(machine()->Word32And(), condition,
+                                         no_overlap);
+    }
+  }
+  return condition;
+}
+
+void VectorizationCandidate::Vectorize() {
+  Node* const entry_control = loop_node_->InputAt(kAssumedLoopEntryIndex);
+  Node* const entry_effect = effect_phi_->InputAt(kAssumedLoopEntryIndex);
+  Node* const entry_value = phi_->InputAt(kAssumedLoopEntryIndex);
+
+  //============================================================================
+  // Copy the loop.
+  //============================================================================
+  NodeVector inputs(zone_);
+  for (Node* node : loop_tree_->LoopNodes(loop_)) {
+    SourcePositionTable::Scope position(
+        source_positions_, source_positions_->GetSourcePosition(node));
+    NodeOriginTable::Scope origin_scope(node_origins_, "vectorize loop", node);
+    inputs.clear();
+    for (Node* input : node->inputs()) inputs.push_back(input);
+    copies_.emplace(
+        node, graph()->NewNode(node->op(), node->InputCount(), &inputs[0]));
+  }
+  for (Node* node : loop_tree_->LoopNodes(loop_)) {
+    Node* copy = Map(node);
+    for (int i = 0; i < copy->InputCount(); ++i) {
+      copy->ReplaceInput(i, Map(node->InputAt(i)));
+    }
+  }
+  Node* const vector_loop = Map(loop_node_);
+  Node* const vector_phi = Map(phi_);
+  Node* const vector_branch = Map(branch_);
+  int const lanes = lane_count();
+
+  //============================================================================
+  // Step over all lanes. The loop condition below rules out overflows.
+  //============================================================================
+  Node* vector_increment = Map(increment_);
+  Node* step = graph()->NewNode(machine()->Int32Add(), vector_phi,
+                                jsgraph_->Int32Constant(lanes));
+  NodeProperties::ReplaceUses(
+      vector_increment, step,
+      increment_->op()->EffectInputCount() > 0
+          ? NodeProperties::GetEffectInput(vector_increment)
+          : nullptr);
+  vector_increment->Kill();
+
+  //============================================================================
+  // Continue while the condition holds for the last lane, which implies that
+  // it holds for all lanes. The last lane does not overflow the int32 range.
+  //============================================================================
+  Node* last_lane = graph()->NewNode(machine()->Int32Add(), vector_phi,
+                                     jsgraph_->Int32Constant(lanes - 1));
+  Node* condition =
+      graph()->NewNode(condition_->op(),
+                       RebuildIndex(condition_->InputAt(0), last_lane),
+                       Map(condition_->InputAt(1)));
+  Node* in_range =
+      graph()->NewNode(machine()->Uint32LessThanOrEqual(), vector_phi,
+                       jsgraph_->Int32Constant(kMaxInt - lanes));
+  vector_branch->ReplaceInput(
+      0, graph()->NewNode(machine()->Word32And(), in_range, condition));
+
+  //============================================================================
+  // Lower the body to vector operations.
+  //============================================================================
+  for (Node* node : effects_) {
+    Node* copy = Map(node);
+    switch (node->opcode()) {
+      case IrOpcode::kLoadTypedElement:
+        NodeProperties::ChangeOp(copy, simplified()->LoadTypedElementSimd128(
+                                           ExternalArrayTypeOf(node->op())));
+        break;
+      case IrOpcode::kStoreTypedElement:
+        NodeProperties::ChangeOp(copy, simplified()->StoreTypedElementSimd128(
+                                           ExternalArrayTypeOf(node->op())));
+        if (Classify(node->InputAt(4)) == Kind::kUniform) {
+          copy->ReplaceInput(4, Splat(copy->InputAt(4)));
+        }
+        break;
+      default:
+        // Bounds checks apply to the last lane, the accesses use the index
+        // of the first lane.
+        if (IsBoundsCheck(node) && Classify(node->InputAt(0)) == Kind::kIndex) {
+          Node* first_lane = Map(node->InputAt(0));
+          for (Edge edge : copy->use_edges()) {
+            if (NodeProperties::IsValueEdge(edge)) edge.UpdateTo(first_lane);
+          }
+          copy->ReplaceInput(0, RebuildIndex(node->InputAt(0), last_lane));
+        }
+        break;
+    }
+  }
+  for (Node* node : loop_tree_->BodyNodes(loop_)) {
+    if (IsStateNode(node)) {
+      // Frame states before the first store refer to the first lane.
+      Node* copy = Map(node);
+      for (int i = 0; i < node->op()->ValueInputCount(); ++i) {
+        if (Classify(node->InputAt(i)) == Kind::kVector) {
+          copy->ReplaceInput(i, ExtractFirstLane(copy->InputAt(i)));
+        }
+      }
+      continue;
+    }
+    if (node->opcode() == IrOpcode::kLoadTypedElement ||
+        Classify(node) != Kind::kVector) {
+      continue;
+    }
+    Node* copy = Map(node);
+    NodeProperties::ChangeOp(copy,
+                             LaneWiseOperator(machine(), node->op(), shape_));
+    for (int i = 0; i < node->op()->ValueInputCount(); ++i) {
+      if (IsShift(node) && i == 1) continue;
+      if (Classify(node->InputAt(i)) == Kind::kUniform) {
+        copy->ReplaceInput(i, Splat(copy->InputAt(i)));
+      }
+    }
+  }
+
+  //============================================================================
+  // Enter the vector loop unless the arrays overlap, and continue with the
+  // original loop from where the vector loop left off.
+  //============================================================================
+  Node* exit = graph()->NewNode(common()->IfFalse(), vector_branch);
+  Node* exit_effect = Map(exit_effect_);
+  Node* no_overlap = BuildNoOverlap();
+  if (no_overlap != nullptr) {
+    Node* branch = graph()->NewNode(common()->Branch(BranchHint::kTrue),
+                                    no_overlap, entry_control);
+    vector_loop->ReplaceInput(kAssumedLoopEntryIndex,
+                              graph()->NewNode(common()->IfTrue(), branch));
+    Node* skip = graph()->NewNode(common()->IfFalse(), branch);
+    Node* merge = graph()->NewNode(common()->Merge(2), exit, skip);
+    exit_effect = graph()->NewNode(common()->EffectPhi(2), exit_effect,
+                                   entry_effect, merge);
+    vector_phi = graph()->NewNode(
+        common()->Phi(MachineRepresentation::kWord32, 2), vector_phi,
+        entry_value, merge);
+    exit = merge;
+  }
+  loop_node_->ReplaceInput(kAssumedLoopEntryIndex, exit);
+  effect_phi_->ReplaceInput(kAssumedLoopEntryIndex, exit_effect);
+  phi_->ReplaceInput(kAssumedLoopEntryIndex, vector_phi);
+}
+
+}  // namespace
+
+bool LoopVectorizer::Vectorize(LoopTree::Loop* loop) {
+  VectorizationCandidate candidate(jsgraph_, loop_tree_, loop, tmp_zone_,
+                                   source_positions_, node_origins_);
+  if (!candidate.Analyze()) return false;
+  TRACE("Vectorizing loop %i with %d lanes\n",
+        loop_tree_->GetLoopControl(loop)->id(), candidate.lane_count());
+  candidate.Vectorize();
+  return true;
+}
+
+size_t LoopVectorizer::VectorizeInnermostLoops(LoopTree::Loop* loop) {
+  if (loop->children().empty()) return Vectorize(loop) ? 1 : 0;
+  size_t count = 0;
+  for (LoopTree::Loop* inner_loop : loop->children()) {
+    count += VectorizeInnermostLoops(inner_loop);
+  }
+  return count;
+}
+
+size_t LoopVectorizer::VectorizeInnermostLoopsOfTree() {
+  size_t count = 0;
+  for (LoopTree::Loop* loop : loop_tree_->outer_loops()) {
+    count += VectorizeInnermostLoops(loop);
+  }
+  return count;
+}
+
+#undef TRACE
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
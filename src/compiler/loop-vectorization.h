@@ -0,0 +1,70 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_LOOP_VECTORIZATION_H_
+#define V8_COMPILER_LOOP_VECTORIZATION_H_
+
+#include "src/base/compiler-specific.h"
+#include "src/common/globals.h"
+#include "src/compiler/loop-analysis.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class JSGraph;
+class NodeOriginTable;
+class SourcePositionTable;
+
+// Vectorizes innermost loops that apply the same straight-line computation to
+// the elements of typed arrays at the induction variable, as in
+//
+//   for (let i = 0; i < c.length; ++i) c[i] = a[i] * k + b[i];
+//
+// for Float64Arrays (2 lanes) and Int32Arrays or Uint32Arrays (4 lanes). The
+// loop is copied into a vector loop in front of it, which processes one
+// 128-bit vector of elements per iteration using the SIMD machine operators.
+// The original loop handles the remaining elements and every case the vector
+// loop does not: the vector loop is left as soon as the loop condition does
+// not hold for the last lane, and it is skipped if a typed array that is
+// stored to overlaps with another one at a different offset.
+//
+// The vectorizer runs after simplified lowering, when the representations of
+// the values in the loop are known. Checks in the vector loop apply to the
+// last lane and deoptimize to the state at the start of the first lane, so
+// no checks are allowed after the first store of an iteration. Frame states
+// refer to the first lane of the vectors of elements.
+class V8_EXPORT_PRIVATE LoopVectorizer {
+ public:
+  LoopVectorizer(JSGraph* jsgraph, LoopTree* loop_tree, Zone* tmp_zone,
+                 SourcePositionTable* source_positions,
+                 NodeOriginTable* node_origins)
+      : jsgraph_(jsgraph),
+        loop_tree_(loop_tree),
+        tmp_zone_(tmp_zone),
+        source_positions_(source_positions),
+        node_origins_(node_origins) {}
+
+  // Vectorizes {loop} if it has the required shape, returns whether it did.
+  bool Vectorize(LoopTree::Loop* loop);
+  // Returns the number of vectorized innermost loops.
+  size_t VectorizeInnermostLoopsOfTree();
+
+  static const size_t kMaxVectorizedNodes = 200;
+
+ private:
+  size_t VectorizeInnermostLoops(LoopTree::Loop* loop);
+
+  JSGraph* const jsgraph_;
+  LoopTree* const loop_tree_;
+  Zone* const tmp_zone_;
+  SourcePositionTable* const source_positions_;
+  NodeOriginTable* const node_origins_;
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_LOOP_VECTORIZATION_H_
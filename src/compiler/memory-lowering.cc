@@ -6,12 +6,14 @@
 
 #include "src/codegen/interface-descriptors.h"
 #include "src/common/external-pointer.h"
+#include "src/compiler/compiler-source-position-table.h"
 #include "src/compiler/js-graph.h"
 #include "src/compiler/linkage.h"
 #include "src/compiler/node-matchers.h"
 #include "src/compiler/node-properties.h"
 #include "src/compiler/node.h"
 #include "src/compiler/simplified-operator.h"
+#include "src/diagnostics/allocation-site-profiler.h"
 #include "src/roots/roots-inl.h"
 
 namespace v8 {
@@ -49,7 +51,9 @@ MemoryLowering::MemoryLowering(JSGraph* jsgraph, Zone* zone,
                                PoisoningMitigationLevel poisoning_level,
                                AllocationFolding allocation_folding,
                                WriteBarrierAssertFailedCallback callback,
-                               const char* function_debug_name)
+                               const char* function_debug_name,
+                               SourcePositionTable* source_positions,
+                               AllocationSiteProfilerData* profiler_data)
     : isolate_(jsgraph->isolate()),
       zone_(zone),
       graph_(jsgraph->graph()),
@@ -59,7 +63,9 @@ MemoryLowering::MemoryLowering(JSGraph* jsgraph, Zone* zone,
       allocation_folding_(allocation_folding),
       poisoning_level_(poisoning_level),
       write_barrier_assert_failed_(callback),
-      function_debug_name_(function_debug_name) {}
+      function_debug_name_(function_debug_name),
+      source_positions_(source_positions),
+      allocation_site_profiler_data_(profiler_data) {}
 
 Zone* MemoryLowering::graph_zone() const { return graph()->zone(); }
 
@@ -105,6 +111,8 @@ Reduction MemoryLowering::ReduceAllocateRaw(
 
   gasm()->InitializeEffectControl(effect, control);
 
+  if (allocation_site_profiler_data_ != nullptr) CountAllocation(node, size);
+
   Node* allocate_builtin;
   if (allocation_type == AllocationType::kYoung) {
     if (allow_large_objects == AllowLargeObjects::kTrue) {
@@ -471,6 +479,51 @@ Node* MemoryLowering::ComputeIndex(ElementAccess const& access, Node* index) {
   return index;
 }
 
+void MemoryLowering::CountAllocation(Node* node, Node* size) {
+  // Count down the allocations of the site in front of the allocation, and
+  // only update its counters in a deferred block every n-th allocation. The
+  // counters live outside of the heap, so this neither allocates nor needs a
+  // write barrier, and the allocation itself stays on its fast path and can
+  // still be folded.
+  SourcePosition position = source_positions_ != nullptr
+                                ? source_positions_->GetSourcePosition(node)
+                                : SourcePosition::Unknown();
+  using Counters = AllocationSiteProfilerData::Counters;
+  Counters* site_counters =
+      &allocation_site_profiler_data_->GetOrCreateSite(position)->counters;
+  Node* counters = __ IntPtrConstant(reinterpret_cast<intptr_t>(site_counters));
+  StoreRepresentation store_rep(MachineType::PointerRepresentation(),
+                                kNoWriteBarrier);
+  Node* countdown_offset = __ IntPtrConstant(offsetof(Counters, countdown));
+  Node* countdown = __ IntSub(
+      __ Load(MachineType::Pointer(), counters, countdown_offset),
+      __ IntPtrConstant(1));
+  __ Store(store_rep, counters, countdown_offset, countdown);
+
+  auto sample = __ MakeDeferredLabel();
+  auto done = __ MakeLabel();
+  __ GotoIf(__ WordEqual(countdown, __ IntPtrConstant(0)), &sample);
+  __ Goto(&done);
+
+  __ Bind(&sample);
+  {
+    // Each sample stands for the allocations since the previous one.
+    Node* interval = __ IntPtrConstant(
+        static_cast<intptr_t>(AllocationSiteProfiler::SamplingInterval()));
+    __ Store(store_rep, counters, countdown_offset, interval);
+    Node* count_offset = __ IntPtrConstant(offsetof(Counters, count));
+    Node* count = __ Load(MachineType::Pointer(), counters, count_offset);
+    __ Store(store_rep, counters, count_offset, __ IntAdd(count, interval));
+    Node* bytes_offset = __ IntPtrConstant(offsetof(Counters, bytes));
+    Node* bytes = __ Load(MachineType::Pointer(), counters, bytes_offset);
+    __ Store(store_rep, counters, bytes_offset,
+             __ IntAdd(bytes, __ IntMul(size, interval)));
+    __ Goto(&done);
+  }
+
+  __ Bind(&done);
+}
+
 #undef __
 
 namespace {
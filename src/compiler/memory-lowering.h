@@ -10,6 +10,9 @@
 
 namespace v8 {
 namespace internal {
+
+class AllocationSiteProfilerData;
+
 namespace compiler {
 
 // Forward declarations.
@@ -20,6 +23,7 @@ class JSGraph;
 class MachineOperatorBuilder;
 class Node;
 class Operator;
+class SourcePositionTable;
 
 // Provides operations to lower all simplified memory access and allocation
 // related nodes (i.e. Allocate, LoadField, StoreField and friends) to machine
@@ -79,7 +83,9 @@ class MemoryLowering final : public Reducer {
           AllocationFolding::kDontAllocationFolding,
       WriteBarrierAssertFailedCallback callback = [](Node*, Node*, const char*,
                                                      Zone*) { UNREACHABLE(); },
-      const char* function_debug_name = nullptr);
+      const char* function_debug_name = nullptr,
+      SourcePositionTable* source_positions = nullptr,
+      AllocationSiteProfilerData* allocation_site_profiler_data = nullptr);
 
   const char* reducer_name() const override { return "MemoryReducer"; }
 
@@ -104,6 +110,7 @@ class MemoryLowering final : public Reducer {
 
  private:
   Reduction ReduceAllocateRaw(Node* node);
+  void CountAllocation(Node* node, Node* size);
   WriteBarrierKind ComputeWriteBarrierKind(Node* node, Node* object,
                                            Node* value,
                                            AllocationState const* state,
@@ -131,6 +138,8 @@ class MemoryLowering final : public Reducer {
   PoisoningMitigationLevel poisoning_level_;
   WriteBarrierAssertFailedCallback write_barrier_assert_failed_;
   const char* function_debug_name_;
+  SourcePositionTable* source_positions_;
+  AllocationSiteProfilerData* allocation_site_profiler_data_;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(MemoryLowering);
 };
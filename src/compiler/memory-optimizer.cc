@@ -179,11 +179,14 @@ void WriteBarrierAssertFailed(Node* node, Node* object, const char* name,
 MemoryOptimizer::MemoryOptimizer(
     JSGraph* jsgraph, Zone* zone, PoisoningMitigationLevel poisoning_level,
     MemoryLowering::AllocationFolding allocation_folding,
-    const char* function_debug_name, TickCounter* tick_counter)
+    const char* function_debug_name, TickCounter* tick_counter,
+    SourcePositionTable* source_positions,
+    AllocationSiteProfilerData* allocation_site_profiler_data)
     : graph_assembler_(jsgraph, zone),
       memory_lowering_(jsgraph, zone, &graph_assembler_, poisoning_level,
                        allocation_folding, WriteBarrierAssertFailed,
-                       function_debug_name),
+                       function_debug_name, source_positions,
+                       allocation_site_profiler_data),
       jsgraph_(jsgraph),
       empty_state_(AllocationState::Empty(zone)),
       pending_(zone),
@@ -12,6 +12,7 @@
 namespace v8 {
 namespace internal {
 
+class AllocationSiteProfilerData;
 class TickCounter;
 
 namespace compiler {
@@ -32,7 +33,10 @@ class MemoryOptimizer final {
   MemoryOptimizer(JSGraph* jsgraph, Zone* zone,
                   PoisoningMitigationLevel poisoning_level,
                   MemoryLowering::AllocationFolding allocation_folding,
-                  const char* function_debug_name, TickCounter* tick_counter);
+                  const char* function_debug_name, TickCounter* tick_counter,
+                  SourcePositionTable* source_positions = nullptr,
+                  AllocationSiteProfilerData* allocation_site_profiler_data =
+                      nullptr);
   ~MemoryOptimizer() = default;
 
   void Optimize();
@@ -348,6 +348,48 @@ base::Optional<MapRef> NodeProperties::GetJSCreateMap(JSHeapBroker* broker,
   return base::nullopt;
 }
 
+// static
+MapRef NodeProperties::GetJSCreateIteratorMap(JSHeapBroker* broker,
+                                              Node* receiver) {
+  NativeContextRef native_context = broker->target_native_context();
+  switch (receiver->opcode()) {
+    case IrOpcode::kJSCreateArrayIterator:
+      return native_context.initial_array_iterator_map();
+    case IrOpcode::kJSCreateCollectionIterator: {
+      CreateCollectionIteratorParameters const& p =
+          CreateCollectionIteratorParametersOf(receiver->op());
+      switch (p.collection_kind()) {
+        case CollectionKind::kSet:
+          switch (p.iteration_kind()) {
+            case IterationKind::kKeys:
+              UNREACHABLE();
+            case IterationKind::kValues:
+              return native_context.set_value_iterator_map();
+            case IterationKind::kEntries:
+              return native_context.set_key_value_iterator_map();
+          }
+          break;
+        case CollectionKind::kMap:
+          switch (p.iteration_kind()) {
+            case IterationKind::kKeys:
+              return native_context.map_key_iterator_map();
+            case IterationKind::kValues:
+              return native_context.map_value_iterator_map();
+            case IterationKind::kEntries:
+              return native_context.map_key_value_iterator_map();
+          }
+          break;
+      }
+      break;
+    }
+    case IrOpcode::kJSCreateIterResultObject:
+      return native_context.iterator_result_map();
+    default:
+      break;
+  }
+  UNREACHABLE();
+}
+
 // static
 NodeProperties::InferReceiverMapsResult NodeProperties::InferReceiverMapsUnsafe(
     JSHeapBroker* broker, Node* receiver, Node* effect,
@@ -414,6 +456,16 @@ NodeProperties::InferReceiverMapsResult NodeProperties::InferReceiverMapsUnsafe(
         }
         break;
       }
+      case IrOpcode::kJSCreateArrayIterator:
+      case IrOpcode::kJSCreateCollectionIterator:
+      case IrOpcode::kJSCreateIterResultObject: {
+        if (IsSame(receiver, effect)) {
+          *maps_return = ZoneHandleSet<Map>(
+              GetJSCreateIteratorMap(broker, receiver).object());
+          return result;
+        }
+        break;
+      }
       case IrOpcode::kStoreField: {
         // We only care about StoreField of maps.
         Node* const object = GetValueInput(effect, 0);
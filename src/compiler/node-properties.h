@@ -202,6 +202,11 @@ class V8_EXPORT_PRIVATE NodeProperties final {
   static base::Optional<MapRef> GetJSCreateMap(JSHeapBroker* broker,
                                                Node* receiver);
 
+  // Return the map of the iterator or iterator result object allocated by the
+  // {receiver}, which is a JSCreateArrayIterator, JSCreateCollectionIterator or
+  // JSCreateIterResultObject node.
+  static MapRef GetJSCreateIteratorMap(JSHeapBroker* broker, Node* receiver);
+
   // Walks up the {effect} chain to check that there's no observable side-effect
   // between the {effect} and it's {dominator}. Aborts the walk if there's join
   // in the effect chain.
@@ -430,6 +430,7 @@
   V(LoadMessage)                        \
   V(LoadStackArgument)                  \
   V(LoadTypedElement)                   \
+  V(LoadTypedElementSimd128)            \
   V(MaybeGrowFastElements)              \
   V(NewArgumentsElements)               \
   V(NewConsString)                      \
@@ -471,6 +472,7 @@
   V(StoreSignedSmallElement)            \
   V(StoreToObject)                      \
   V(StoreTypedElement)                  \
+  V(StoreTypedElementSimd128)           \
   V(StringCharCodeAt)                   \
   V(StringCodePointAt)                  \
   V(StringConcat)                       \
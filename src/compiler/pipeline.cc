@@ -27,6 +27,7 @@
 #include "src/compiler/backend/register-allocator-verifier.h"
 #include "src/compiler/backend/register-allocator.h"
 #include "src/compiler/basic-block-instrumentor.h"
+#include "src/compiler/bounds-check-elimination.h"
 #include "src/compiler/branch-elimination.h"
 #include "src/compiler/bytecode-graph-builder.h"
 #include "src/compiler/checkpoint-elimination.h"
@@ -55,8 +56,11 @@
 #include "src/compiler/js-typed-lowering.h"
 #include "src/compiler/load-elimination.h"
 #include "src/compiler/loop-analysis.h"
+#include "src/compiler/loop-check-hoisting.h"
 #include "src/compiler/loop-peeling.h"
+#include "src/compiler/loop-unrolling.h"
 #include "src/compiler/loop-variable-optimizer.h"
+#include "src/compiler/loop-vectorization.h"
 #include "src/compiler/machine-graph-verifier.h"
 #include "src/compiler/machine-operator-reducer.h"
 #include "src/compiler/memory-optimizer.h"
@@ -80,6 +84,7 @@
 #include "src/compiler/verifier.h"
 #include "src/compiler/wasm-compiler.h"
 #include "src/compiler/zone-stats.h"
+#include "src/diagnostics/allocation-site-profiler.h"
 #include "src/diagnostics/code-tracer.h"
 #include "src/diagnostics/disassembler.h"
 #include "src/execution/isolate-inl.h"
@@ -1111,6 +1116,9 @@ PipelineCompilationJob::Status PipelineCompilationJob::PrepareJobImpl(
   if (FLAG_turbo_loop_peeling) {
     compilation_info()->set_loop_peeling();
   }
+  if (FLAG_turbo_loop_unrolling) {
+    compilation_info()->set_loop_unrolling();
+  }
   if (FLAG_turbo_inlining &&
       !compilation_info()->IsNativeContextIndependent()) {
     compilation_info()->set_inlining();
@@ -1698,6 +1706,40 @@ struct LoopPeelingPhase {
   }
 };
 
+struct LoopUnrollingPhase {
+  DECL_PIPELINE_PHASE_CONSTANTS(LoopUnrolling)
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    GraphTrimmer trimmer(temp_zone, data->graph());
+    NodeVector roots(temp_zone);
+    data->jsgraph()->GetCachedNodes(&roots);
+    trimmer.TrimGraph(roots.begin(), roots.end());
+
+    LoopTree* loop_tree = LoopFinder::BuildLoopTree(
+        data->jsgraph()->graph(), &data->info()->tick_counter(), temp_zone);
+    LoopUnroller(data->graph(), data->common(), loop_tree, temp_zone,
+                 data->source_positions(), data->node_origins())
+        .UnrollInnerLoopsOfTree();
+  }
+};
+
+struct LoopVectorizationPhase {
+  DECL_PIPELINE_PHASE_CONSTANTS(LoopVectorization)
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    GraphTrimmer trimmer(temp_zone, data->graph());
+    NodeVector roots(temp_zone);
+    data->jsgraph()->GetCachedNodes(&roots);
+    trimmer.TrimGraph(roots.begin(), roots.end());
+
+    LoopTree* loop_tree = LoopFinder::BuildLoopTree(
+        data->jsgraph()->graph(), &data->info()->tick_counter(), temp_zone);
+    LoopVectorizer(data->jsgraph(), loop_tree, temp_zone,
+                   data->source_positions(), data->node_origins())
+        .VectorizeInnermostLoopsOfTree();
+  }
+};
+
 struct LoopExitEliminationPhase {
   DECL_PIPELINE_PHASE_CONSTANTS(LoopExitElimination)
 
@@ -1875,6 +1917,29 @@ struct LoadEliminationPhase {
   }
 };
 
+struct BoundsCheckEliminationPhase {
+  DECL_PIPELINE_PHASE_CONSTANTS(BoundsCheckElimination)
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    BoundsCheckElimination(data->graph(), data->common(), temp_zone).Run();
+  }
+};
+
+struct LoopCheckHoistingPhase {
+  DECL_PIPELINE_PHASE_CONSTANTS(LoopCheckHoisting)
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    GraphTrimmer trimmer(temp_zone, data->graph());
+    NodeVector roots(temp_zone);
+    data->jsgraph()->GetCachedNodes(&roots);
+    trimmer.TrimGraph(roots.begin(), roots.end());
+
+    LoopTree* loop_tree = LoopFinder::BuildLoopTree(
+        data->jsgraph()->graph(), &data->info()->tick_counter(), temp_zone);
+    LoopCheckHoisting(loop_tree, temp_zone).HoistChecksOfTree();
+  }
+};
+
 struct MemoryOptimizationPhase {
   DECL_PIPELINE_PHASE_CONSTANTS(MemoryOptimization)
 
@@ -1885,13 +1950,22 @@ struct MemoryOptimizationPhase {
     data->jsgraph()->GetCachedNodes(&roots);
     trimmer.TrimGraph(roots.begin(), roots.end());
 
+    // Count the allocations of optimized JavaScript code per site if
+    // requested.
+    if (FLAG_turbo_allocation_profiling && data->info()->IsOptimizing()) {
+      data->info()->SetAllocationSiteProfilerData(
+          std::make_unique<AllocationSiteProfilerData>(data->debug_name()));
+    }
+
     // Optimize allocations and load/store operations.
     MemoryOptimizer optimizer(
         data->jsgraph(), temp_zone, data->info()->GetPoisoningMitigationLevel(),
         data->info()->allocation_folding()
             ? MemoryLowering::AllocationFolding::kDoAllocationFolding
             : MemoryLowering::AllocationFolding::kDontAllocationFolding,
-        data->debug_name(), &data->info()->tick_counter());
+        data->debug_name(), &data->info()->tick_counter(),
+        data->source_positions(),
+        data->info()->allocation_site_profiler_data());
     optimizer.Optimize();
   }
 };
@@ -2525,6 +2599,13 @@ bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
   Run<TypedLoweringPhase>();
   RunPrintAndVerify(TypedLoweringPhase::phase_name());
 
+  // Unrolling relies on the loop exit markers, so it runs before peeling or
+  // the elimination of the markers.
+  if (data->info()->loop_unrolling()) {
+    Run<LoopUnrollingPhase>();
+    RunPrintAndVerify(LoopUnrollingPhase::phase_name(), true);
+  }
+
   if (data->info()->loop_peeling()) {
     Run<LoopPeelingPhase>();
     RunPrintAndVerify(LoopPeelingPhase::phase_name(), true);
@@ -2537,6 +2618,19 @@ bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
     Run<LoadEliminationPhase>();
     RunPrintAndVerify(LoadEliminationPhase::phase_name());
   }
+
+  // Both phases rely on load elimination to unify the loads of lengths.
+  if (FLAG_turbo_bounds_check_elimination) {
+    Run<BoundsCheckEliminationPhase>();
+    RunPrintAndVerify(BoundsCheckEliminationPhase::phase_name());
+  }
+
+  // Load elimination leaves a single check per iteration, which can then be
+  // moved in front of the loop.
+  if (FLAG_turbo_loop_check_hoisting) {
+    Run<LoopCheckHoistingPhase>();
+    RunPrintAndVerify(LoopCheckHoistingPhase::phase_name());
+  }
   data->DeleteTyper();
 
   if (FLAG_turbo_escape) {
@@ -2573,6 +2667,15 @@ bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
   RunPrintAndVerify(UntyperPhase::phase_name(), true);
 #endif
 
+  // The vectorizer relies on the machine representations chosen by simplified
+  // lowering. Poisoned loads have no vector counterpart.
+  if (FLAG_turbo_loop_vectorization && CpuFeatures::SupportsWasmSimd128() &&
+      data->info()->GetPoisoningMitigationLevel() ==
+          PoisoningMitigationLevel::kDontPoison) {
+    Run<LoopVectorizationPhase>();
+    RunPrintAndVerify(LoopVectorizationPhase::phase_name(), true);
+  }
+
   // Run generic lowering pass.
   Run<GenericLoweringPhase>();
   RunPrintAndVerify(GenericLoweringPhase::phase_name(), true);
@@ -3508,6 +3611,15 @@ MaybeHandle<Code> PipelineImpl::FinalizeCode(bool retire_broker) {
   info()->SetCode(code);
   PrintCode(isolate(), code, info());
 
+  // The code embeds the addresses of the allocation site counters, so they
+  // have to live as long as the code.
+  if (AllocationSiteProfilerData* profiler_data =
+          info()->allocation_site_profiler_data()) {
+    profiler_data->ResolveFunctionNames(info());
+    AllocationSiteProfiler::Get()->AddData(
+        isolate(), info()->ReleaseAllocationSiteProfilerData(), code);
+  }
+
   if (info()->trace_turbo_json()) {
     TurboJsonFile json_of(info(), std::ios_base::app);
 
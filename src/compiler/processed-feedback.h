@@ -13,6 +13,7 @@ namespace internal {
 namespace compiler {
 
 class BinaryOperationFeedback;
+class BranchCounterFeedback;
 class CallFeedback;
 class CompareOperationFeedback;
 class ElementAccessFeedback;
@@ -30,6 +31,7 @@ class ProcessedFeedback : public ZoneObject {
   enum Kind {
     kInsufficient,
     kBinaryOperation,
+    kBranchCounter,
     kCall,
     kCompareOperation,
     kElementAccess,
@@ -48,6 +50,7 @@ class ProcessedFeedback : public ZoneObject {
   bool IsInsufficient() const { return kind() == kInsufficient; }
 
   BinaryOperationFeedback const& AsBinaryOperation() const;
+  BranchCounterFeedback const& AsBranchCounter() const;
   CallFeedback const& AsCall() const;
   CompareOperationFeedback const& AsCompareOperation() const;
   ElementAccessFeedback const& AsElementAccess() const;
@@ -220,6 +223,8 @@ class SingleValueFeedback : public ProcessedFeedback {
       : ProcessedFeedback(K, slot_kind), value_(value) {
     DCHECK(
         (K == kBinaryOperation && slot_kind == FeedbackSlotKind::kBinaryOp) ||
+        (K == kBranchCounter &&
+         slot_kind == FeedbackSlotKind::kBranchCounter) ||
         (K == kCompareOperation && slot_kind == FeedbackSlotKind::kCompareOp) ||
         (K == kForIn && slot_kind == FeedbackSlotKind::kForIn) ||
         (K == kInstanceOf && slot_kind == FeedbackSlotKind::kInstanceOf) ||
@@ -274,6 +279,11 @@ class ForInFeedback
   using SingleValueFeedback::SingleValueFeedback;
 };
 
+class BranchCounterFeedback
+    : public SingleValueFeedback<int, ProcessedFeedback::kBranchCounter> {
+  using SingleValueFeedback::SingleValueFeedback;
+};
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -484,13 +484,9 @@ class CFGBuilder : public ZoneObject {
           profile_data->GetCounter(successor_blocks[1]->id().ToSize());
       // If a branch is visited a non-trivial number of times and substantially
       // more often than its alternative, then mark it as likely.
-      constexpr uint32_t kMinimumCount = 100000;
-      constexpr uint32_t kThresholdRatio = 4000;
-      if (block_zero_count > kMinimumCount &&
-          block_zero_count / kThresholdRatio > block_one_count) {
+      if (IsMuchHotterInProfile(block_zero_count, block_one_count)) {
         hint_from_profile = BranchHint::kTrue;
-      } else if (block_one_count > kMinimumCount &&
-                 block_one_count / kThresholdRatio > block_zero_count) {
+      } else if (IsMuchHotterInProfile(block_one_count, block_zero_count)) {
         hint_from_profile = BranchHint::kFalse;
       }
     }
@@ -564,6 +560,36 @@ class CFGBuilder : public ZoneObject {
         successor_blocks[index]->set_deferred(true);
       }
     }
+
+    // Defer the cases that were rarely taken during profiling compared to the
+    // hottest case, e.g. the unusual instance types in dispatching builtins.
+    if (const ProfileDataFromFile* profile_data = scheduler_->profile_data()) {
+      uint32_t max_count = 0;
+      for (size_t index = 0; index < successor_count; ++index) {
+        uint32_t count =
+            profile_data->GetCounter(successor_blocks[index]->id().ToSize());
+        if (count > max_count) max_count = count;
+      }
+      for (size_t index = 0; index < successor_count; ++index) {
+        uint32_t count =
+            profile_data->GetCounter(successor_blocks[index]->id().ToSize());
+        if (IsMuchHotterInProfile(max_count, count)) {
+          TRACE("Deferring switch case id:%d from profile\n",
+                successor_blocks[index]->id().ToInt());
+          successor_blocks[index]->set_deferred(true);
+        }
+      }
+    }
+  }
+
+  // Returns whether a block with the {hot_count} was visited a non-trivial
+  // number of times during profiling and substantially more often than an
+  // alternative block with the {cold_count}.
+  static bool IsMuchHotterInProfile(uint32_t hot_count, uint32_t cold_count) {
+    constexpr uint32_t kMinimumCount = 100000;
+    constexpr uint32_t kThresholdRatio = 4000;
+    return hot_count > kMinimumCount &&
+           hot_count / kThresholdRatio > cold_count;
   }
 
   void ConnectMerge(Node* merge) {
@@ -180,6 +180,7 @@ namespace compiler {
   V(GetIterator)                      \
   V(GetSuperConstructor)              \
   V(GetTemplateObject)                \
+  V(IncBranchCounter)                 \
   V(InvokeIntrinsic)                  \
   V(LdaConstant)                      \
   V(LdaContextSlot)                   \
@@ -1775,6 +1776,14 @@ void SerializerForBackgroundCompilation::VisitForInPrepare(
   ProcessForIn(slot);
 }
 
+void SerializerForBackgroundCompilation::VisitIncBranchCounter(
+    BytecodeArrayIterator* iterator) {
+  if (feedback_vector().is_null()) return;
+  FeedbackSlot slot = iterator->GetSlotOperand(0);
+  FeedbackSource source(feedback_vector(), slot);
+  broker()->ProcessFeedbackForBranchCounter(source);
+}
+
 void SerializerForBackgroundCompilation::ProcessCreateContext(
     interpreter::BytecodeArrayIterator* iterator, int scopeinfo_operand_index) {
   Handle<ScopeInfo> scope_info =
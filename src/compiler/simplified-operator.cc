@@ -188,8 +188,10 @@ const ObjectAccess& ObjectAccessOf(const Operator* op) {
 
 ExternalArrayType ExternalArrayTypeOf(const Operator* op) {
   DCHECK(op->opcode() == IrOpcode::kLoadTypedElement ||
+         op->opcode() == IrOpcode::kLoadTypedElementSimd128 ||
          op->opcode() == IrOpcode::kLoadDataViewElement ||
          op->opcode() == IrOpcode::kStoreTypedElement ||
+         op->opcode() == IrOpcode::kStoreTypedElementSimd128 ||
          op->opcode() == IrOpcode::kStoreDataViewElement);
   return OpParameter<ExternalArrayType>(op);
 }
@@ -1875,16 +1877,18 @@ const Operator* SimplifiedOperatorBuilder::SpeculativeNumberEqual(
   return nullptr;
 }
 
-#define ACCESS_OP_LIST(V)                                                \
-  V(LoadField, FieldAccess, Operator::kNoWrite, 1, 1, 1)                 \
-  V(StoreField, FieldAccess, Operator::kNoRead, 2, 1, 0)                 \
-  V(LoadElement, ElementAccess, Operator::kNoWrite, 2, 1, 1)             \
-  V(StoreElement, ElementAccess, Operator::kNoRead, 3, 1, 0)             \
-  V(LoadTypedElement, ExternalArrayType, Operator::kNoWrite, 4, 1, 1)    \
-  V(LoadFromObject, ObjectAccess, Operator::kNoWrite, 2, 1, 1)           \
-  V(StoreTypedElement, ExternalArrayType, Operator::kNoRead, 5, 1, 0)    \
-  V(StoreToObject, ObjectAccess, Operator::kNoRead, 3, 1, 0)             \
-  V(LoadDataViewElement, ExternalArrayType, Operator::kNoWrite, 4, 1, 1) \
+#define ACCESS_OP_LIST(V)                                                     \
+  V(LoadField, FieldAccess, Operator::kNoWrite, 1, 1, 1)                      \
+  V(StoreField, FieldAccess, Operator::kNoRead, 2, 1, 0)                      \
+  V(LoadElement, ElementAccess, Operator::kNoWrite, 2, 1, 1)                  \
+  V(StoreElement, ElementAccess, Operator::kNoRead, 3, 1, 0)                  \
+  V(LoadTypedElement, ExternalArrayType, Operator::kNoWrite, 4, 1, 1)         \
+  V(LoadTypedElementSimd128, ExternalArrayType, Operator::kNoWrite, 4, 1, 1)  \
+  V(LoadFromObject, ObjectAccess, Operator::kNoWrite, 2, 1, 1)                \
+  V(StoreTypedElement, ExternalArrayType, Operator::kNoRead, 5, 1, 0)         \
+  V(StoreTypedElementSimd128, ExternalArrayType, Operator::kNoRead, 5, 1, 0)  \
+  V(StoreToObject, ObjectAccess, Operator::kNoRead, 3, 1, 0)                  \
+  V(LoadDataViewElement, ExternalArrayType, Operator::kNoWrite, 4, 1, 1)      \
   V(StoreDataViewElement, ExternalArrayType, Operator::kNoRead, 5, 1, 0)
 
 #define ACCESS(Name, Type, properties, value_input_count, control_input_count, \
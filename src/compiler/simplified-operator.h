@@ -1033,6 +1033,14 @@ class V8_EXPORT_PRIVATE SimplifiedOperatorBuilder final
   // store-typed-element buffer, [base + external + index], value
   const Operator* StoreTypedElement(ExternalArrayType const&);
 
+  // load-typed-element-simd128 buffer, [base + external + index]
+  // Loads the 128 bits starting at the element at {index}.
+  const Operator* LoadTypedElementSimd128(ExternalArrayType const&);
+
+  // store-typed-element-simd128 buffer, [base + external + index], value
+  // Stores the 128 bits starting at the element at {index}.
+  const Operator* StoreTypedElementSimd128(ExternalArrayType const&);
+
   // store-data-view-element object, [base + index], value
   const Operator* StoreDataViewElement(ExternalArrayType const&);
 
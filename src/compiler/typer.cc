@@ -2189,6 +2189,10 @@ Type Typer::Visitor::TypeLoadTypedElement(Node* node) {
   UNREACHABLE();
 }
 
+Type Typer::Visitor::TypeLoadTypedElementSimd128(Node* node) {
+  UNREACHABLE();
+}
+
 Type Typer::Visitor::TypeLoadDataViewElement(Node* node) {
   switch (ExternalArrayTypeOf(node->op())) {
 #define TYPED_ARRAY_CASE(ElemType, type, TYPE, ctype) \
@@ -2224,6 +2228,10 @@ Type Typer::Visitor::TypeStoreSignedSmallElement(Node* node) { UNREACHABLE(); }
 
 Type Typer::Visitor::TypeStoreTypedElement(Node* node) { UNREACHABLE(); }
 
+Type Typer::Visitor::TypeStoreTypedElementSimd128(Node* node) {
+  UNREACHABLE();
+}
+
 Type Typer::Visitor::TypeStoreDataViewElement(Node* node) { UNREACHABLE(); }
 
 Type Typer::Visitor::TypeObjectIsArrayBufferView(Node* node) {
@@ -1556,6 +1556,7 @@ void Verifier::Visitor::Check(Node* node, const AllNodes& all) {
       CheckValueInputIs(node, 0, Type::Receiver());
       break;
     case IrOpcode::kLoadTypedElement:
+    case IrOpcode::kLoadTypedElementSimd128:
       break;
     case IrOpcode::kLoadDataViewElement:
       break;
@@ -1590,6 +1591,7 @@ void Verifier::Visitor::Check(Node* node, const AllNodes& all) {
       CheckNotTyped(node);
       break;
     case IrOpcode::kStoreTypedElement:
+    case IrOpcode::kStoreTypedElementSimd128:
       CheckNotTyped(node);
       break;
     case IrOpcode::kStoreDataViewElement:
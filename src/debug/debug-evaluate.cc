@@ -516,7 +516,8 @@ bool BytecodeHasNoSideEffect(interpreter::Bytecode bytecode) {
     case Bytecode::kToNumeric:
     case Bytecode::kToString:
     // Misc.
-    case Bytecode::kIncBlockCounter:  // Coverage counters.
+    case Bytecode::kIncBlockCounter:   // Coverage counters.
+    case Bytecode::kIncBranchCounter:  // Branch feedback.
     case Bytecode::kForInEnumerate:
     case Bytecode::kForInPrepare:
     case Bytecode::kForInContinue:
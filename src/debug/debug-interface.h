@@ -512,6 +512,35 @@ using RuntimeCallCounterCallback =
 void EnumerateRuntimeCallCounters(v8::Isolate* isolate,
                                   RuntimeCallCounterCallback callback);
 
+struct RuntimeCallCounterHistogram {
+  static const int kBucketCount = 10;
+
+  const char* name;
+  int64_t count;
+  base::TimeDelta time;
+  // Number of calls by own time. Bucket 0 counts calls shorter than 1us,
+  // bucket i calls of [4^(i-1), 4^i) microseconds, and the last bucket all
+  // longer calls. Only filled in for sampled runtime call stats.
+  int64_t buckets[kBucketCount];
+};
+using RuntimeCallHistogramCallback =
+    std::function<void(const RuntimeCallCounterHistogram& histogram)>;
+
+// Enables runtime call stats in all isolates, recording only every
+// |sampling_interval|-th runtime call entered while no other call is being
+// recorded, together with the calls nested in it. Counts and times then have
+// to be scaled by |sampling_interval| to estimate the totals. All calls are
+// recorded while runtime call stats are also enabled by flags or tracing.
+void StartSampledRuntimeCallStats(unsigned sampling_interval);
+void StopSampledRuntimeCallStats();
+
+// Reports all counters of the isolate's main thread table that recorded calls
+// since the last call and resets them. Calls made on worker threads are not
+// included, since their tables are in use while they run. Must be called on
+// the isolate's thread.
+void TakeRuntimeCallHistograms(v8::Isolate* isolate,
+                               RuntimeCallHistogramCallback callback);
+
 enum class EvaluateGlobalMode {
   kDefault,
   kDisableBreaks,
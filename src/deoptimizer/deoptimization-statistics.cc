@@ -0,0 +1,83 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/deoptimizer/deoptimization-statistics.h"
+
+#include <algorithm>
+
+#include "src/objects/script.h"
+#include "src/objects/shared-function-info-inl.h"
+
+namespace v8 {
+namespace internal {
+
+// static
+bool DeoptimizationStatistics::GetKey(SharedFunctionInfo shared,
+                                      uint64_t* key) {
+  if (!shared.script().IsScript()) return false;
+  int script_id = Script::cast(shared.script()).id();
+  *key = (static_cast<uint64_t>(static_cast<uint32_t>(script_id)) << 32) |
+         static_cast<uint32_t>(shared.function_literal_id());
+  return true;
+}
+
+void DeoptimizationStatistics::RecordDeoptimization(SharedFunctionInfo shared,
+                                                    DeoptimizeReason reason,
+                                                    int script_id,
+                                                    int position) {
+  uint64_t key;
+  if (!GetKey(shared, &key)) return;
+  auto it = functions_.find(key);
+  if (it == functions_.end()) {
+    if (functions_.size() >= kMaxFunctions) return;
+    FunctionStatistics function;
+    function.name = shared.DebugName().ToCString().get();
+    function.script_id = Script::cast(shared.script()).id();
+    function.position = shared.StartPosition();
+    function.reoptimization_count = 0;
+    it = functions_.emplace(key, std::move(function)).first;
+  }
+
+  std::vector<ReasonStatistics>& reasons = it->second.reasons;
+  auto reason_it = std::find_if(
+      reasons.begin(), reasons.end(),
+      [=](const ReasonStatistics& entry) { return entry.reason == reason; });
+  if (reason_it == reasons.end()) {
+    reasons.push_back({reason, 0, -1, -1});
+    reason_it = reasons.end() - 1;
+  }
+  reason_it->count++;
+  reason_it->last_script_id = script_id;
+  reason_it->last_position = position;
+}
+
+void DeoptimizationStatistics::RecordOptimization(SharedFunctionInfo shared) {
+  if (functions_.empty()) return;
+  uint64_t key;
+  if (!GetKey(shared, &key)) return;
+  auto it = functions_.find(key);
+  if (it != functions_.end()) it->second.reoptimization_count++;
+}
+
+void DeoptimizationStatistics::Visit(
+    v8::DeoptimizationStatisticsVisitor* visitor) const {
+  for (const auto& pair : functions_) {
+    const FunctionStatistics& function = pair.second;
+    for (const ReasonStatistics& reason : function.reasons) {
+      v8::DeoptimizationStatisticsEntry entry;
+      entry.function_name = function.name.c_str();
+      entry.script_id = function.script_id;
+      entry.function_position = function.position;
+      entry.reason = DeoptimizeReasonToString(reason.reason);
+      entry.count = reason.count;
+      entry.last_script_id = reason.last_script_id;
+      entry.last_position = reason.last_position;
+      entry.reoptimization_count = function.reoptimization_count;
+      visitor->VisitEntry(entry);
+    }
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,77 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_DEOPTIMIZER_DEOPTIMIZATION_STATISTICS_H_
+#define V8_DEOPTIMIZER_DEOPTIMIZATION_STATISTICS_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "include/v8.h"
+#include "src/base/macros.h"
+#include "src/deoptimizer/deoptimize-reason.h"
+
+namespace v8 {
+namespace internal {
+
+class SharedFunctionInfo;
+
+// Per-isolate table of deoptimizations by function and reason, exposed
+// through v8::Isolate::GetDeoptimizationStatistics(). The Deoptimizer records
+// every deoptimization and the compiler every optimization of a function
+// that has been deoptimized before, which is what makes deoptimization loops
+// stand out.
+//
+// Functions are identified by script id and function literal id instead of
+// their SharedFunctionInfo, so the table holds no references into the heap.
+// Functions without a script are not recorded. Only used on the main thread.
+class V8_EXPORT_PRIVATE DeoptimizationStatistics {
+ public:
+  // Deoptimizations of further functions are dropped once this many
+  // functions are tracked, to bound the memory used by the table.
+  static const size_t kMaxFunctions = 8 * 1024;
+
+  DeoptimizationStatistics() = default;
+
+  // |script_id| and |position| locate the deoptimization point, which may lie
+  // in a function inlined into |shared|. Both are -1 if unknown.
+  void RecordDeoptimization(SharedFunctionInfo shared, DeoptimizeReason reason,
+                            int script_id, int position);
+  // Counts a reoptimization if |shared| has been deoptimized before.
+  void RecordOptimization(SharedFunctionInfo shared);
+
+  // Reports one entry per function and reason.
+  void Visit(v8::DeoptimizationStatisticsVisitor* visitor) const;
+  void Reset() { functions_.clear(); }
+
+  size_t function_count() const { return functions_.size(); }
+
+ private:
+  struct ReasonStatistics {
+    DeoptimizeReason reason;
+    size_t count;
+    int last_script_id;
+    int last_position;
+  };
+
+  struct FunctionStatistics {
+    std::string name;
+    int script_id;
+    int position;
+    size_t reoptimization_count;
+    std::vector<ReasonStatistics> reasons;
+  };
+
+  static bool GetKey(SharedFunctionInfo shared, uint64_t* key);
+
+  std::unordered_map<uint64_t, FunctionStatistics> functions_;
+
+  DISALLOW_COPY_AND_ASSIGN(DeoptimizationStatistics);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_DEOPTIMIZER_DEOPTIMIZATION_STATISTICS_H_
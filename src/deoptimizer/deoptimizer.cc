@@ -13,6 +13,7 @@
 #include "src/codegen/macro-assembler.h"
 #include "src/codegen/register-configuration.h"
 #include "src/common/assert-scope.h"
+#include "src/deoptimizer/deoptimization-statistics.h"
 #include "src/diagnostics/disasm.h"
 #include "src/execution/frames-inl.h"
 #include "src/execution/pointer-authentication.h"
@@ -23,6 +24,7 @@
 #include "src/interpreter/interpreter.h"
 #include "src/logging/counters.h"
 #include "src/logging/log.h"
+#include "src/logging/metrics.h"
 #include "src/objects/debug-objects-inl.h"
 #include "src/objects/heap-number-inl.h"
 #include "src/objects/smi.h"
@@ -564,6 +566,16 @@ Deoptimizer::Deoptimizer(Isolate* isolate, JSFunction function,
             CodeDeoptEvent(handle(compiled_code_, isolate_), kind, from_,
                            fp_to_sp_delta_, should_reuse_code()));
   }
+  {
+    DeoptInfo info = GetDeoptInfo(compiled_code_, from_);
+    int script_id, position;
+    GetDeoptScriptPosition(info, &script_id, &position);
+    isolate->deoptimization_statistics()->RecordDeoptimization(
+        function.shared(), info.deopt_reason, script_id, position);
+    if (isolate->metrics_recorder()->HasEmbedderRecorder()) {
+      RecordMetricsEvent(info, script_id, position);
+    }
+  }
   unsigned size = ComputeInputFrameSize();
   const int parameter_count =
       InternalFormalParameterCountWithReceiver(function.shared());
@@ -746,6 +758,40 @@ void Deoptimizer::TraceDeoptBegin(int optimization_id, int node_id) {
   }
 }
 
+void Deoptimizer::GetDeoptScriptPosition(const DeoptInfo& info,
+                                         int* script_id, int* position) {
+  *script_id = -1;
+  *position = -1;
+  if (!info.position.IsKnown()) return;
+  // The position is relative to the script of the function the
+  // deoptimization point has been inlined from, if any.
+  SharedFunctionInfo shared = function_.shared();
+  if (info.position.isInlined()) {
+    DeoptimizationData data =
+        DeoptimizationData::cast(compiled_code_.deoptimization_data());
+    InliningPosition inlining =
+        data.InliningPositions().get(info.position.InliningId());
+    shared = data.GetInlinedFunction(inlining.inlined_function_id);
+  }
+  if (shared.script().IsScript()) {
+    *script_id = Script::cast(shared.script()).id();
+    *position = info.position.ScriptOffset();
+  }
+}
+
+void Deoptimizer::RecordMetricsEvent(const DeoptInfo& info, int script_id,
+                                     int position) {
+  v8::metrics::Deoptimization event;
+  event.kind = MessageFor(deopt_kind_, should_reuse_code());
+  event.reason = DeoptimizeReasonToString(info.deopt_reason);
+  event.script_id = script_id;
+  event.position = position;
+  HandleScope scope(isolate_);
+  Handle<NativeContext> native_context(function_.native_context(), isolate_);
+  isolate_->metrics_recorder()->AddMainThreadEvent(
+      event, isolate_->GetOrRegisterRecorderContextId(native_context));
+}
+
 void Deoptimizer::TraceDeoptEnd(double deopt_duration) {
   DCHECK(verbose_tracing_enabled());
   PrintF(trace_scope()->file(), "[bailout end. took %0.3f ms]\n",
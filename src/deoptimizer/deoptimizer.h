@@ -607,6 +607,13 @@ class Deoptimizer : public Malloced {
   static void TraceDeoptAll(Isolate* isolate);
   static void TraceDeoptMarked(Isolate* isolate);
 
+  // Computes the script and the offset in the script of the deoptimization
+  // point, resolved through inlining. Both are -1 if unknown.
+  void GetDeoptScriptPosition(const DeoptInfo& info, int* script_id,
+                              int* position);
+  // Reports the deoptimization to the embedder's metrics recorder.
+  void RecordMetricsEvent(const DeoptInfo& info, int script_id, int position);
+
   Isolate* isolate_;
   JSFunction function_;
   Code compiled_code_;
@@ -0,0 +1,168 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/diagnostics/allocation-site-profiler.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "src/base/lazy-instance.h"
+#include "src/codegen/optimized-compilation-info.h"
+#include "src/execution/isolate.h"
+#include "src/flags/flags.h"
+#include "src/handles/global-handles.h"
+#include "src/objects/objects-inl.h"
+#include "src/objects/shared-function-info-inl.h"
+
+namespace v8 {
+namespace internal {
+
+DEFINE_LAZY_LEAKY_OBJECT_GETTER(AllocationSiteProfiler,
+                                AllocationSiteProfiler::Get)
+
+AllocationSiteProfilerData::AllocationSiteProfilerData(
+    const char* function_name)
+    : function_name_(function_name) {}
+
+AllocationSiteProfilerData::~AllocationSiteProfilerData() {
+  if (!code_.is_null()) GlobalHandles::Destroy(code_.location());
+}
+
+AllocationSiteProfilerData::Site* AllocationSiteProfilerData::GetOrCreateSite(
+    SourcePosition position) {
+  auto it = sites_by_position_.find(position.raw());
+  if (it != sites_by_position_.end()) return it->second;
+  sites_.emplace_back();
+  Site* site = &sites_.back();
+  site->counters.countdown = AllocationSiteProfiler::SamplingInterval();
+  site->position = position;
+  sites_by_position_.emplace(position.raw(), site);
+  return site;
+}
+
+void AllocationSiteProfilerData::ResolveFunctionNames(
+    OptimizedCompilationInfo* info) {
+  for (Site& site : sites_) {
+    int inlining_id = site.position.InliningId();
+    Handle<SharedFunctionInfo> shared =
+        inlining_id == SourcePosition::kNotInlined
+            ? info->shared_info()
+            : info->inlined_functions()[inlining_id].shared_info;
+    site.function_name = shared->DebugName().ToCString().get();
+  }
+}
+
+void AllocationSiteProfilerData::ResetCounts() {
+  for (Site& site : sites_) {
+    site.counters = Counters();
+    site.counters.countdown = AllocationSiteProfiler::SamplingInterval();
+  }
+}
+
+// static
+uintptr_t AllocationSiteProfiler::SamplingInterval() {
+  return static_cast<uintptr_t>(
+      std::max(FLAG_turbo_allocation_profiling_interval, 1));
+}
+
+void AllocationSiteProfiler::AddData(
+    Isolate* isolate, std::unique_ptr<AllocationSiteProfilerData> data,
+    Handle<Code> code) {
+  data->code_ = isolate->global_handles()->Create(*code);
+  GlobalHandles::MakeWeak(data->code_.location(), data.get(),
+                          &OnCodeCollected, v8::WeakCallbackType::kParameter);
+  base::MutexGuard lock(&data_list_mutex_);
+  data_list_.push_back(std::move(data));
+}
+
+// static
+void AllocationSiteProfiler::OnCodeCollected(
+    const v8::WeakCallbackInfo<void>& info) {
+  AllocationSiteProfilerData* data =
+      reinterpret_cast<AllocationSiteProfilerData*>(info.GetParameter());
+  GlobalHandles::Destroy(data->code_.location());
+  data->code_ = Handle<Code>::null();
+  Get()->RemoveData(data);
+}
+
+void AllocationSiteProfiler::RemoveData(AllocationSiteProfilerData* data) {
+  base::MutexGuard lock(&data_list_mutex_);
+  for (const AllocationSiteProfilerData::Site& site : data->sites()) {
+    if (site.counters.count == 0) continue;
+    Counters& counters = collected_sites_[SiteName(*data, site)];
+    counters.count += site.counters.count;
+    counters.bytes += site.counters.bytes;
+  }
+  data_list_.remove_if(
+      [=](const std::unique_ptr<AllocationSiteProfilerData>& entry) {
+        return entry.get() == data;
+      });
+}
+
+// static
+std::string AllocationSiteProfiler::SiteName(
+    const AllocationSiteProfilerData& data,
+    const AllocationSiteProfilerData::Site& site) {
+  std::ostringstream os;
+  os << (site.function_name.empty() ? data.function_name()
+                                    : site.function_name);
+  if (site.position.IsKnown()) {
+    os << ":" << site.position.ScriptOffset();
+  }
+  if (site.position.isInlined()) {
+    os << " (inlined into " << data.function_name() << ")";
+  }
+  return os.str();
+}
+
+void AllocationSiteProfiler::ResetCounts() {
+  base::MutexGuard lock(&data_list_mutex_);
+  for (const auto& data : data_list_) {
+    data->ResetCounts();
+  }
+  collected_sites_.clear();
+}
+
+bool AllocationSiteProfiler::HasData() {
+  base::MutexGuard lock(&data_list_mutex_);
+  return !data_list_.empty() || !collected_sites_.empty();
+}
+
+void AllocationSiteProfiler::Print(std::ostream& os) {
+  using SiteAndCounters = std::pair<std::string, Counters>;
+  std::vector<SiteAndCounters> sites;
+  {
+    base::MutexGuard lock(&data_list_mutex_);
+    std::map<std::string, Counters> counters_by_site = collected_sites_;
+    for (const auto& data : data_list_) {
+      for (const AllocationSiteProfilerData::Site& site : data->sites()) {
+        if (site.counters.count == 0) continue;
+        Counters& counters = counters_by_site[SiteName(*data, site)];
+        counters.count += site.counters.count;
+        counters.bytes += site.counters.bytes;
+      }
+    }
+    sites.assign(counters_by_site.begin(), counters_by_site.end());
+  }
+  std::sort(sites.begin(), sites.end(),
+            [](const SiteAndCounters& a, const SiteAndCounters& b) {
+              return a.second.bytes > b.second.bytes;
+            });
+
+  os << "---- Start Allocation Site Profiling Data ----" << std::endl;
+  os << "sampled every " << SamplingInterval() << " allocations" << std::endl;
+  os << "       bytes        count  site" << std::endl;
+  for (const SiteAndCounters& site : sites) {
+    os << std::setw(12) << site.second.bytes << " " << std::setw(12)
+       << site.second.count << "  " << site.first << std::endl;
+  }
+  os << "---- End Allocation Site Profiling Data ----" << std::endl;
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,131 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_DIAGNOSTICS_ALLOCATION_SITE_PROFILER_H_
+#define V8_DIAGNOSTICS_ALLOCATION_SITE_PROFILER_H_
+
+#include <deque>
+#include <iosfwd>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "src/base/macros.h"
+#include "src/base/platform/mutex.h"
+#include "src/codegen/source-position.h"
+#include "src/common/globals.h"
+#include "src/handles/handles.h"
+
+namespace v8 {
+namespace internal {
+
+class Code;
+class Isolate;
+class OptimizedCompilationInfo;
+
+// The inline allocation sites of a single optimized function. With
+// --turbo-allocation-profiling, the MemoryOptimizer emits a countdown of the
+// site in front of every inline allocation, and only updates the counters of
+// the site when the countdown expires. So the fast path of the allocation is
+// left intact and the profiled code keeps allocating in the same way as
+// without profiling.
+class AllocationSiteProfilerData {
+ public:
+  // Updated by optimized code.
+  struct Counters {
+    // Allocations until the next sample, see SamplingInterval().
+    uintptr_t countdown = 0;
+    // Estimated from the samples, i.e. each sample counts the sampling
+    // interval times.
+    uintptr_t count = 0;
+    uintptr_t bytes = 0;
+  };
+
+  struct Site {
+    Counters counters;
+    SourcePosition position = SourcePosition::Unknown();
+    // Name of the (possibly inlined) function containing the site, only set
+    // once the code has been finalized.
+    std::string function_name;
+  };
+
+  explicit AllocationSiteProfilerData(const char* function_name);
+  ~AllocationSiteProfilerData();
+
+  // Returns the site for the given position, creating it if necessary. Sites
+  // never move, so the addresses of their counters can be embedded in code.
+  // Safe to call on a background thread.
+  Site* GetOrCreateSite(SourcePosition position);
+
+  // Resolves the inlining ids of the sites to function names. This must
+  // happen on the main thread during finalization of the compilation.
+  void ResolveFunctionNames(OptimizedCompilationInfo* info);
+
+  const std::string& function_name() const { return function_name_; }
+  const std::deque<Site>& sites() const { return sites_; }
+
+ private:
+  friend class AllocationSiteProfiler;
+
+  void ResetCounts();
+
+  std::string function_name_;
+  std::deque<Site> sites_;
+  std::map<int64_t, Site*> sites_by_position_;
+  // Weak handle to the code that updates the counters.
+  Handle<Code> code_;
+
+  DISALLOW_COPY_AND_ASSIGN(AllocationSiteProfilerData);
+};
+
+class AllocationSiteProfiler {
+ public:
+  using DataList = std::list<std::unique_ptr<AllocationSiteProfilerData>>;
+
+  AllocationSiteProfiler() = default;
+  ~AllocationSiteProfiler() = default;
+
+  V8_EXPORT_PRIVATE static AllocationSiteProfiler* Get();
+
+  // Every how many allocations a site is sampled
+  // (--turbo-allocation-profiling-interval).
+  static uintptr_t SamplingInterval();
+
+  // Takes ownership of the {data} of the finalized {code}. The data is freed
+  // once the code is collected, and the counts of its sites are kept in a
+  // summary.
+  void AddData(Isolate* isolate,
+               std::unique_ptr<AllocationSiteProfilerData> data,
+               Handle<Code> code);
+  V8_EXPORT_PRIVATE void ResetCounts();
+  V8_EXPORT_PRIVATE bool HasData();
+  // Prints the sites that allocated, ordered by the number of bytes. Sites
+  // with the same name and position, e.g. from several compilations of the
+  // same function, are printed together.
+  V8_EXPORT_PRIVATE void Print(std::ostream& os);
+
+  // The data of the code that is still alive.
+  const DataList* data_list() { return &data_list_; }
+
+ private:
+  using Counters = AllocationSiteProfilerData::Counters;
+
+  static void OnCodeCollected(const v8::WeakCallbackInfo<void>& info);
+  void RemoveData(AllocationSiteProfilerData* data);
+  static std::string SiteName(const AllocationSiteProfilerData& data,
+                              const AllocationSiteProfilerData::Site& site);
+
+  DataList data_list_;
+  // The counts of the sites of collected code, indexed by SiteName().
+  std::map<std::string, Counters> collected_sites_;
+  base::Mutex data_list_mutex_;
+
+  DISALLOW_COPY_AND_ASSIGN(AllocationSiteProfiler);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_DIAGNOSTICS_ALLOCATION_SITE_PROFILER_H_
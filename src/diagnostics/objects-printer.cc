@@ -1000,6 +1000,10 @@ void FeedbackNexus::Print(std::ostream& os) {  // NOLINT
       os << "ForIn:" << GetForInFeedback();
       break;
     }
+    case FeedbackSlotKind::kBranchCounter: {
+      os << "BranchCounter:" << GetBranchCount();
+      break;
+    }
     case FeedbackSlotKind::kLiteral:
     case FeedbackSlotKind::kTypeProfile:
       break;
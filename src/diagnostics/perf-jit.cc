@@ -33,15 +33,19 @@
 #include <fcntl.h>
 #include <sys/mman.h>
 #include <unistd.h>
+
 #include <memory>
+#include <sstream>
 
+#include "src/base/platform/platform.h"
+#include "src/base/platform/semaphore.h"
 #include "src/codegen/assembler.h"
 #include "src/codegen/source-position-table.h"
 #include "src/diagnostics/eh-frame.h"
 #include "src/objects/objects-inl.h"
 #include "src/objects/shared-function-info.h"
 #include "src/snapshot/embedded/embedded-data.h"
-#include "src/utils/ostreams.h"
+#include "src/utils/lock-free-queue-inl.h"
 #include "src/wasm/wasm-code-manager.h"
 
 namespace v8 {
@@ -109,12 +113,68 @@ const char PerfJitLogger::kFilenameFormatString[] = "./jit-%d.dump";
 // Extra padding for the PID in the filename
 const int PerfJitLogger::kFilenameBufferPadding = 16;
 
+const size_t PerfJitLogger::kMaxCachedPositions;
+
+// Writes the records handed over by the loggers to the jitdump file. Records
+// that pile up while a write is in progress are written together.
+class PerfJitLogger::WriterThread : public base::Thread {
+ public:
+  explicit WriterThread(FILE* output)
+      : Thread(Options("v8:PerfJitWriter")),
+        output_(output),
+        records_available_(0) {}
+
+  void Run() override {
+    while (true) {
+      records_available_.Wait();
+      WritePendingRecords();
+      if (stopping_.load(std::memory_order_acquire)) return;
+    }
+  }
+
+  void Enqueue(std::vector<uint8_t>* records) {
+    records_.Enqueue(records);
+    records_available_.Signal();
+  }
+
+  // Must only be called once no logger enqueues records anymore.
+  void Stop() {
+    stopping_.store(true, std::memory_order_release);
+    records_available_.Signal();
+    Join();
+    // The writer thread is gone, this thread is now the only consumer.
+    WritePendingRecords();
+  }
+
+ private:
+  void WritePendingRecords() {
+    std::vector<uint8_t>* records;
+    bool written = false;
+    while (records_.Dequeue(&records)) {
+      size_t rv = fwrite(records->data(), 1, records->size(), output_);
+      DCHECK_EQ(records->size(), rv);
+      USE(rv);
+      delete records;
+      written = true;
+    }
+    // Flush after every batch so that the file is complete for the code
+    // created so far, even if the process never shuts down.
+    if (written) fflush(output_);
+  }
+
+  FILE* const output_;
+  LockFreeQueue<std::vector<uint8_t>*> records_;
+  base::Semaphore records_available_;
+  std::atomic<bool> stopping_{false};
+};
+
 base::LazyRecursiveMutex PerfJitLogger::file_mutex_;
 // The following static variables are protected by PerfJitLogger::file_mutex_.
 uint64_t PerfJitLogger::reference_count_ = 0;
 void* PerfJitLogger::marker_address_ = nullptr;
-uint64_t PerfJitLogger::code_index_ = 0;
 FILE* PerfJitLogger::perf_output_handle_ = nullptr;
+PerfJitLogger::WriterThread* PerfJitLogger::writer_thread_ = nullptr;
+std::atomic<uint64_t> PerfJitLogger::code_index_{0};
 
 void PerfJitLogger::OpenJitDumpFile() {
   // Open the perf JIT dump file.
@@ -141,10 +201,16 @@ void PerfJitLogger::OpenJitDumpFile() {
   if (perf_output_handle_ == nullptr) return;
 
   setvbuf(perf_output_handle_, nullptr, _IOFBF, kLogBufferSize);
+
+  writer_thread_ = new WriterThread(perf_output_handle_);
+  CHECK(writer_thread_->Start());
 }
 
 void PerfJitLogger::CloseJitDumpFile() {
   if (perf_output_handle_ == nullptr) return;
+  writer_thread_->Stop();
+  delete writer_thread_;
+  writer_thread_ = nullptr;
   fclose(perf_output_handle_);
   perf_output_handle_ = nullptr;
 }
@@ -177,6 +243,7 @@ PerfJitLogger::PerfJitLogger(Isolate* isolate) : CodeEventLogger(isolate) {
     OpenJitDumpFile();
     if (perf_output_handle_ == nullptr) return;
     LogWriteHeader();
+    CommitRecords();
   }
 }
 
@@ -199,6 +266,19 @@ uint64_t PerfJitLogger::GetTimestamp() {
   return (ts.tv_sec * kNsecPerSec) + ts.tv_nsec;
 }
 
+namespace {
+
+// The copies of the interpreter entry trampoline installed for
+// --interpreted-frames-native-stack belong to a single function.
+bool IsInterpreterTrampolineCopy(Handle<AbstractCode> abstract_code,
+                                 MaybeHandle<SharedFunctionInfo> maybe_shared) {
+  return abstract_code->IsCode() &&
+         abstract_code->GetCode().is_interpreter_trampoline_builtin() &&
+         !maybe_shared.is_null();
+}
+
+}  // namespace
+
 void PerfJitLogger::LogRecordedBuffer(
     Handle<AbstractCode> abstract_code,
     MaybeHandle<SharedFunctionInfo> maybe_shared, const char* name,
@@ -207,13 +287,12 @@ void PerfJitLogger::LogRecordedBuffer(
       (abstract_code->kind() != CodeKind::INTERPRETED_FUNCTION &&
        abstract_code->kind() != CodeKind::TURBOFAN &&
        abstract_code->kind() != CodeKind::NATIVE_CONTEXT_INDEPENDENT &&
-       abstract_code->kind() != CodeKind::TURBOPROP)) {
+       abstract_code->kind() != CodeKind::TURBOPROP) &&
+      !IsInterpreterTrampolineCopy(abstract_code, maybe_shared)) {
     return;
   }
 
-  base::LockGuard<base::RecursiveMutex> guard_file(file_mutex_.Pointer());
-
-  if (perf_output_handle_ == nullptr) return;
+  if (!HasOutputFile()) return;
 
   // We only support non-interpreted functions.
   if (!abstract_code->IsCode()) return;
@@ -222,7 +301,7 @@ void PerfJitLogger::LogRecordedBuffer(
 
   // Debug info has to be emitted first.
   Handle<SharedFunctionInfo> shared;
-  if (FLAG_perf_prof && !maybe_shared.ToHandle(&shared)) {
+  if (FLAG_perf_prof && maybe_shared.ToHandle(&shared)) {
     // TODO(herhut): This currently breaks for js2wasm/wasm2js functions.
     if (code->kind() != CodeKind::JS_TO_WASM_FUNCTION &&
         code->kind() != CodeKind::WASM_TO_JS_FUNCTION) {
@@ -241,13 +320,12 @@ void PerfJitLogger::LogRecordedBuffer(
   if (FLAG_perf_prof_unwinding_info) LogWriteUnwindingInfo(*code);
 
   WriteJitCodeLoadEntry(code_pointer, code_size, code_name, length);
+  CommitRecords();
 }
 
 void PerfJitLogger::LogRecordedBuffer(const wasm::WasmCode* code,
                                       const char* name, int length) {
-  base::LockGuard<base::RecursiveMutex> guard_file(file_mutex_.Pointer());
-
-  if (perf_output_handle_ == nullptr) return;
+  if (!HasOutputFile()) return;
 
   if (FLAG_perf_prof_annotate_wasm) {
     LogWriteDebugInfo(code);
@@ -255,6 +333,7 @@ void PerfJitLogger::LogRecordedBuffer(const wasm::WasmCode* code,
 
   WriteJitCodeLoadEntry(code->instructions().begin(),
                         code->instructions().length(), name, length);
+  CommitRecords();
 }
 
 void PerfJitLogger::WriteJitCodeLoadEntry(const uint8_t* code_pointer,
@@ -272,9 +351,7 @@ void PerfJitLogger::WriteJitCodeLoadEntry(const uint8_t* code_pointer,
   code_load.vma_ = reinterpret_cast<uint64_t>(code_pointer);
   code_load.code_address_ = reinterpret_cast<uint64_t>(code_pointer);
   code_load.code_size_ = code_size;
-  code_load.code_id_ = code_index_;
-
-  code_index_++;
+  code_load.code_id_ = code_index_.fetch_add(1, std::memory_order_relaxed);
 
   LogWriteBytes(reinterpret_cast<const char*>(&code_load), sizeof(code_load));
   LogWriteBytes(name, name_length);
@@ -285,111 +362,127 @@ void PerfJitLogger::WriteJitCodeLoadEntry(const uint8_t* code_pointer,
 namespace {
 
 constexpr char kUnknownScriptNameString[] = "<unknown>";
-constexpr size_t kUnknownScriptNameStringLen =
-    arraysize(kUnknownScriptNameString) - 1;
 
-size_t GetScriptNameLength(const SourcePositionInfo& info) {
-  if (!info.script.is_null()) {
-    Object name_or_url = info.script->GetNameOrSourceURL();
+}  // namespace
+
+const std::string* PerfJitLogger::GetScriptName(Object maybe_script) {
+  int script_id = maybe_script.IsScript() ? Script::cast(maybe_script).id()
+                                          : v8::UnboundScript::kNoScriptId;
+  auto it = script_names_.find(script_id);
+  if (it != script_names_.end()) return &it->second;
+  std::string name = kUnknownScriptNameString;
+  if (maybe_script.IsScript()) {
+    Object name_or_url = Script::cast(maybe_script).GetNameOrSourceURL();
     if (name_or_url.IsString()) {
-      String str = String::cast(name_or_url);
-      if (str.IsOneByteRepresentation()) return str.length();
       int length;
-      str.ToCString(DISALLOW_NULLS, FAST_STRING_TRAVERSAL, &length);
-      return static_cast<size_t>(length);
+      std::unique_ptr<char[]> str =
+          String::cast(name_or_url)
+              .ToCString(DISALLOW_NULLS, FAST_STRING_TRAVERSAL, &length);
+      name.assign(str.get(), length);
     }
   }
-  return kUnknownScriptNameStringLen;
+  return &script_names_.emplace(script_id, std::move(name)).first->second;
 }
 
-Vector<const char> GetScriptName(const SourcePositionInfo& info,
-                                 std::unique_ptr<char[]>* storage,
-                                 const DisallowHeapAllocation& no_gc) {
-  if (!info.script.is_null()) {
-    Object name_or_url = info.script->GetNameOrSourceURL();
-    if (name_or_url.IsSeqOneByteString()) {
-      SeqOneByteString str = SeqOneByteString::cast(name_or_url);
-      return {reinterpret_cast<char*>(str.GetChars(no_gc)),
-              static_cast<size_t>(str.length())};
-    } else if (name_or_url.IsString()) {
-      int length;
-      *storage = String::cast(name_or_url)
-                     .ToCString(DISALLOW_NULLS, FAST_STRING_TRAVERSAL, &length);
-      return {storage->get(), static_cast<size_t>(length)};
-    }
+PerfJitLogger::DebugPosition PerfJitLogger::GetDebugPosition(
+    Handle<SharedFunctionInfo> shared, SourcePosition pos) {
+  if (!shared->script().IsScript()) {
+    return {-1, -1, GetScriptName(shared->script())};
   }
-  return {kUnknownScriptNameString, kUnknownScriptNameStringLen};
-}
-
-SourcePositionInfo GetSourcePositionInfo(Handle<Code> code,
-                                         Handle<SharedFunctionInfo> function,
-                                         SourcePosition pos) {
-  if (code->is_turbofanned()) {
-    DisallowHeapAllocation disallow;
-    return pos.InliningStack(code)[0];
-  } else {
-    return SourcePositionInfo(pos, function);
+  Handle<Script> script(Script::cast(shared->script()), isolate_);
+  uint64_t key = (static_cast<uint64_t>(script->id()) << 32) |
+                 static_cast<uint32_t>(pos.ScriptOffset());
+  auto it = positions_.find(key);
+  if (it != positions_.end()) return it->second;
+
+  DebugPosition position = {-1, -1, GetScriptName(*script)};
+  Script::PositionInfo info;
+  if (Script::GetPositionInfo(script, pos.ScriptOffset(), &info,
+                              Script::WITH_OFFSET)) {
+    position.line = info.line;
+    position.column = info.column;
   }
+  positions_.emplace(key, position);
+  return position;
 }
 
-}  // namespace
-
 void PerfJitLogger::LogWriteDebugInfo(Handle<Code> code,
                                       Handle<SharedFunctionInfo> shared) {
-  // Compute the entry count and get the name of the script.
-  uint32_t entry_count = 0;
-  for (SourcePositionTableIterator iterator(code->SourcePositionTable());
-       !iterator.done(); iterator.Advance()) {
-    entry_count++;
-  }
-  if (entry_count == 0) return;
   // The WasmToJS wrapper stubs have source position entries.
   if (!shared->HasSourceCode()) return;
-  Handle<Script> script(Script::cast(shared->script()), isolate_);
 
+  // Trim the caches between code objects, the entries collected below point
+  // into them.
+  if (positions_.size() >= kMaxCachedPositions) {
+    positions_.clear();
+    script_names_.clear();
+  }
+
+  // Resolving positions may allocate, so only code offsets are collected.
+  struct Entry {
+    int code_offset;
+    DebugPosition position;
+  };
+  std::vector<Entry> entries;
+  if (code->is_interpreter_trampoline_builtin()) {
+    // The trampoline has no source positions of its own. Attribute all of it
+    // to the start of the function it was copied for.
+    SourcePosition pos(shared->StartPosition());
+    entries.push_back({0, GetDebugPosition(shared, pos)});
+  } else {
+    Handle<ByteArray> source_positions(code->SourcePositionTable(), isolate_);
+    for (SourcePositionTableIterator iterator(source_positions);
+         !iterator.done(); iterator.Advance()) {
+      SourcePosition pos = iterator.source_position();
+      // Attribute inlined code to the innermost inlined function.
+      Handle<SharedFunctionInfo> function = shared;
+      if (pos.isInlined()) {
+        DeoptimizationData deopt_data =
+            DeoptimizationData::cast(code->deoptimization_data());
+        InliningPosition inlining =
+            deopt_data.InliningPositions().get(pos.InliningId());
+        function = handle(
+            deopt_data.GetInlinedFunction(inlining.inlined_function_id),
+            isolate_);
+      }
+      entries.push_back(
+          {iterator.code_offset(), GetDebugPosition(function, pos)});
+    }
+  }
+  if (entries.empty()) return;
+
+  Address code_start = code->InstructionStart();
   PerfJitCodeDebugInfo debug_info;
 
   debug_info.event_ = PerfJitCodeLoad::kDebugInfo;
   debug_info.time_stamp_ = GetTimestamp();
-  debug_info.address_ = code->InstructionStart();
-  debug_info.entry_count_ = entry_count;
+  debug_info.address_ = code_start;
+  debug_info.entry_count_ = entries.size();
 
   uint32_t size = sizeof(debug_info);
   // Add the sizes of fixed parts of entries.
-  size += entry_count * sizeof(PerfJitDebugEntry);
+  size += entries.size() * sizeof(PerfJitDebugEntry);
   // Add the size of the name after each entry.
-
-  for (SourcePositionTableIterator iterator(code->SourcePositionTable());
-       !iterator.done(); iterator.Advance()) {
-    SourcePositionInfo info(
-        GetSourcePositionInfo(code, shared, iterator.source_position()));
-    size += GetScriptNameLength(info) + 1;
+  for (const Entry& entry : entries) {
+    size += entry.position.script_name->size() + 1;
   }
 
   int padding = ((size + 7) & (~7)) - size;
   debug_info.size_ = size + padding;
   LogWriteBytes(reinterpret_cast<const char*>(&debug_info), sizeof(debug_info));
 
-  Address code_start = code->InstructionStart();
-
-  for (SourcePositionTableIterator iterator(code->SourcePositionTable());
-       !iterator.done(); iterator.Advance()) {
-    SourcePositionInfo info(
-        GetSourcePositionInfo(code, shared, iterator.source_position()));
-    PerfJitDebugEntry entry;
+  for (const Entry& entry : entries) {
+    PerfJitDebugEntry debug_entry;
     // The entry point of the function will be placed straight after the ELF
     // header when processed by "perf inject". Adjust the position addresses
     // accordingly.
-    entry.address_ = code_start + iterator.code_offset() + kElfHeaderSize;
-    entry.line_number_ = info.line + 1;
-    entry.column_ = info.column + 1;
-    LogWriteBytes(reinterpret_cast<const char*>(&entry), sizeof(entry));
-    // The extracted name may point into heap-objects, thus disallow GC.
-    DisallowHeapAllocation no_gc;
-    std::unique_ptr<char[]> name_storage;
-    Vector<const char> name_string = GetScriptName(info, &name_storage, no_gc);
-    LogWriteBytes(name_string.begin(),
-                  static_cast<uint32_t>(name_string.size()) + 1);
+    debug_entry.address_ = code_start + entry.code_offset + kElfHeaderSize;
+    debug_entry.line_number_ = entry.position.line + 1;
+    debug_entry.column_ = entry.position.column + 1;
+    LogWriteBytes(reinterpret_cast<const char*>(&debug_entry),
+                  sizeof(debug_entry));
+    const std::string* name = entry.position.script_name;
+    LogWriteBytes(name->c_str(), static_cast<int>(name->size()) + 1);
   }
   char padding_bytes[8] = {0};
   LogWriteBytes(padding_bytes, padding);
@@ -488,8 +581,10 @@ void PerfJitLogger::LogWriteUnwindingInfo(Code code) {
     LogWriteBytes(reinterpret_cast<const char*>(code.unwinding_info_start()),
                   code.unwinding_info_size());
   } else {
-    OFStream perf_output_stream(perf_output_handle_);
-    EhFrameWriter::WriteEmptyEhFrame(perf_output_stream);
+    std::ostringstream empty_eh_frame;
+    EhFrameWriter::WriteEmptyEhFrame(empty_eh_frame);
+    std::string data = empty_eh_frame.str();
+    LogWriteBytes(data.data(), static_cast<int>(data.size()));
   }
 
   char padding_bytes[] = "\0\0\0\0\0\0\0\0";
@@ -504,9 +599,25 @@ void PerfJitLogger::CodeMoveEvent(AbstractCode from, AbstractCode to) {
 }
 
 void PerfJitLogger::LogWriteBytes(const char* bytes, int size) {
-  size_t rv = fwrite(bytes, 1, size, perf_output_handle_);
-  DCHECK(static_cast<size_t>(size) == rv);
-  USE(rv);
+  records_.insert(records_.end(), bytes, bytes + size);
+}
+
+bool PerfJitLogger::HasOutputFile() {
+  base::LockGuard<base::RecursiveMutex> guard_file(file_mutex_.Pointer());
+  return writer_thread_ != nullptr;
+}
+
+void PerfJitLogger::CommitRecords() {
+  if (records_.empty()) return;
+  {
+    // Only the hand-over needs the lock, the file is written by the writer
+    // thread.
+    base::LockGuard<base::RecursiveMutex> guard_file(file_mutex_.Pointer());
+    if (writer_thread_ != nullptr) {
+      writer_thread_->Enqueue(new std::vector<uint8_t>(std::move(records_)));
+    }
+  }
+  records_.clear();
 }
 
 void PerfJitLogger::LogWriteHeader() {
@@ -33,12 +33,23 @@
 // {PerfJitLogger} is only implemented on Linux.
 #if V8_OS_LINUX
 
+#include <atomic>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "src/codegen/source-position.h"
 #include "src/logging/log.h"
 
 namespace v8 {
 namespace internal {
 
 // Linux perf tool logging support.
+//
+// The records of a code object are serialized into a buffer on the thread
+// creating the code and handed to a background thread, which writes them to
+// the jitdump file in batches. Code creation therefore never waits for the
+// file system; the file mutex is only held to hand over the records.
 class PerfJitLogger : public CodeEventLogger {
  public:
   explicit PerfJitLogger(Isolate* isolate);
@@ -77,6 +88,24 @@ class PerfJitLogger : public CodeEventLogger {
   void LogWriteDebugInfo(Handle<Code> code, Handle<SharedFunctionInfo> shared);
   void LogWriteDebugInfo(const wasm::WasmCode* code);
   void LogWriteUnwindingInfo(Code code);
+  // Hands the records serialized since the last call to the writer thread.
+  void CommitRecords();
+  bool HasOutputFile();
+
+  // A source position resolved to line and column.
+  struct DebugPosition {
+    int line;
+    int column;
+    // Owned by |script_names_|.
+    const std::string* script_name;
+  };
+  DebugPosition GetDebugPosition(Handle<SharedFunctionInfo> shared,
+                                 SourcePosition pos);
+  const std::string* GetScriptName(Object maybe_script);
+
+  // The caches are dropped when they reach this many positions, as script
+  // ids are not reused and entries of dead scripts are never looked up again.
+  static const size_t kMaxCachedPositions = 64 * KB;
 
   static const uint32_t kElfMachIA32 = 3;
   static const uint32_t kElfMachX64 = 62;
@@ -124,7 +153,21 @@ class PerfJitLogger : public CodeEventLogger {
   static FILE* perf_output_handle_;
   static uint64_t reference_count_;
   static void* marker_address_;
-  static uint64_t code_index_;
+  static std::atomic<uint64_t> code_index_;
+
+  class WriterThread;
+  // Created with the file and joined when it is closed. Protected by
+  // |file_mutex_|.
+  static WriterThread* writer_thread_;
+
+  // Records of the code object currently being logged.
+  std::vector<uint8_t> records_;
+
+  // Resolved positions keyed by script id and script offset. They are shared
+  // by all code objects of a function, including the ones it is inlined
+  // into, so recompiling a function does not resolve its positions again.
+  std::unordered_map<uint64_t, DebugPosition> positions_;
+  std::unordered_map<int, std::string> script_names_;
 };
 
 }  // namespace internal
@@ -34,7 +34,9 @@
 #include "src/date/date.h"
 #include "src/debug/debug-frames.h"
 #include "src/debug/debug.h"
+#include "src/deoptimizer/deoptimization-statistics.h"
 #include "src/deoptimizer/deoptimizer.h"
+#include "src/diagnostics/allocation-site-profiler.h"
 #include "src/diagnostics/basic-block-profiler.h"
 #include "src/diagnostics/compilation-statistics.h"
 #include "src/execution/frames-inl.h"
@@ -3068,6 +3070,8 @@ void Isolate::Deinit() {
 
   delete deoptimizer_data_;
   deoptimizer_data_ = nullptr;
+  delete deoptimization_statistics_;
+  deoptimization_statistics_ = nullptr;
   string_table_.reset();
   builtins_.TearDown();
   bootstrapper_->TearDown();
@@ -3529,6 +3533,7 @@ bool Isolate::Init(ReadOnlyDeserializer* read_only_deserializer,
   DCHECK_NOT_NULL(wasm_engine_);
 
   deoptimizer_data_ = new DeoptimizerData(heap());
+  deoptimization_statistics_ = new DeoptimizationStatistics();
 
   if (setup_delegate_ == nullptr) {
     setup_delegate_ = new SetupIsolateDelegate(create_heap_objects);
@@ -3816,6 +3821,12 @@ void Isolate::DumpAndResetStats() {
     BasicBlockProfiler::Get()->Print(out, this);
     BasicBlockProfiler::Get()->ResetCounts(this);
   }
+  if (FLAG_turbo_allocation_profiling &&
+      AllocationSiteProfiler::Get()->HasData()) {
+    StdoutStream out;
+    AllocationSiteProfiler::Get()->Print(out);
+    AllocationSiteProfiler::Get()->ResetCounts();
+  }
 }
 
 void Isolate::AbortConcurrentOptimization(BlockingBehavior behavior) {
@@ -3853,8 +3864,9 @@ bool Isolate::NeedsDetailedOptimizedCodeLineInfo() const {
 
 bool Isolate::NeedsSourcePositionsForProfiling() const {
   return FLAG_trace_deopt || FLAG_trace_turbo || FLAG_trace_turbo_graph ||
-         FLAG_turbo_profiling || FLAG_perf_prof || is_profiling() ||
-         debug_->is_active() || logger_->is_logging() || FLAG_trace_maps;
+         FLAG_turbo_profiling || FLAG_turbo_allocation_profiling ||
+         FLAG_perf_prof || is_profiling() || debug_->is_active() ||
+         logger_->is_logging() || FLAG_trace_maps;
 }
 
 void Isolate::SetFeedbackVectorsForProfilingTools(Object value) {
@@ -76,6 +76,7 @@ class CompilationStatistics;
 class CompilerDispatcher;
 class Counters;
 class Debug;
+class DeoptimizationStatistics;
 class DeoptimizerData;
 class DescriptorLookupCache;
 class EmbeddedFileWriterInterface;
@@ -991,6 +992,9 @@ class V8_EXPORT_PRIVATE Isolate final : private HiddenFactory {
   StubCache* load_stub_cache() { return load_stub_cache_; }
   StubCache* store_stub_cache() { return store_stub_cache_; }
   DeoptimizerData* deoptimizer_data() { return deoptimizer_data_; }
+  DeoptimizationStatistics* deoptimization_statistics() {
+    return deoptimization_statistics_;
+  }
   bool deoptimizer_lazy_throw() const { return deoptimizer_lazy_throw_; }
   void set_deoptimizer_lazy_throw(bool value) {
     deoptimizer_lazy_throw_ = value;
@@ -1697,6 +1701,7 @@ class V8_EXPORT_PRIVATE Isolate final : private HiddenFactory {
   StubCache* load_stub_cache_ = nullptr;
   StubCache* store_stub_cache_ = nullptr;
   DeoptimizerData* deoptimizer_data_ = nullptr;
+  DeoptimizationStatistics* deoptimization_statistics_ = nullptr;
   bool deoptimizer_lazy_throw_ = false;
   MaterializedObjectStore* materialized_object_store_ = nullptr;
   bool capture_stack_trace_for_uncaught_exceptions_ = false;
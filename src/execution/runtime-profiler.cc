@@ -4,6 +4,12 @@
 
 #include "src/execution/runtime-profiler.h"
 
+#include <cstdlib>
+#include <fstream>
+#include <map>
+
+#include "src/base/lazy-instance.h"
+#include "src/base/platform/mutex.h"
 #include "src/base/platform/platform.h"
 #include "src/codegen/assembler.h"
 #include "src/codegen/compilation-cache.h"
@@ -15,6 +21,7 @@
 #include "src/handles/global-handles.h"
 #include "src/init/bootstrapper.h"
 #include "src/interpreter/interpreter.h"
+#include "src/objects/script.h"
 #include "src/tracing/trace-event.h"
 
 namespace v8 {
@@ -49,6 +56,7 @@ static const int kProfilerTicksForTurboPropOSR = 3 * 10;
 #define OPTIMIZATION_REASON_LIST(V)   \
   V(DoNotOptimize, "do not optimize") \
   V(HotAndStable, "hot and stable")   \
+  V(HotInProfile, "hot in profile")   \
   V(SmallFunction, "small function")
 
 enum class OptimizationReason : uint8_t {
@@ -112,15 +120,111 @@ void TraceNCIRecompile(JSFunction function, OptimizationReason reason) {
   }
 }
 
+// Returns the name of the script of {shared}, or the empty string if it has
+// none. Functions of unnamed scripts cannot be matched across runs.
+std::string ScriptNameOf(SharedFunctionInfo shared) {
+  Object script = shared.script();
+  if (!script.IsScript()) return std::string();
+  Object name = Script::cast(script).name();
+  if (!name.IsString()) return std::string();
+  return String::cast(name).ToCString().get();
+}
+
+uint64_t SourceRangeKey(int start, int end) {
+  return (static_cast<uint64_t>(static_cast<uint32_t>(start)) << 32) |
+         static_cast<uint32_t>(end);
+}
+
+// The hot functions that the isolates of this process have written to each
+// output file, so that every function is written once and isolates do not
+// overwrite each other's functions.
+struct HotFunctionsFile {
+  std::set<std::string> functions;
+  std::ofstream stream;
+};
+using HotFunctionsByFile = std::map<std::string, HotFunctionsFile>;
+DEFINE_LAZY_LEAKY_OBJECT_GETTER(HotFunctionsByFile, GetHotFunctionsByFile)
+base::LazyMutex hot_functions_output_mutex = LAZY_MUTEX_INITIALIZER;
+
+// Appends {key} to the --hot-functions-output file right away, so that the
+// list does not depend on the isolate being torn down cleanly.
+void AppendHotFunction(const std::string& key) {
+  base::MutexGuard guard(hot_functions_output_mutex.Pointer());
+  HotFunctionsFile& file =
+      (*GetHotFunctionsByFile())[FLAG_hot_functions_output];
+  if (!file.functions.insert(key).second) return;
+  if (!file.stream.is_open()) file.stream.open(FLAG_hot_functions_output);
+  file.stream << key << std::endl;
+}
+
 }  // namespace
 
 RuntimeProfiler::RuntimeProfiler(Isolate* isolate)
-    : isolate_(isolate), any_ic_changed_(false) {}
+    : isolate_(isolate), any_ic_changed_(false) {
+  if (FLAG_hot_functions_input != nullptr) ReadHotFunctions();
+}
+
+void RuntimeProfiler::ReadHotFunctions() {
+  // A missing file is fine, e.g. on the very first run. Each line reads
+  // "<start position>,<end position>,<script name>".
+  std::ifstream file(FLAG_hot_functions_input);
+  for (std::string line; std::getline(file, line);) {
+    size_t first = line.find(',');
+    if (first == std::string::npos) continue;
+    size_t second = line.find(',', first + 1);
+    if (second == std::string::npos) continue;
+    int start = std::atoi(line.substr(0, first).c_str());
+    int end = std::atoi(line.substr(first + 1, second - first - 1).c_str());
+    hot_functions_in_profile_[SourceRangeKey(start, end)].insert(
+        line.substr(second + 1));
+  }
+}
+
+bool RuntimeProfiler::ConsumeHotInProfile(SharedFunctionInfo shared) {
+  if (hot_functions_in_profile_.empty()) return false;
+  // Rule out most functions by their source range before building the name
+  // of their script.
+  auto it = hot_functions_in_profile_.find(
+      SourceRangeKey(shared.StartPosition(), shared.EndPosition()));
+  if (it == hot_functions_in_profile_.end()) return false;
+  std::string script_name = ScriptNameOf(shared);
+  if (script_name.empty() || it->second.erase(script_name) == 0) return false;
+  if (it->second.empty()) hot_functions_in_profile_.erase(it);
+  return true;
+}
+
+void RuntimeProfiler::MarkHotInProfileForOptimization(
+    Handle<JSFunction> function, IsCompiledScope* is_compiled_scope) {
+  if (hot_functions_in_profile_.empty() || FLAG_always_opt) return;
+  if (!isolate_->use_optimizer()) return;
+  if (!function->shared().HasBytecodeArray() ||
+      function->shared().optimization_disabled() ||
+      function->HasAvailableOptimizedCode() ||
+      function->HasOptimizationMarker()) {
+    return;
+  }
+  if (!ConsumeHotInProfile(function->shared())) return;
+  // The function got hot in an earlier run, so optimize it on its first call
+  // instead of waiting for profiler ticks. This happens only once, so that a
+  // deoptimized function tiers up as usual.
+  JSFunction::EnsureFeedbackVector(function, is_compiled_scope);
+  Optimize(*function, OptimizationReason::kHotInProfile);
+}
 
 void RuntimeProfiler::Optimize(JSFunction function, OptimizationReason reason) {
   DCHECK_NE(reason, OptimizationReason::kDoNotOptimize);
   TraceRecompile(function, reason, isolate_);
   function.MarkForOptimization(ConcurrencyMode::kConcurrent);
+  if (FLAG_hot_functions_output != nullptr) {
+    SharedFunctionInfo shared = function.shared();
+    std::string script_name = ScriptNameOf(shared);
+    if (!script_name.empty()) {
+      std::string key = std::to_string(shared.StartPosition()) + "," +
+                        std::to_string(shared.EndPosition()) + "," +
+                        script_name;
+      if (hot_functions_.insert(key).second) AppendHotFunction(key);
+    }
+  }
 }
 
 void RuntimeProfiler::AttemptOnStackReplacement(InterpretedFrame* frame,
@@ -5,6 +5,11 @@
 #ifndef V8_EXECUTION_RUNTIME_PROFILER_H_
 #define V8_EXECUTION_RUNTIME_PROFILER_H_
 
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
 #include "src/common/assert-scope.h"
 #include "src/handles/handles.h"
 #include "src/utils/allocation.h"
@@ -15,7 +20,9 @@ namespace internal {
 class BytecodeArray;
 class Isolate;
 class InterpretedFrame;
+class IsCompiledScope;
 class JSFunction;
+class SharedFunctionInfo;
 enum class OptimizationReason : uint8_t;
 
 class RuntimeProfiler {
@@ -32,7 +39,20 @@ class RuntimeProfiler {
   void AttemptOnStackReplacement(InterpretedFrame* frame,
                                  int nesting_levels = 1);
 
+  // Returns whether {shared} was marked for optimization in the run that
+  // wrote the --hot-functions-input file, and forgets about it, so that it
+  // is optimized early only once.
+  bool ConsumeHotInProfile(SharedFunctionInfo shared);
+
+  // Marks {function} for optimization if it is listed in the
+  // --hot-functions-input file. Called when a compiled closure is created
+  // and when a closure is lazily compiled on its first call.
+  void MarkHotInProfileForOptimization(Handle<JSFunction> function,
+                                       IsCompiledScope* is_compiled_scope);
+
  private:
+  void ReadHotFunctions();
+
   // Make the decision whether to optimize the given function, and mark it for
   // optimization if the decision was 'yes'.
   void MaybeOptimizeNCIFrame(JSFunction function);
@@ -59,6 +79,12 @@ class RuntimeProfiler {
 
   Isolate* isolate_;
   bool any_ic_changed_;
+
+  // Functions are identified across processes by their source range and the
+  // name of their script. The script names are grouped by source range.
+  std::unordered_map<uint64_t, std::unordered_set<std::string>>
+      hot_functions_in_profile_;
+  std::set<std::string> hot_functions_;
 };
 
 }  // namespace internal
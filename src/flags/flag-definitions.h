@@ -497,6 +497,12 @@ DEFINE_BOOL_READONLY(string_slices, true, "use string slices")
 
 DEFINE_INT(interrupt_budget, 144 * KB,
            "interrupt budget which should be used for the profiler counter")
+DEFINE_STRING(hot_functions_output, nullptr,
+              "append the functions marked for optimization by the runtime "
+              "profiler to the given file as they are marked")
+DEFINE_STRING(hot_functions_input, nullptr,
+              "optimize the functions listed in the given file (written by "
+              "--hot-functions-output) on their first call")
 
 // Flags for inline caching and feedback vectors.
 DEFINE_BOOL(use_ic, true, "use inline caching")
@@ -514,6 +520,9 @@ DEFINE_BOOL(ignition_filter_expression_positions, true,
 DEFINE_BOOL(ignition_share_named_property_feedback, true,
             "share feedback slots when loading the same named property from "
             "the same object")
+DEFINE_BOOL(branch_feedback, false,
+            "count taken branches in the interpreter and use the counts as "
+            "branch hints in TurboFan")
 DEFINE_BOOL(print_bytecode, false,
             "print bytecode generated by ignition interpreter")
 DEFINE_BOOL(enable_lazy_source_positions, V8_LAZY_SOURCE_POSITIONS_BOOL,
@@ -704,9 +713,22 @@ DEFINE_BOOL(turbo_jt, true, "enable jump threading in TurboFan")
 DEFINE_BOOL(turbo_loop_peeling, true, "Turbofan loop peeling")
 DEFINE_BOOL(turbo_loop_variable, true, "Turbofan loop variable optimization")
 DEFINE_BOOL(turbo_loop_rotation, true, "Turbofan loop rotation")
+DEFINE_BOOL(turbo_loop_unrolling, false, "Turbofan loop unrolling")
+DEFINE_BOOL(turbo_loop_check_hoisting, false,
+            "hoist loop-invariant checks out of loops in TurboFan")
+DEFINE_BOOL(turbo_bounds_check_elimination, false,
+            "eliminate bounds checks of induction variables in TurboFan")
+DEFINE_BOOL(turbo_loop_vectorization, false,
+            "vectorize element-wise typed array loops in TurboFan")
 DEFINE_BOOL(turbo_cf_optimization, true, "optimize control flow in TurboFan")
 DEFINE_BOOL(turbo_escape, true, "enable escape analysis")
 DEFINE_BOOL(turbo_allocation_folding, true, "Turbofan allocation folding")
+DEFINE_BOOL(turbo_allocation_profiling, false,
+            "count the allocations of inline allocation sites in TurboFan "
+            "code and print the sites that allocate most")
+DEFINE_INT(turbo_allocation_profiling_interval, 16,
+           "sample every n-th allocation of an inline allocation site with "
+           "--turbo-allocation-profiling")
 DEFINE_BOOL(turbo_instruction_scheduling, false,
             "enable instruction scheduling in TurboFan")
 DEFINE_BOOL(turbo_stress_instruction_scheduling, false,
@@ -1689,6 +1711,10 @@ DEFINE_BOOL(log_source_code, false, "Log source code.")
 DEFINE_BOOL(log_function_events, false,
             "Log function events "
             "(parse, compile, execute) separately.")
+DEFINE_BOOL(log_binary, false,
+            "Write the log in a compact binary format, using per-thread "
+            "buffers instead of a global lock. Use "
+            "tools/binary-log-converter.py to convert it to the text format.")
 
 DEFINE_IMPLICATION(log_all, log_api)
 DEFINE_IMPLICATION(log_all, log_code)
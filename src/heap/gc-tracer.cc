@@ -7,11 +7,13 @@
 #include <cstdarg>
 
 #include "src/base/atomic-utils.h"
+#include "src/execution/isolate-inl.h"
 #include "src/execution/isolate.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/incremental-marking.h"
 #include "src/heap/spaces.h"
 #include "src/logging/counters-inl.h"
+#include "src/logging/metrics.h"
 
 namespace v8 {
 namespace internal {
@@ -373,6 +375,10 @@ void GCTracer::Stop(GarbageCollector collector) {
   }
   FetchBackgroundGeneralCounters();
 
+  if (heap_->isolate()->metrics_recorder()->HasEmbedderRecorder()) {
+    ReportCycleToRecorder(duration);
+  }
+
   heap_->UpdateTotalGCTime(duration);
 
   if ((current_.type == Event::SCAVENGER ||
@@ -401,6 +407,102 @@ void GCTracer::Stop(GarbageCollector collector) {
   }
 }
 
+namespace {
+
+int64_t MillisecondsToMicroseconds(double ms) {
+  return static_cast<int64_t>(ms * base::Time::kMicrosecondsPerMillisecond);
+}
+
+v8::metrics::GarbageCollectionSizes MakeSizes(size_t before, size_t after) {
+  v8::metrics::GarbageCollectionSizes sizes;
+  sizes.bytes_before = static_cast<int64_t>(before);
+  sizes.bytes_after = static_cast<int64_t>(after);
+  sizes.bytes_freed = sizes.bytes_before - sizes.bytes_after;
+  return sizes;
+}
+
+v8::metrics::Recorder::ContextId GetContextId(Isolate* isolate) {
+  if (isolate->context().is_null()) {
+    return v8::metrics::Recorder::ContextId::Empty();
+  }
+  HandleScope scope(isolate);
+  return isolate->GetOrRegisterRecorderContextId(isolate->native_context());
+}
+
+}  // namespace
+
+void GCTracer::ReportCycleToRecorder(double duration) {
+  Isolate* isolate = heap_->isolate();
+  const double* scopes = current_.scopes;
+  const char* reason =
+      Heap::GarbageCollectionReasonToString(current_.gc_reason);
+  switch (current_.type) {
+    case Event::SCAVENGER:
+    case Event::MINOR_MARK_COMPACTOR: {
+      v8::metrics::GarbageCollectionYoungCycle event;
+      event.reason = reason;
+      event.total_wall_clock_duration_in_us =
+          MillisecondsToMicroseconds(duration);
+      event.background_wall_clock_duration_in_us = MillisecondsToMicroseconds(
+          scopes[Scope::SCAVENGER_BACKGROUND_SCAVENGE_PARALLEL] +
+          scopes[Scope::MINOR_MC_BACKGROUND_EVACUATE_COPY] +
+          scopes[Scope::MINOR_MC_BACKGROUND_EVACUATE_UPDATE_POINTERS] +
+          scopes[Scope::MINOR_MC_BACKGROUND_MARKING]);
+      event.young_object_bytes_before =
+          static_cast<int64_t>(current_.young_object_size);
+      event.survived_bytes =
+          static_cast<int64_t>(current_.survived_young_object_size);
+      event.objects =
+          MakeSizes(current_.start_object_size, current_.end_object_size);
+      isolate->metrics_recorder()->AddMainThreadEvent(event,
+                                                      GetContextId(isolate));
+      break;
+    }
+    case Event::MARK_COMPACTOR:
+    case Event::INCREMENTAL_MARK_COMPACTOR: {
+      const IncrementalMarkingInfos* incremental_scopes =
+          current_.incremental_marking_scopes;
+      v8::metrics::GarbageCollectionFullCycle event;
+      event.reason = reason;
+      event.reduce_memory = current_.reduce_memory;
+      event.atomic_pause_wall_clock_duration_in_us =
+          MillisecondsToMicroseconds(duration);
+      event.incremental_marking_wall_clock_duration_in_us =
+          MillisecondsToMicroseconds(
+              current_.incremental_marking_duration +
+              incremental_scopes[Scope::MC_INCREMENTAL_LAYOUT_CHANGE].duration +
+              incremental_scopes[Scope::MC_INCREMENTAL_START].duration +
+              incremental_scopes[Scope::MC_INCREMENTAL_SWEEPING].duration +
+              incremental_scopes[Scope::MC_INCREMENTAL_FINALIZE].duration);
+      event.main_thread.compact_wall_clock_duration_in_us =
+          MillisecondsToMicroseconds(scopes[Scope::MC_EVACUATE]);
+      event.main_thread.mark_wall_clock_duration_in_us =
+          MillisecondsToMicroseconds(scopes[Scope::MC_MARK]);
+      event.main_thread.sweep_wall_clock_duration_in_us =
+          MillisecondsToMicroseconds(scopes[Scope::MC_SWEEP]);
+      event.main_thread.weak_wall_clock_duration_in_us =
+          MillisecondsToMicroseconds(scopes[Scope::MC_CLEAR]);
+      event.background.compact_wall_clock_duration_in_us =
+          MillisecondsToMicroseconds(
+              scopes[Scope::MC_BACKGROUND_EVACUATE_COPY] +
+              scopes[Scope::MC_BACKGROUND_EVACUATE_UPDATE_POINTERS]);
+      event.background.mark_wall_clock_duration_in_us =
+          MillisecondsToMicroseconds(scopes[Scope::MC_BACKGROUND_MARKING]);
+      event.background.sweep_wall_clock_duration_in_us =
+          MillisecondsToMicroseconds(scopes[Scope::MC_BACKGROUND_SWEEPING]);
+      event.objects =
+          MakeSizes(current_.start_object_size, current_.end_object_size);
+      event.memory =
+          MakeSizes(current_.start_memory_size, current_.end_memory_size);
+      isolate->metrics_recorder()->AddMainThreadEvent(event,
+                                                      GetContextId(isolate));
+      break;
+    }
+    case Event::START:
+      UNREACHABLE();
+  }
+}
+
 void GCTracer::NotifySweepingCompleted() {
   if (FLAG_trace_gc_freelists) {
     PrintIsolate(heap_->isolate(),
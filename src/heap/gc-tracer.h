@@ -405,6 +405,9 @@ class V8_EXPORT_PRIVATE GCTracer {
   // recording takes place at the end of the atomic pause.
   void RecordGCSumCounters(double atomic_pause_duration);
 
+  // Sends the current event to the embedder's metrics recorder.
+  void ReportCycleToRecorder(double duration);
+
   // Print one detailed trace line in name=value format.
   // TODO(ernstm): Move to Heap.
   void PrintNVP() const;
@@ -0,0 +1,169 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/ic/ic-census.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <utility>
+
+#include "src/execution/isolate.h"
+#include "src/heap/heap-inl.h"
+#include "src/interpreter/bytecode-array-iterator.h"
+#include "src/objects/feedback-vector-inl.h"
+#include "src/objects/script.h"
+#include "src/objects/shared-function-info-inl.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// Bytecodes with a property access IC, which take the feedback slot as their
+// last operand.
+bool HasPropertyAccessFeedback(interpreter::Bytecode bytecode) {
+  switch (bytecode) {
+    case interpreter::Bytecode::kLdaNamedProperty:
+    case interpreter::Bytecode::kLdaNamedPropertyFromSuper:
+    case interpreter::Bytecode::kLdaKeyedProperty:
+    case interpreter::Bytecode::kStaNamedProperty:
+    case interpreter::Bytecode::kStaNamedOwnProperty:
+    case interpreter::Bytecode::kStaKeyedProperty:
+    case interpreter::Bytecode::kStaInArrayLiteral:
+    case interpreter::Bytecode::kStaDataPropertyInLiteral:
+    case interpreter::Bytecode::kTestIn:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// A site as found while walking the heap, before handles are created for
+// the sites that are kept.
+struct Candidate {
+  SharedFunctionInfo shared;
+  int bytecode_offset;
+  FeedbackSlotKind kind;
+  InlineCacheState state;
+  int map_count;
+  int invocation_count;
+};
+
+bool RanksBefore(const Candidate& a, const Candidate& b) {
+  if (a.state != b.state) return a.state == MEGAMORPHIC;
+  if (a.invocation_count != b.invocation_count) {
+    return a.invocation_count > b.invocation_count;
+  }
+  return a.map_count > b.map_count;
+}
+
+class CandidateCollector {
+ public:
+  explicit CandidateCollector(Isolate* isolate) : isolate_(isolate) {}
+
+  void VisitFeedbackVector(FeedbackVector vector);
+
+  std::vector<Candidate>& candidates() { return candidates_; }
+
+ private:
+  Isolate* const isolate_;
+  std::vector<Candidate> candidates_;
+  // Index of the candidate for a SharedFunctionInfo and bytecode offset.
+  // Objects do not move while the heap is walked.
+  std::map<std::pair<Address, int>, size_t> indices_;
+};
+
+void CandidateCollector::VisitFeedbackVector(FeedbackVector vector) {
+  SharedFunctionInfo shared = vector.shared_function_info();
+  if (!shared.HasBytecodeArray()) return;
+  HandleScope scope(isolate_);
+  for (interpreter::BytecodeArrayIterator it(
+           handle(shared.GetBytecodeArray(), isolate_));
+       !it.done(); it.Advance()) {
+    interpreter::Bytecode bytecode = it.current_bytecode();
+    if (!HasPropertyAccessFeedback(bytecode)) continue;
+    int slot_operand = interpreter::Bytecodes::NumberOfOperands(bytecode) - 1;
+    FeedbackNexus nexus(vector, it.GetSlotOperand(slot_operand));
+    InlineCacheState state = nexus.ic_state();
+    if (state != POLYMORPHIC && state != MEGAMORPHIC) continue;
+    int map_count = 0;
+    if (state == POLYMORPHIC) {
+      for (FeedbackIterator maps(&nexus); !maps.done(); maps.Advance()) {
+        map_count++;
+      }
+    }
+
+    auto key = std::make_pair(shared.ptr(), it.current_offset());
+    auto index = indices_.find(key);
+    if (index == indices_.end()) {
+      indices_.emplace(key, candidates_.size());
+      candidates_.push_back({shared, it.current_offset(), nexus.kind(), state,
+                             map_count, vector.invocation_count()});
+      continue;
+    }
+    // Another closure of the same function.
+    Candidate& candidate = candidates_[index->second];
+    candidate.invocation_count += vector.invocation_count();
+    if (state == MEGAMORPHIC) {
+      candidate.state = MEGAMORPHIC;
+      candidate.map_count = 0;
+    } else if (candidate.state == POLYMORPHIC) {
+      candidate.map_count = std::max(candidate.map_count, map_count);
+    }
+  }
+}
+
+}  // namespace
+
+void ICCensus::Collect(size_t max_sites) {
+  sites_.clear();
+  HeapObjectIterator iterator(isolate_->heap());
+  CandidateCollector collector(isolate_);
+  for (HeapObject obj = iterator.Next(); !obj.is_null();
+       obj = iterator.Next()) {
+    if (!obj.IsFeedbackVector()) continue;
+    collector.VisitFeedbackVector(FeedbackVector::cast(obj));
+  }
+
+  std::vector<Candidate>& candidates = collector.candidates();
+  std::sort(candidates.begin(), candidates.end(), RanksBefore);
+  if (candidates.size() > max_sites) candidates.resize(max_sites);
+  for (const Candidate& candidate : candidates) {
+    sites_.push_back({handle(candidate.shared, isolate_),
+                      candidate.bytecode_offset, candidate.kind,
+                      candidate.state, candidate.map_count,
+                      candidate.invocation_count});
+  }
+}
+
+void ICCensus::Report(v8::InlineCacheSiteVisitor* visitor) {
+  for (const Site& site : sites_) {
+    v8::InlineCacheSite entry;
+    std::unique_ptr<char[]> name = site.shared->DebugName().ToCString();
+    entry.function_name = name.get();
+    entry.script_id = -1;
+    entry.position = -1;
+    if (site.shared->script().IsScript()) {
+      entry.script_id = Script::cast(site.shared->script()).id();
+      // Bytecode may have been flushed by a GC caused by collecting source
+      // positions of earlier sites.
+      if (site.shared->HasBytecodeArray()) {
+        SharedFunctionInfo::EnsureSourcePositionsAvailable(isolate_,
+                                                           site.shared);
+        entry.position =
+            AbstractCode::cast(site.shared->GetBytecodeArray())
+                .SourcePosition(site.bytecode_offset);
+      }
+    }
+    entry.kind = FeedbackMetadata::Kind2String(site.kind);
+    entry.megamorphic = site.state == MEGAMORPHIC;
+    entry.map_count = site.map_count;
+    entry.invocation_count = site.invocation_count;
+    visitor->VisitSite(entry);
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,60 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_IC_IC_CENSUS_H_
+#define V8_IC_IC_CENSUS_H_
+
+#include <vector>
+
+#include "include/v8.h"
+#include "src/handles/handles.h"
+#include "src/objects/feedback-vector.h"
+
+namespace v8 {
+namespace internal {
+
+class Isolate;
+class SharedFunctionInfo;
+
+// On-demand census of the property access ICs that have gone polymorphic or
+// megamorphic, exposed through v8::Isolate::GetInlineCacheCensus(). Unlike
+// --trace-ic it costs nothing until a census is taken, which walks all
+// feedback vectors in the heap.
+//
+// Feedback vectors of closures of the same function in different native
+// contexts are aggregated into a single site per bytecode offset.
+class V8_EXPORT_PRIVATE ICCensus {
+ public:
+  struct Site {
+    Handle<SharedFunctionInfo> shared;
+    int bytecode_offset;
+    FeedbackSlotKind kind;
+    // Either POLYMORPHIC or MEGAMORPHIC.
+    InlineCacheState state;
+    // Number of receiver maps of polymorphic sites, 0 for megamorphic ones.
+    int map_count;
+    // Summed over all feedback vectors of the function.
+    int invocation_count;
+  };
+
+  explicit ICCensus(Isolate* isolate) : isolate_(isolate) {}
+
+  // Keeps the |max_sites| sites ranked highest: megamorphic sites before
+  // polymorphic ones, then by invocation count and number of maps.
+  void Collect(size_t max_sites);
+  // Resolves the source positions of the collected sites and reports them in
+  // ranking order.
+  void Report(v8::InlineCacheSiteVisitor* visitor);
+
+  const std::vector<Site>& sites() const { return sites_; }
+
+ private:
+  Isolate* const isolate_;
+  std::vector<Site> sites_;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_IC_IC_CENSUS_H_
@@ -1662,6 +1662,7 @@ void BytecodeGenerator::VisitIfStatement(IfStatement* stmt) {
     // TODO(oth): If then statement is BreakStatement or
     // ContinueStatement we can reduce number of generated
     // jump/jump_ifs here. See BasicLoops test.
+    AllocateBranchCounterSlotsIfEnabled(&conditional_builder);
     VisitForTest(stmt->condition(), conditional_builder.then_labels(),
                  conditional_builder.else_labels(), TestFallthrough::kThen);
 
@@ -1672,6 +1673,10 @@ void BytecodeGenerator::VisitIfStatement(IfStatement* stmt) {
       conditional_builder.JumpToEnd();
       conditional_builder.Else();
       Visit(stmt->else_statement());
+    } else if (conditional_builder.counts_branches()) {
+      // Skip the counter of the empty else branch after the then block.
+      conditional_builder.JumpToEnd();
+      conditional_builder.Else();
     }
   }
 }
@@ -2550,6 +2555,7 @@ void BytecodeGenerator::VisitConditional(Conditional* expr) {
     conditional_builder.Else();
     VisitForAccumulatorValue(expr->else_expression());
   } else {
+    AllocateBranchCounterSlotsIfEnabled(&conditional_builder);
     VisitForTest(expr->condition(), conditional_builder.then_labels(),
                  conditional_builder.else_labels(), TestFallthrough::kThen);
 
@@ -6380,6 +6386,14 @@ void BytecodeGenerator::BuildIncrementBlockCoverageCounterIfEnabled(
   }
 }
 
+void BytecodeGenerator::AllocateBranchCounterSlotsIfEnabled(
+    ConditionalControlFlowBuilder* conditional_builder) {
+  if (!FLAG_branch_feedback) return;
+  int then_slot = feedback_index(feedback_spec()->AddBranchCounterSlot());
+  int else_slot = feedback_index(feedback_spec()->AddBranchCounterSlot());
+  conditional_builder->CountBranches(then_slot, else_slot);
+}
+
 // Visits the expression |expr| and places the result in the accumulator.
 BytecodeGenerator::TypeHint BytecodeGenerator::VisitForAccumulatorValue(
     Expression* expr) {
@@ -27,6 +27,7 @@ namespace interpreter {
 class TopLevelDeclarationsBuilder;
 class LoopBuilder;
 class BlockCoverageBuilder;
+class ConditionalControlFlowBuilder;
 class BytecodeJumpTable;
 
 class BytecodeGenerator final : public AstVisitor<BytecodeGenerator> {
@@ -374,6 +375,9 @@ class BytecodeGenerator final : public AstVisitor<BytecodeGenerator> {
                                                    SourceRangeKind kind);
   void BuildIncrementBlockCoverageCounterIfEnabled(int coverage_array_slot);
 
+  void AllocateBranchCounterSlotsIfEnabled(
+      ConditionalControlFlowBuilder* conditional_builder);
+
   void BuildTest(ToBooleanMode mode, BytecodeLabels* then_labels,
                  BytecodeLabels* else_labels, TestFallthrough fallthrough);
 
@@ -364,6 +364,9 @@ namespace interpreter {
   /* Block Coverage */                                                         \
   V(IncBlockCounter, AccumulatorUse::kNone, OperandType::kIdx)                 \
                                                                                \
+  /* Branch feedback */                                                        \
+  V(IncBranchCounter, AccumulatorUse::kNone, OperandType::kIdx)                \
+                                                                               \
   /* Execution Abort (internal error) */                                       \
   V(Abort, AccumulatorUse::kNone, OperandType::kIdx)                           \
                                                                                \
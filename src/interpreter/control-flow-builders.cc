@@ -195,6 +195,7 @@ void ConditionalControlFlowBuilder::JumpToEnd() {
 
 void ConditionalControlFlowBuilder::Then() {
   then_labels()->Bind(builder());
+  if (counts_branches()) builder()->IncBranchCounter(branch_counter_then_slot_);
   if (block_coverage_builder_ != nullptr) {
     block_coverage_builder_->IncrementBlockCounter(block_coverage_then_slot_);
   }
@@ -202,6 +203,7 @@ void ConditionalControlFlowBuilder::Then() {
 
 void ConditionalControlFlowBuilder::Else() {
   else_labels()->Bind(builder());
+  if (counts_branches()) builder()->IncBranchCounter(branch_counter_else_slot_);
   if (block_coverage_builder_ != nullptr) {
     block_coverage_builder_->IncrementBlockCounter(block_coverage_else_slot_);
   }
@@ -269,12 +269,24 @@ class V8_EXPORT_PRIVATE ConditionalControlFlowBuilder final
   BytecodeLabels* then_labels() { return &then_labels_; }
   BytecodeLabels* else_labels() { return &else_labels_; }
 
+  // Counts how often the then and else branches are entered in the given
+  // feedback slots. Requires both branches to be bound with Then() and Else().
+  void CountBranches(int then_feedback_slot, int else_feedback_slot) {
+    branch_counter_then_slot_ = then_feedback_slot;
+    branch_counter_else_slot_ = else_feedback_slot;
+  }
+  bool counts_branches() const {
+    return branch_counter_then_slot_ != kNoBranchCounterSlot;
+  }
+
   void Then();
   void Else();
 
   void JumpToEnd();
 
  private:
+  static constexpr int kNoBranchCounterSlot = -1;
+
   BytecodeLabels end_labels_;
   BytecodeLabels then_labels_;
   BytecodeLabels else_labels_;
@@ -282,6 +294,8 @@ class V8_EXPORT_PRIVATE ConditionalControlFlowBuilder final
   AstNode* node_;
   int block_coverage_then_slot_;
   int block_coverage_else_slot_;
+  int branch_counter_then_slot_ = kNoBranchCounterSlot;
+  int branch_counter_else_slot_ = kNoBranchCounterSlot;
   BlockCoverageBuilder* block_coverage_builder_;
 };
 
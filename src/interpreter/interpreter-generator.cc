@@ -2797,6 +2797,29 @@ IGNITION_HANDLER(IncBlockCounter, InterpreterAssembler) {
   Dispatch();
 }
 
+// IncBranchCounter <slot>
+//
+// Increment the count in the feedback vector slot <slot> of the branch that
+// starts here. The counts are used as branch hints by TurboFan.
+IGNITION_HANDLER(IncBranchCounter, InterpreterAssembler) {
+  TNode<UintPtrT> slot_index = BytecodeOperandIdx(0);
+  TNode<HeapObject> maybe_feedback_vector = LoadFeedbackVector();
+
+  Label done(this);
+  GotoIf(IsUndefined(maybe_feedback_vector), &done);
+  TNode<FeedbackVector> feedback_vector = CAST(maybe_feedback_vector);
+  TNode<Smi> count = CAST(LoadFeedbackVectorSlot(feedback_vector, slot_index));
+  // The count saturates.
+  GotoIf(SmiEqual(count, SmiConstant(Smi::kMaxValue)), &done);
+  // Count is Smi, so we don't need a write barrier.
+  StoreFeedbackVectorSlot(feedback_vector, slot_index,
+                          SmiAdd(count, SmiConstant(1)), SKIP_WRITE_BARRIER);
+  Goto(&done);
+
+  BIND(&done);
+  Dispatch();
+}
+
 // ForInEnumerate <receiver>
 //
 // Enumerates the enumerable keys of the |receiver| and either returns the
@@ -85,6 +85,269 @@ size_t TraceBufferRingBuffer::NextChunkIndex(size_t index) const {
   return index;
 }
 
+namespace {
+
+// TRACE_EVENT_PHASE_COMPLETE, events whose duration is updated later.
+const char kPhaseComplete = 'X';
+
+static_assert(TraceBufferChunk::kChunkSize <= 64,
+              "final events of a chunk are tracked in a 64 bit mask");
+const uint64_t kAllEventsFinal =
+    ~uint64_t{0} >> (64 - TraceBufferChunk::kChunkSize);
+
+}  // namespace
+
+class TraceBufferPerThread::WriterThread : public base::Thread {
+ public:
+  explicit WriterThread(TraceBufferPerThread* buffer)
+      : Thread(Options("v8:TraceBufferWriter")), buffer_(buffer) {}
+
+  void Run() override {
+    while (true) {
+      buffer_->chunks_retired_.Wait();
+      if (stopping_.load(std::memory_order_acquire)) return;
+      buffer_->WriteFinalChunks();
+    }
+  }
+
+  void Stop() {
+    stopping_.store(true, std::memory_order_release);
+    buffer_->chunks_retired_.Signal();
+    Join();
+  }
+
+ private:
+  TraceBufferPerThread* const buffer_;
+  std::atomic<bool> stopping_{false};
+};
+
+TraceBufferPerThread::TraceBufferPerThread(size_t max_chunks,
+                                           TraceWriter* trace_writer)
+    : max_chunks_(max_chunks),
+      trace_writer_(trace_writer),
+      chunks_(new Chunk[max_chunks]),
+      state_key_(base::Thread::CreateThreadLocalKey()),
+      chunks_retired_(0),
+      writer_thread_(new WriterThread(this)) {
+  CHECK(writer_thread_->Start());
+}
+
+TraceBufferPerThread::~TraceBufferPerThread() {
+  writer_thread_->Stop();
+  base::Thread::DeleteThreadLocalKey(state_key_);
+}
+
+TraceBufferPerThread::ThreadState* TraceBufferPerThread::GetThreadState() {
+  void* state = base::Thread::GetThreadLocal(state_key_);
+  if (V8_LIKELY(state != nullptr)) return static_cast<ThreadState*>(state);
+  base::MutexGuard guard(&mutex_);
+  thread_states_.emplace_back(new ThreadState());
+  ThreadState* new_state = thread_states_.back().get();
+  base::Thread::SetThreadLocal(state_key_, new_state);
+  return new_state;
+}
+
+TraceObject* TraceBufferPerThread::AddTraceEvent(uint64_t* handle) {
+  ThreadState* state = GetThreadState();
+  // Only contended while Flush() takes the chunk of this thread.
+  state->mutex.Lock();
+  if (state->chunk_index == kNoChunk) {
+    state->chunk_index = AcquireChunk();
+    if (state->chunk_index == kNoChunk) {
+      state->mutex.Unlock();
+      return nullptr;
+    }
+  }
+  TraceBufferChunk* events = chunks_[state->chunk_index].events.get();
+  size_t event_index;
+  TraceObject* trace_object = events->AddTraceEvent(&event_index);
+  *handle = MakeHandle(state->chunk_index, events->seq(), event_index);
+  return trace_object;
+}
+
+TraceObject* TraceBufferPerThread::GetEventByHandle(uint64_t handle) {
+  size_t event_index;
+  Chunk* chunk = LockChunk(handle, &event_index);
+  if (!chunk) return nullptr;
+  TraceObject* trace_object = chunk->events->GetEventAt(event_index);
+  chunk->mutex.Unlock();
+  return trace_object;
+}
+
+void TraceBufferPerThread::CommitTraceEvent(uint64_t handle) {
+  ThreadState* state =
+      static_cast<ThreadState*>(base::Thread::GetThreadLocal(state_key_));
+  DCHECK_NOT_NULL(state);
+  size_t chunk_index, event_index;
+  uint32_t chunk_seq;
+  ExtractHandle(handle, &chunk_index, &chunk_seq, &event_index);
+  DCHECK_EQ(chunk_index, state->chunk_index);
+  Chunk* chunk = &chunks_[chunk_index];
+  if (chunk->events->GetEventAt(event_index)->phase() != kPhaseComplete) {
+    chunk->final_events.fetch_or(uint64_t{1} << event_index,
+                                 std::memory_order_release);
+  }
+  if (chunk->events->IsFull()) {
+    RetireChunk(chunk_index);
+    state->chunk_index = kNoChunk;
+  }
+  state->mutex.Unlock();
+}
+
+void TraceBufferPerThread::UpdateTraceEventDuration(uint64_t handle,
+                                                    int64_t timestamp,
+                                                    int64_t cpu_timestamp) {
+  size_t event_index;
+  Chunk* chunk = LockChunk(handle, &event_index);
+  if (!chunk) return;
+  chunk->events->GetEventAt(event_index)
+      ->UpdateDuration(timestamp, cpu_timestamp);
+  chunk->final_events.fetch_or(uint64_t{1} << event_index,
+                               std::memory_order_release);
+  chunk->mutex.Unlock();
+}
+
+bool TraceBufferPerThread::Flush() {
+  base::MutexGuard writer_guard(&writer_mutex_);
+  std::vector<ThreadState*> thread_states;
+  {
+    base::MutexGuard guard(&mutex_);
+    for (const std::unique_ptr<ThreadState>& state : thread_states_) {
+      thread_states.push_back(state.get());
+    }
+  }
+  // Take the chunks threads are adding events to. A thread in the middle of
+  // adding an event is waited for, afterwards it continues in a new chunk.
+  for (ThreadState* state : thread_states) {
+    base::MutexGuard state_guard(&state->mutex);
+    if (state->chunk_index == kNoChunk) continue;
+    base::MutexGuard guard(&mutex_);
+    retired_chunks_.push_back(state->chunk_index);
+    state->chunk_index = kNoChunk;
+  }
+
+  // This flushes all the traces stored in the buffer, including complete
+  // events whose duration has not been updated yet.
+  std::vector<size_t> flushed_chunks;
+  {
+    base::MutexGuard guard(&mutex_);
+    flushed_chunks.swap(retired_chunks_);
+  }
+  for (size_t chunk_index : flushed_chunks) WriteChunk(chunk_index);
+  {
+    base::MutexGuard guard(&mutex_);
+    for (size_t chunk_index : flushed_chunks) FreeChunk(chunk_index);
+  }
+  trace_writer_->Flush();
+  return true;
+}
+
+TraceBufferPerThread::Chunk* TraceBufferPerThread::LockChunk(
+    uint64_t handle, size_t* event_index) {
+  size_t chunk_index;
+  uint32_t chunk_seq;
+  ExtractHandle(handle, &chunk_index, &chunk_seq, event_index);
+  if (chunk_index >= max_chunks_) return nullptr;
+  Chunk* chunk = &chunks_[chunk_index];
+  chunk->mutex.Lock();
+  if (chunk->seq != chunk_seq) {
+    chunk->mutex.Unlock();
+    return nullptr;
+  }
+  return chunk;
+}
+
+size_t TraceBufferPerThread::AcquireChunk() {
+  base::MutexGuard guard(&mutex_);
+  size_t chunk_index;
+  if (!free_chunks_.empty()) {
+    chunk_index = free_chunks_.back();
+    free_chunks_.pop_back();
+  } else if (next_unused_chunk_ < max_chunks_) {
+    chunk_index = next_unused_chunk_++;
+  } else {
+    return kNoChunk;
+  }
+  Chunk& chunk = chunks_[chunk_index];
+  uint32_t seq = current_chunk_seq_++;
+  base::MutexGuard chunk_guard(&chunk.mutex);
+  if (chunk.events) {
+    chunk.events->Reset(seq);
+  } else {
+    chunk.events.reset(new TraceBufferChunk(seq));
+  }
+  chunk.final_events.store(0, std::memory_order_relaxed);
+  chunk.seq = seq;
+  return chunk_index;
+}
+
+void TraceBufferPerThread::RetireChunk(size_t chunk_index) {
+  {
+    base::MutexGuard guard(&mutex_);
+    retired_chunks_.push_back(chunk_index);
+  }
+  chunks_retired_.Signal();
+}
+
+void TraceBufferPerThread::FreeChunk(size_t chunk_index) {
+  {
+    // Invalidates the handles of its events.
+    Chunk& chunk = chunks_[chunk_index];
+    base::MutexGuard chunk_guard(&chunk.mutex);
+    chunk.seq = 0;
+  }
+  free_chunks_.push_back(chunk_index);
+}
+
+void TraceBufferPerThread::WriteChunk(size_t chunk_index) {
+  Chunk& chunk = chunks_[chunk_index];
+  // Durations may still be updated while a chunk is flushed.
+  base::MutexGuard chunk_guard(&chunk.mutex);
+  TraceBufferChunk* events = chunk.events.get();
+  for (size_t i = 0; i < events->size(); ++i) {
+    trace_writer_->AppendTraceEvent(events->GetEventAt(i));
+  }
+}
+
+void TraceBufferPerThread::WriteFinalChunks() {
+  base::MutexGuard writer_guard(&writer_mutex_);
+  std::vector<size_t> final_chunks;
+  {
+    base::MutexGuard guard(&mutex_);
+    std::vector<size_t> pending_chunks;
+    for (size_t chunk_index : retired_chunks_) {
+      uint64_t final_events =
+          chunks_[chunk_index].final_events.load(std::memory_order_acquire);
+      if (final_events == kAllEventsFinal) {
+        final_chunks.push_back(chunk_index);
+      } else {
+        pending_chunks.push_back(chunk_index);
+      }
+    }
+    retired_chunks_.swap(pending_chunks);
+  }
+  if (final_chunks.empty()) return;
+  for (size_t chunk_index : final_chunks) WriteChunk(chunk_index);
+  base::MutexGuard guard(&mutex_);
+  for (size_t chunk_index : final_chunks) FreeChunk(chunk_index);
+}
+
+uint64_t TraceBufferPerThread::MakeHandle(size_t chunk_index,
+                                          uint32_t chunk_seq,
+                                          size_t event_index) const {
+  return static_cast<uint64_t>(chunk_seq) * Capacity() +
+         chunk_index * TraceBufferChunk::kChunkSize + event_index;
+}
+
+void TraceBufferPerThread::ExtractHandle(uint64_t handle, size_t* chunk_index,
+                                         uint32_t* chunk_seq,
+                                         size_t* event_index) const {
+  *chunk_seq = static_cast<uint32_t>(handle / Capacity());
+  size_t indices = handle % Capacity();
+  *chunk_index = indices / TraceBufferChunk::kChunkSize;
+  *event_index = indices % TraceBufferChunk::kChunkSize;
+}
+
 TraceBufferChunk::TraceBufferChunk(uint32_t seq) : seq_(seq) {}
 
 void TraceBufferChunk::Reset(uint32_t new_seq) {
@@ -102,6 +365,11 @@ TraceBuffer* TraceBuffer::CreateTraceBufferRingBuffer(
   return new TraceBufferRingBuffer(max_chunks, trace_writer);
 }
 
+TraceBuffer* TraceBuffer::CreateTraceBufferPerThread(
+    size_t max_chunks, TraceWriter* trace_writer) {
+  return new TraceBufferPerThread(max_chunks, trace_writer);
+}
+
 }  // namespace tracing
 }  // namespace platform
 }  // namespace v8
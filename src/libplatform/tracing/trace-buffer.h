@@ -5,11 +5,14 @@
 #ifndef V8_LIBPLATFORM_TRACING_TRACE_BUFFER_H_
 #define V8_LIBPLATFORM_TRACING_TRACE_BUFFER_H_
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
 #include "include/libplatform/v8-tracing.h"
 #include "src/base/platform/mutex.h"
+#include "src/base/platform/platform.h"
+#include "src/base/platform/semaphore.h"
 
 namespace v8 {
 namespace platform {
@@ -42,6 +45,95 @@ class TraceBufferRingBuffer : public TraceBuffer {
   uint32_t current_chunk_seq_ = 1;
 };
 
+// Every thread adds events to a chunk of its own, so adding an event only
+// takes a lock shared with other threads when the chunk is full. Full chunks
+// are handed to a background thread, which writes them to the TraceWriter once
+// the durations of all complete events in them have been updated. Flush()
+// takes the chunks threads are adding events to and writes them together with
+// the chunks still waiting for durations; threads then continue in new chunks.
+//
+// Events must be committed with CommitTraceEvent() by the thread that added
+// them before it adds the next one, which the TracingController does.
+class TraceBufferPerThread : public TraceBuffer {
+ public:
+  // Takes ownership of |trace_writer|.
+  TraceBufferPerThread(size_t max_chunks, TraceWriter* trace_writer);
+  ~TraceBufferPerThread() override;
+
+  TraceObject* AddTraceEvent(uint64_t* handle) override;
+  TraceObject* GetEventByHandle(uint64_t handle) override;
+  void CommitTraceEvent(uint64_t handle) override;
+  void UpdateTraceEventDuration(uint64_t handle, int64_t timestamp,
+                                int64_t cpu_timestamp) override;
+  bool IsPerThread() const override { return true; }
+  bool Flush() override;
+
+ private:
+  static const size_t kNoChunk = static_cast<size_t>(-1);
+
+  struct Chunk {
+    std::unique_ptr<TraceBufferChunk> events;
+    // Guards |seq| and keeps the chunk from being written out or reused while
+    // the duration of one of its events is updated.
+    base::Mutex mutex;
+    // Copy of events->seq() that can be checked while the chunk is reused by
+    // another thread.
+    uint32_t seq = 0;
+    // Bit i is set once event i has been committed for the last time.
+    std::atomic<uint64_t> final_events{0};
+  };
+
+  // The chunk a thread currently adds events to.
+  struct ThreadState {
+    // Held from AddTraceEvent() until the event is committed, and by Flush()
+    // while it takes the chunk.
+    base::Mutex mutex;
+    size_t chunk_index = kNoChunk;
+  };
+
+  class WriterThread;
+
+  ThreadState* GetThreadState();
+  // Returns the chunk that |handle| refers to if it has not been reused since,
+  // with its mutex held.
+  Chunk* LockChunk(uint64_t handle, size_t* event_index);
+  // Returns kNoChunk if all chunks are in use.
+  size_t AcquireChunk();
+  void RetireChunk(size_t chunk_index);
+  // Must be called with |mutex_| held.
+  void FreeChunk(size_t chunk_index);
+  // Must be called with |writer_mutex_| held.
+  void WriteChunk(size_t chunk_index);
+  // Writes the retired chunks whose events are final.
+  void WriteFinalChunks();
+
+  uint64_t MakeHandle(size_t chunk_index, uint32_t chunk_seq,
+                      size_t event_index) const;
+  void ExtractHandle(uint64_t handle, size_t* chunk_index, uint32_t* chunk_seq,
+                     size_t* event_index) const;
+  size_t Capacity() const { return max_chunks_ * TraceBufferChunk::kChunkSize; }
+
+  const size_t max_chunks_;
+  std::unique_ptr<TraceWriter> trace_writer_;
+  std::unique_ptr<Chunk[]> chunks_;
+  const base::Thread::LocalStorageKey state_key_;
+
+  // Guards the chunk lists and |thread_states_|. Only taken when a thread
+  // adds its first event or fills its chunk. Taken after the mutex of a
+  // ThreadState and before the mutex of a Chunk.
+  base::Mutex mutex_;
+  std::vector<size_t> free_chunks_;
+  size_t next_unused_chunk_ = 0;
+  std::vector<size_t> retired_chunks_;
+  std::vector<std::unique_ptr<ThreadState>> thread_states_;
+  uint32_t current_chunk_seq_ = 1;
+
+  // Serializes the use of |trace_writer_|, taken before all other mutexes.
+  base::Mutex writer_mutex_;
+  base::Semaphore chunks_retired_;
+  std::unique_ptr<WriterThread> writer_thread_;
+};
+
 }  // namespace tracing
 }  // namespace platform
 }  // namespace v8
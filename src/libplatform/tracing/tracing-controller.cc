@@ -141,12 +141,14 @@ uint64_t TracingController::AddTraceEventWithTimestamp(
     TraceObject* trace_object = trace_buffer_->AddTraceEvent(&handle);
     if (trace_object) {
       {
-        base::MutexGuard lock(mutex_.get());
+        base::LockGuard<base::Mutex, base::NullBehavior::kIgnoreIfNull> lock(
+            trace_buffer_->IsPerThread() ? nullptr : mutex_.get());
         trace_object->Initialize(phase, category_enabled_flag, name, scope, id,
                                  bind_id, num_args, arg_names, arg_types,
                                  arg_values, arg_convertables, flags, timestamp,
                                  cpu_now_us);
       }
+      trace_buffer_->CommitTraceEvent(handle);
     }
   }
   return handle;
@@ -157,9 +159,7 @@ void TracingController::UpdateTraceEventDuration(
   int64_t now_us = CurrentTimestampMicroseconds();
   int64_t cpu_now_us = CurrentCpuTimestampMicroseconds();
 
-  TraceObject* trace_object = trace_buffer_->GetEventByHandle(handle);
-  if (!trace_object) return;
-  trace_object->UpdateDuration(now_us, cpu_now_us);
+  trace_buffer_->UpdateTraceEventDuration(handle, now_us, cpu_now_us);
 }
 
 const char* TracingController::GetCategoryGroupName(
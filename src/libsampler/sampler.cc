@@ -225,7 +225,8 @@ void SamplerManager::RemoveSampler(Sampler* sampler) {
   }
 }
 
-void SamplerManager::DoSample(const v8::RegisterState& state) {
+void SamplerManager::DoSample(const v8::RegisterState& state,
+                              int signal_fd) {
   AtomicGuard atomic_guard(&samplers_access_counter_, false);
   // TODO(petermarshall): Add stat counters for the bailouts here.
   if (!atomic_guard.is_success()) return;
@@ -235,7 +236,11 @@ void SamplerManager::DoSample(const v8::RegisterState& state) {
   SamplerList& samplers = it->second;
 
   for (Sampler* sampler : samplers) {
-    if (!sampler->ShouldRecordSample()) continue;
+    if (signal_fd == Sampler::kNoSignalFd) {
+      if (!sampler->ShouldRecordSample()) continue;
+    } else if (sampler->signal_fd() != signal_fd) {
+      continue;
+    }
     Isolate* isolate = sampler->isolate();
     // We require a fully initialized and entered isolate.
     if (isolate == nullptr || !isolate->IsInUse()) continue;
@@ -362,11 +367,20 @@ bool SignalHandler::signal_handler_installed_ = false;
 
 void SignalHandler::HandleProfilerSignal(int signal, siginfo_t* info,
                                          void* context) {
-  USE(info);
   if (signal != SIGPROF) return;
   v8::RegisterState state;
   FillRegisterState(context, &state);
-  SamplerManager::instance()->DoSample(state);
+  int signal_fd = Sampler::kNoSignalFd;
+#if V8_OS_LINUX
+  // Signals queued for file descriptors with F_SETSIG carry the descriptor.
+  if (info != nullptr &&
+      (info->si_code == POLL_IN || info->si_code == POLL_HUP)) {
+    signal_fd = info->si_fd;
+  }
+#else
+  USE(info);
+#endif
+  SamplerManager::instance()->DoSample(state, signal_fd);
 }
 
 void SignalHandler::FillRegisterState(void* context, RegisterState* state) {
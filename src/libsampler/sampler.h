@@ -56,6 +56,16 @@ class V8_EXPORT_PRIVATE Sampler {
     return record_sample_.exchange(false, std::memory_order_relaxed);
   }
 
+  // Makes the sampler also take a sample whenever a SIGPROF raised for the
+  // file descriptor |fd| arrives on the sampled thread, as set up with
+  // F_SETSIG and F_SETOWN_EX. Used to sample on the overflow of hardware
+  // counters. Pass kNoSignalFd to stop. Only supported with signals.
+  static const int kNoSignalFd = -1;
+  void set_signal_fd(int fd) {
+    signal_fd_.store(fd, std::memory_order_relaxed);
+  }
+  int signal_fd() const { return signal_fd_.load(std::memory_order_relaxed); }
+
   void DoSample();
 
   // Used in tests to make sure that stack sampling is performed.
@@ -87,6 +97,7 @@ class V8_EXPORT_PRIVATE Sampler {
   Isolate* isolate_;
   std::atomic_bool active_{false};
   std::atomic_bool record_sample_{false};
+  std::atomic_int signal_fd_{kNoSignalFd};
   std::unique_ptr<PlatformData> data_;  // Platform specific data.
   DISALLOW_IMPLICIT_CONSTRUCTORS(Sampler);
 };
@@ -132,8 +143,10 @@ class V8_EXPORT_PRIVATE SamplerManager {
 
   // Take a sample for every sampler on the current thread. This function can
   // return without taking samples if AddSampler or RemoveSampler are being
-  // concurrently called on any thread.
-  void DoSample(const v8::RegisterState& state);
+  // concurrently called on any thread. If the signal was raised for a file
+  // descriptor, only the samplers waiting for |signal_fd| take a sample.
+  void DoSample(const v8::RegisterState& state,
+                int signal_fd = Sampler::kNoSignalFd);
 
   // Get the lazily instantiated, global SamplerManager instance.
   static SamplerManager* instance();
@@ -0,0 +1,194 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/logging/binary-log.h"
+
+#include "src/logging/code-events.h"
+#include "src/logging/log-utils.h"
+#include "src/utils/lock-free-queue-inl.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+#define DECLARE_EVENT(ignore1, name) #name,
+const char* const kEventNames[CodeEventListener::NUMBER_OF_LOG_EVENTS] = {
+    LOG_EVENTS_AND_TAGS_LIST(DECLARE_EVENT)};
+#undef DECLARE_EVENT
+
+void AppendVarint(std::vector<uint8_t>* data, uint64_t value) {
+  while (value >= 0x80) {
+    data->push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  data->push_back(static_cast<uint8_t>(value));
+}
+
+}  // namespace
+
+constexpr char BinaryLogWriter::kMagic[];
+constexpr uint32_t BinaryLogWriter::kVersion;
+constexpr size_t BinaryLogWriter::kChunkSize;
+
+class BinaryLogWriter::WriterThread : public base::Thread {
+ public:
+  explicit WriterThread(BinaryLogWriter* writer)
+      : Thread(Options("v8:BinaryLogWriter")), writer_(writer) {}
+
+  void Run() override {
+    while (true) {
+      writer_->chunks_available_.Wait();
+      writer_->WritePendingChunks();
+      if (stopping_.load(std::memory_order_acquire)) return;
+    }
+  }
+
+  void Stop() {
+    stopping_.store(true, std::memory_order_release);
+    writer_->chunks_available_.Signal();
+    Join();
+  }
+
+ private:
+  BinaryLogWriter* const writer_;
+  std::atomic<bool> stopping_{false};
+};
+
+BinaryLogWriter::ThreadBuffer::ThreadBuffer(BinaryLogWriter* writer)
+    : writer_(writer) {}
+
+bool BinaryLogWriter::ThreadBuffer::Begin() {
+  DCHECK(!in_use_.load(std::memory_order_relaxed));
+  in_use_.store(true, std::memory_order_relaxed);
+  // Pairs with the fence in Close(): either Close() sees this buffer in use
+  // and waits for the record, or this thread sees that the log is closed.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (writer_->closed_.load(std::memory_order_relaxed)) {
+    in_use_.store(false, std::memory_order_release);
+    return false;
+  }
+  if (!format_buffer_) {
+    data_.reserve(kChunkSize);
+    format_buffer_.reset(NewArray<char>(Log::kMessageBufferSize));
+  }
+  return true;
+}
+
+void BinaryLogWriter::ThreadBuffer::StartRecord(RecordType type) {
+  DCHECK(in_use_.load(std::memory_order_relaxed));
+  WriteVarint(writer_->next_sequence_number_.fetch_add(
+      1, std::memory_order_relaxed));
+  data_.push_back(type);
+}
+
+void BinaryLogWriter::ThreadBuffer::End() {
+  DCHECK(in_use_.load(std::memory_order_relaxed));
+  if (data_.size() >= kChunkSize) {
+    auto chunk = new std::vector<uint8_t>();
+    chunk->reserve(kChunkSize);
+    data_.swap(*chunk);
+    writer_->EnqueueChunk(chunk);
+  }
+  in_use_.store(false, std::memory_order_release);
+}
+
+void BinaryLogWriter::ThreadBuffer::Release() {
+  DCHECK(!in_use_.load(std::memory_order_relaxed));
+  std::vector<uint8_t>().swap(data_);
+  std::ostringstream().swap(text_stream_);
+  format_buffer_.reset();
+}
+
+void BinaryLogWriter::ThreadBuffer::WriteVarint(uint64_t value) {
+  AppendVarint(&data_, value);
+}
+
+void BinaryLogWriter::ThreadBuffer::WriteString(const char* data,
+                                                size_t length) {
+  WriteVarint(length);
+  data_.insert(data_.end(), data, data + length);
+}
+
+BinaryLogWriter::BinaryLogWriter(FILE* output)
+    : output_(output),
+      buffer_key_(base::Thread::CreateThreadLocalKey()),
+      chunks_available_(0),
+      writer_thread_(new WriterThread(this)) {
+  WriteHeader();
+  CHECK(writer_thread_->Start());
+}
+
+BinaryLogWriter::~BinaryLogWriter() {
+  Close();
+  base::Thread::DeleteThreadLocalKey(buffer_key_);
+}
+
+void BinaryLogWriter::WriteHeader() {
+  std::vector<uint8_t> header(kMagic, kMagic + arraysize(kMagic));
+  AppendVarint(&header, kVersion);
+  AppendVarint(&header, CodeEventListener::NUMBER_OF_LOG_EVENTS);
+  for (const char* name : kEventNames) {
+    size_t length = strlen(name);
+    AppendVarint(&header, length);
+    header.insert(header.end(), name, name + length);
+  }
+  fwrite(header.data(), 1, header.size(), output_);
+}
+
+BinaryLogWriter::ThreadBuffer* BinaryLogWriter::GetThreadBuffer() {
+  void* buffer = base::Thread::GetThreadLocal(buffer_key_);
+  if (V8_LIKELY(buffer != nullptr)) return static_cast<ThreadBuffer*>(buffer);
+  base::MutexGuard guard(&buffers_mutex_);
+  buffers_.emplace_back(new ThreadBuffer(this));
+  ThreadBuffer* new_buffer = buffers_.back().get();
+  base::Thread::SetThreadLocal(buffer_key_, new_buffer);
+  return new_buffer;
+}
+
+void BinaryLogWriter::EnqueueChunk(std::vector<uint8_t>* chunk) {
+  chunks_.Enqueue(chunk);
+  chunks_available_.Signal();
+}
+
+void BinaryLogWriter::WriteChunk(const std::vector<uint8_t>& chunk) {
+  std::vector<uint8_t> size;
+  AppendVarint(&size, chunk.size());
+  fwrite(size.data(), 1, size.size(), output_);
+  fwrite(chunk.data(), 1, chunk.size(), output_);
+}
+
+void BinaryLogWriter::WritePendingChunks() {
+  std::vector<uint8_t>* chunk;
+  while (chunks_.Dequeue(&chunk)) {
+    WriteChunk(*chunk);
+    delete chunk;
+  }
+}
+
+void BinaryLogWriter::Close() {
+  if (closed_.exchange(true, std::memory_order_relaxed)) return;
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  writer_thread_->Stop();
+  // The writer thread is gone, this thread is now the only consumer.
+  WritePendingChunks();
+
+  base::MutexGuard guard(&buffers_mutex_);
+  for (const std::unique_ptr<ThreadBuffer>& buffer : buffers_) {
+    while (buffer->in_use_.load(std::memory_order_acquire)) {
+      base::OS::Sleep(base::TimeDelta::FromMicroseconds(100));
+    }
+    if (!buffer->data_.empty()) WriteChunk(buffer->data_);
+    // Threads that exit do not tell the log, so this is where the memory of
+    // their buffers is given back. No record is written after the loop
+    // above, since Begin() fails from now on.
+    buffer->Release();
+  }
+  // Chunks enqueued by records that were in progress above.
+  WritePendingChunks();
+  fflush(output_);
+}
+
+}  // namespace internal
+}  // namespace v8
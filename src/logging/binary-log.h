@@ -0,0 +1,129 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_LOGGING_BINARY_LOG_H_
+#define V8_LOGGING_BINARY_LOG_H_
+
+#include <stdio.h>
+
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/platform.h"
+#include "src/base/platform/semaphore.h"
+#include "src/common/globals.h"
+#include "src/utils/lock-free-queue.h"
+
+namespace v8 {
+namespace internal {
+
+// Writes the log in the binary format enabled by --log-binary, which
+// tools/binary-log-converter.py turns back into the text format.
+//
+// Every thread appends records to its own buffer without taking a lock. Full
+// buffers are handed to a background thread which writes them to the file,
+// so threads only block on the file system when the log is closed.
+//
+// The file starts with the magic "V8BL", the format version and the table of
+// event names. The rest of the file is a sequence of chunks, each one being
+// the varint-encoded payload size followed by the records of one thread
+// buffer. A record is a varint sequence number, the record type and its
+// fields, with all integers varint encoded. Since chunks of different
+// threads are written in the order in which they fill up, the sequence
+// numbers are used to restore the original order of the records.
+class BinaryLogWriter {
+ public:
+  enum RecordType : uint8_t {
+    // A log line as formatted by Log::MessageBuilder, without newline:
+    // length, bytes.
+    kText = 0,
+    // code-creation: tag, kind, timestamp, address, size, followed by the
+    // remaining columns as formatted text (length, bytes).
+    kCodeCreation = 1,
+    // code-move and sfi-move: event, from, to.
+    kMove = 2,
+    // tick: pc, timestamp, has_external_callback, external callback or top of
+    // stack, vm state, overflow, frame count, frames.
+    kTick = 3,
+  };
+
+  static constexpr char kMagic[4] = {'V', '8', 'B', 'L'};
+  static constexpr uint32_t kVersion = 1;
+
+  // The records of a single thread.
+  class ThreadBuffer {
+   public:
+    // Must bracket the writing of records. Begin returns false if the log has
+    // been closed, in which case nothing must be written.
+    bool Begin();
+    void End();
+
+    void StartRecord(RecordType type);
+
+    void WriteVarint(uint64_t value);
+    void WriteString(const char* data, size_t length);
+
+    // Used by Log::MessageBuilder to format text into.
+    std::ostringstream& text_stream() { return text_stream_; }
+    char* format_buffer() { return format_buffer_.get(); }
+
+   private:
+    explicit ThreadBuffer(BinaryLogWriter* writer);
+
+    // Frees the memory of the buffer once the log is closed.
+    void Release();
+
+    BinaryLogWriter* const writer_;
+    std::vector<uint8_t> data_;
+    std::atomic<bool> in_use_{false};
+    std::ostringstream text_stream_;
+    std::unique_ptr<char[]> format_buffer_;
+
+    friend class BinaryLogWriter;
+  };
+
+  explicit BinaryLogWriter(FILE* output);
+  ~BinaryLogWriter();
+
+  // Returns the buffer of the current thread, creating it if necessary.
+  ThreadBuffer* GetThreadBuffer();
+
+  // Stops accepting records, waits for records in progress, writes all
+  // pending data to the file and frees the memory of the thread buffers.
+  void Close();
+
+ private:
+  // Thread buffers are flushed once they reach this size.
+  static constexpr size_t kChunkSize = 64 * KB;
+
+  class WriterThread;
+
+  void WriteHeader();
+  void EnqueueChunk(std::vector<uint8_t>* chunk);
+  void WriteChunk(const std::vector<uint8_t>& chunk);
+  void WritePendingChunks();
+
+  FILE* const output_;
+  std::atomic<uint64_t> next_sequence_number_{0};
+  std::atomic<bool> closed_{false};
+
+  const base::Thread::LocalStorageKey buffer_key_;
+  // Guards |buffers_|, only taken when a thread logs for the first time.
+  base::Mutex buffers_mutex_;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+
+  LockFreeQueue<std::vector<uint8_t>*> chunks_;
+  base::Semaphore chunks_available_;
+  std::unique_ptr<WriterThread> writer_thread_;
+
+  DISALLOW_COPY_AND_ASSIGN(BinaryLogWriter);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_LOGGING_BINARY_LOG_H_
@@ -5,6 +5,9 @@
 #ifndef V8_LOGGING_COUNTERS_INL_H_
 #define V8_LOGGING_COUNTERS_INL_H_
 
+#include <algorithm>
+
+#include "src/base/bits.h"
 #include "src/logging/counters.h"
 #include "src/logging/tracing-flags.h"
 
@@ -42,6 +45,9 @@ RuntimeCallTimer* RuntimeCallTimer::Stop() {
   base::TimeTicks now = RuntimeCallTimer::Now();
   Pause(now);
   counter_->Increment();
+  if (V8_UNLIKELY(counter_->has_histogram())) {
+    counter_->AddToHistogram(elapsed_);
+  }
   CommitTimeToCounter();
 
   RuntimeCallTimer* parent_timer = parent();
@@ -58,6 +64,18 @@ void RuntimeCallTimer::CommitTimeToCounter() {
 
 bool RuntimeCallTimer::IsStarted() { return start_ticks_ != base::TimeTicks(); }
 
+void RuntimeCallCounter::AddToHistogram(base::TimeDelta delta) {
+  DCHECK(has_histogram());
+  int64_t microseconds = delta.InMicroseconds();
+  int bucket = 0;
+  if (microseconds > 0) {
+    int log2 = 63 - base::bits::CountLeadingZeros64(
+        static_cast<uint64_t>(microseconds));
+    bucket = std::min(1 + log2 / 2, kHistogramBuckets - 1);
+  }
+  histogram_[bucket]++;
+}
+
 }  // namespace internal
 }  // namespace v8
 
@@ -4,6 +4,7 @@
 
 #include "src/logging/counters.h"
 
+#include <algorithm>
 #include <iomanip>
 
 #include "src/base/platform/platform.h"
@@ -399,6 +400,9 @@ class RuntimeCallStatEntries {
 void RuntimeCallCounter::Reset() {
   count_ = 0;
   time_ = 0;
+  if (histogram_ != nullptr) {
+    std::fill(histogram_, histogram_ + kHistogramBuckets, 0);
+  }
 }
 
 void RuntimeCallCounter::Dump(v8::tracing::TracedValue* value) {
@@ -411,6 +415,11 @@ void RuntimeCallCounter::Dump(v8::tracing::TracedValue* value) {
 void RuntimeCallCounter::Add(RuntimeCallCounter* other) {
   count_ += other->count();
   time_ += other->time().InMicroseconds();
+  if (histogram_ != nullptr && other->histogram_ != nullptr) {
+    for (int i = 0; i < kHistogramBuckets; i++) {
+      histogram_[i] += other->histogram_[i];
+    }
+  }
 }
 
 void RuntimeCallTimer::Snapshot() {
@@ -514,6 +523,9 @@ void RuntimeCallStats::Leave(RuntimeCallTimer* timer) {
 }
 
 void RuntimeCallStats::Add(RuntimeCallStats* other) {
+  if (other->histograms_ != nullptr && histograms_ == nullptr) {
+    AllocateHistograms();
+  }
   for (int i = 0; i < kNumberOfCounters; i++) {
     GetCounter(i)->Add(other->GetCounter(i));
   }
@@ -568,6 +580,38 @@ void RuntimeCallStats::EnumerateCounters(
   }
 }
 
+void RuntimeCallStats::TakeHistograms(
+    debug::RuntimeCallHistogramCallback callback) {
+  if (current_timer_.Value() != nullptr) {
+    current_timer_.Value()->Snapshot();
+  }
+  for (int i = 0; i < kNumberOfCounters; i++) {
+    RuntimeCallCounter* counter = GetCounter(i);
+    if (counter->count() == 0 && counter->time().IsZero()) continue;
+    debug::RuntimeCallCounterHistogram histogram = {};
+    histogram.name = counter->name();
+    histogram.count = counter->count();
+    histogram.time = counter->time();
+    if (counter->has_histogram()) {
+      std::copy(counter->histogram(),
+                counter->histogram() + RuntimeCallCounter::kHistogramBuckets,
+                histogram.buckets);
+    }
+    callback(histogram);
+    counter->Reset();
+  }
+}
+
+void RuntimeCallStats::AllocateHistograms() {
+  DCHECK_NULL(histograms_);
+  const int size = kNumberOfCounters * RuntimeCallCounter::kHistogramBuckets;
+  histograms_.reset(new int64_t[size]());
+  for (int i = 0; i < kNumberOfCounters; i++) {
+    GetCounter(i)->histogram_ =
+        &histograms_[i * RuntimeCallCounter::kHistogramBuckets];
+  }
+}
+
 void RuntimeCallStats::Reset() {
   if (V8_LIKELY(!TracingFlags::is_runtime_stats_enabled())) return;
 
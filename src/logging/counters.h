@@ -661,6 +661,15 @@ class RuntimeCallCounter final {
   void Increment() { count_++; }
   void Add(base::TimeDelta delta) { time_ += delta.InMicroseconds(); }
 
+  // Histogram of the own times of individual calls. Bucket 0 counts calls
+  // shorter than 1us, bucket i calls of [4^(i-1), 4^i) microseconds, and the
+  // last bucket all longer calls.
+  static constexpr int kHistogramBuckets =
+      debug::RuntimeCallCounterHistogram::kBucketCount;
+  bool has_histogram() const { return histogram_ != nullptr; }
+  const int64_t* histogram() const { return histogram_; }
+  inline void AddToHistogram(base::TimeDelta delta);
+
  private:
   friend class RuntimeCallStats;
 
@@ -668,6 +677,9 @@ class RuntimeCallCounter final {
   int64_t count_;
   // Stored as int64_t so that its initialization can be deferred.
   int64_t time_;
+  // Points into RuntimeCallStats::histograms_ once the owning table keeps
+  // histograms, see RuntimeCallStats::ShouldRecordScope.
+  int64_t* histogram_ = nullptr;
 };
 
 // RuntimeCallTimer is used to keep track of the stack of currently active
@@ -895,6 +907,7 @@ class RuntimeCallTimer final {
   ADD_THREAD_SPECIFIC_COUNTER(V, Optimize, AllocateGeneralRegisters)        \
   ADD_THREAD_SPECIFIC_COUNTER(V, Optimize, AssembleCode)                    \
   ADD_THREAD_SPECIFIC_COUNTER(V, Optimize, AssignSpillSlots)                \
+  ADD_THREAD_SPECIFIC_COUNTER(V, Optimize, BoundsCheckElimination)          \
   ADD_THREAD_SPECIFIC_COUNTER(V, Optimize, BuildLiveRangeBundles)           \
   ADD_THREAD_SPECIFIC_COUNTER(V, Optimize, BuildLiveRanges)                 \
   ADD_THREAD_SPECIFIC_COUNTER(V, Optimize, CommitAssignment)                \
@@ -922,8 +935,11 @@ class RuntimeCallTimer final {
   ADD_THREAD_SPECIFIC_COUNTER(V, Optimize, LateOptimization)                \
   ADD_THREAD_SPECIFIC_COUNTER(V, Optimize, LoadElimination)                 \
   ADD_THREAD_SPECIFIC_COUNTER(V, Optimize, LocateSpillSlots)                \
+  ADD_THREAD_SPECIFIC_COUNTER(V, Optimize, LoopCheckHoisting)               \
   ADD_THREAD_SPECIFIC_COUNTER(V, Optimize, LoopExitElimination)             \
   ADD_THREAD_SPECIFIC_COUNTER(V, Optimize, LoopPeeling)                     \
+  ADD_THREAD_SPECIFIC_COUNTER(V, Optimize, LoopUnrolling)                   \
+  ADD_THREAD_SPECIFIC_COUNTER(V, Optimize, LoopVectorization)               \
   ADD_THREAD_SPECIFIC_COUNTER(V, Optimize, MachineOperatorOptimization)     \
   ADD_THREAD_SPECIFIC_COUNTER(V, Optimize, MeetRegisterConstraints)         \
   ADD_THREAD_SPECIFIC_COUNTER(V, Optimize, MemoryOptimization)              \
@@ -1148,6 +1164,34 @@ class RuntimeCallStats final {
   V8_EXPORT_PRIVATE void EnumerateCounters(
       debug::RuntimeCallCounterCallback callback);
 
+  // Reports all counters that recorded calls since the last call, together
+  // with their histograms, and resets them. Unlike Reset(), this leaves the
+  // active timers running.
+  V8_EXPORT_PRIVATE void TakeHistograms(
+      debug::RuntimeCallHistogramCallback callback);
+
+  // Decides whether a RuntimeCallTimerScope that is about to be entered is
+  // recorded. Runtime call stats that are only enabled by
+  // debug::StartSampledRuntimeCallStats() with a sampling interval of N only
+  // record every Nth scope entered while no other scope is recorded, together
+  // with all scopes nested in it, so that own times remain exact. Sampled
+  // tables keep per-counter histograms. Runtime call stats enabled by flags or
+  // tracing record all scopes.
+  bool ShouldRecordScope() {
+    using v8::tracing::TracingCategoryObserver;
+    if (V8_LIKELY(TracingFlags::runtime_stats.load(std::memory_order_relaxed) !=
+                  TracingCategoryObserver::ENABLED_BY_SAMPLED_STATS) ||
+        current_timer_.Value() != nullptr) {
+      return true;
+    }
+    unsigned interval = TracingFlags::runtime_stats_sampling_interval.load(
+        std::memory_order_relaxed);
+    if (++skipped_scopes_ < interval) return false;
+    skipped_scopes_ = 0;
+    if (V8_UNLIKELY(histograms_ == nullptr)) AllocateHistograms();
+    return true;
+  }
+
   ThreadId thread_id() const { return thread_id_; }
   RuntimeCallTimer* current_timer() { return current_timer_.Value(); }
   RuntimeCallCounter* current_counter() { return current_counter_.Value(); }
@@ -1190,6 +1234,8 @@ class RuntimeCallStats final {
   }
 
  private:
+  V8_NOINLINE void AllocateHistograms();
+
   // Top of a stack of active timers.
   base::AtomicValue<RuntimeCallTimer*> current_timer_;
   // Active counter object associated with current timer.
@@ -1199,6 +1245,11 @@ class RuntimeCallStats final {
   ThreadType thread_type_;
   ThreadId thread_id_;
   RuntimeCallCounter counters_[kNumberOfCounters];
+  // Number of outermost scopes skipped since the last sampled one.
+  unsigned skipped_scopes_ = 0;
+  // kHistogramBuckets entries per counter, allocated when the table is first
+  // sampled.
+  std::unique_ptr<int64_t[]> histograms_;
 };
 
 class WorkerThreadRuntimeCallStats final {
@@ -1268,12 +1319,13 @@ class RuntimeCallTimerScope {
                   stats == nullptr)) {
       return;
     }
-    stats_ = stats;
     if (mode == RuntimeCallStats::CounterMode::kThreadSpecific) {
       counter_id = stats->CounterIdForThread(counter_id);
     }
 
     DCHECK(stats->IsCounterAppropriateForThread(counter_id));
+    if (!stats->ShouldRecordScope()) return;
+    stats_ = stats;
     stats_->Enter(&timer_, counter_id);
   }
 
@@ -1488,7 +1540,9 @@ void HistogramTimer::Stop() {
 RuntimeCallTimerScope::RuntimeCallTimerScope(Isolate* isolate,
                                              RuntimeCallCounterId counter_id) {
   if (V8_LIKELY(!TracingFlags::is_runtime_stats_enabled())) return;
-  stats_ = isolate->counters()->runtime_call_stats();
+  RuntimeCallStats* stats = isolate->counters()->runtime_call_stats();
+  if (!stats->ShouldRecordScope()) return;
+  stats_ = stats;
   stats_->Enter(&timer_, counter_id);
 }
 
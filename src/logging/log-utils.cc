@@ -32,7 +32,8 @@ FILE* Log::CreateOutputHandle(std::string file_name) {
   } else if (Log::IsLoggingToTemporaryFile(file_name)) {
     return base::OS::OpenTemporaryFile();
   } else {
-    return base::OS::FOpen(file_name.c_str(), base::OS::LogFileOpenMode);
+    return base::OS::FOpen(file_name.c_str(),
+                           FLAG_log_binary ? "wb" : base::OS::LogFileOpenMode);
   }
 }
 
@@ -52,11 +53,19 @@ Log::Log(Logger* logger, std::string file_name)
       output_handle_(Log::CreateOutputHandle(file_name)),
       os_(output_handle_ == nullptr ? stdout : output_handle_),
       format_buffer_(NewArray<char>(kMessageBufferSize)) {
+  if (output_handle_ && FLAG_log_binary) {
+    binary_writer_.reset(new BinaryLogWriter(output_handle_));
+  }
   if (output_handle_) WriteLogHeader();
 }
 
 void Log::WriteLogHeader() {
-  Log::MessageBuilder msg(this);
+  BinaryLogWriter::ThreadBuffer* binary_buffer = nullptr;
+  if (is_binary()) {
+    binary_buffer = binary_writer_->GetThreadBuffer();
+    CHECK(binary_buffer->Begin());
+  }
+  Log::MessageBuilder msg(this, binary_buffer);
   LogSeparator kNext = LogSeparator::kSeparator;
   msg << "v8-version" << kNext << Version::GetMajor() << kNext
       << Version::GetMinor() << kNext << Version::GetBuild() << kNext
@@ -73,7 +82,15 @@ std::unique_ptr<Log::MessageBuilder> Log::NewMessageBuilder() {
   // logging isn't enabled.
   if (!logger_->is_logging()) return {};
 
-  std::unique_ptr<Log::MessageBuilder> result(new Log::MessageBuilder(this));
+  if (is_binary()) {
+    BinaryLogWriter::ThreadBuffer* buffer = BeginBinaryRecords();
+    if (!buffer) return {};
+    return std::unique_ptr<Log::MessageBuilder>(
+        new Log::MessageBuilder(this, buffer));
+  }
+
+  std::unique_ptr<Log::MessageBuilder> result(
+      new Log::MessageBuilder(this, nullptr));
 
   // The first invocation of is_logging() might still read an old value. It is
   // fine if a background thread starts logging a bit later, but we want to
@@ -84,8 +101,17 @@ std::unique_ptr<Log::MessageBuilder> Log::NewMessageBuilder() {
   return result;
 }
 
+BinaryLogWriter::ThreadBuffer* Log::BeginBinaryRecords() {
+  DCHECK(is_binary());
+  if (!logger_->is_logging()) return nullptr;
+  BinaryLogWriter::ThreadBuffer* buffer = binary_writer_->GetThreadBuffer();
+  if (!buffer->Begin()) return nullptr;
+  return buffer;
+}
+
 FILE* Log::Close() {
   FILE* result = nullptr;
+  if (binary_writer_) binary_writer_->Close();
   if (output_handle_ != nullptr) {
     fflush(output_handle_);
     result = output_handle_;
@@ -97,8 +123,32 @@ FILE* Log::Close() {
 
 std::string Log::file_name() const { return file_name_; }
 
-Log::MessageBuilder::MessageBuilder(Log* log)
-    : log_(log), lock_guard_(&log_->mutex_) {
+Log::MessageBuilder::MessageBuilder(
+    Log* log, BinaryLogWriter::ThreadBuffer* binary_buffer)
+    : log_(log),
+      binary_buffer_(binary_buffer),
+      lock_guard_(binary_buffer ? nullptr : &log_->mutex_),
+      os_(binary_buffer ? &binary_buffer->text_stream() : &log_->os_),
+      format_buffer_(binary_buffer ? binary_buffer->format_buffer()
+                                   : log_->format_buffer_.get()) {
+  if (binary_buffer_) binary_buffer_->text_stream().str(std::string());
+}
+
+Log::MessageBuilder::~MessageBuilder() {
+  if (binary_buffer_) binary_buffer_->End();
+}
+
+bool Log::MessageBuilder::AppendBinaryCodeCreateHeader(
+    CodeEventListener::LogEventsAndTags tag, int kind, int64_t timestamp,
+    Address address, int size) {
+  if (!binary_buffer_) return false;
+  is_code_creation_ = true;
+  code_creation_tag_ = tag;
+  code_creation_kind_ = kind;
+  code_creation_timestamp_ = timestamp;
+  code_creation_address_ = address;
+  code_creation_size_ = size;
+  return true;
 }
 
 void Log::MessageBuilder::AppendString(String str,
@@ -150,8 +200,8 @@ void Log::MessageBuilder::AppendFormatString(const char* format, ...) {
   const int length = FormatStringIntoBuffer(format, args);
   va_end(args);
   for (int i = 0; i < length; i++) {
-    DCHECK_NE(log_->format_buffer_[i], '\0');
-    AppendCharacter(log_->format_buffer_[i]);
+    DCHECK_NE(format_buffer_[i], '\0');
+    AppendCharacter(format_buffer_[i]);
   }
 }
 
@@ -185,7 +235,7 @@ void Log::MessageBuilder::AppendCharacter(char c) {
 
 void Log::MessageBuilder::AppendSymbolName(Symbol symbol) {
   DCHECK(!symbol.is_null());
-  OFStream& os = log_->os_;
+  std::ostream& os = *os_;
   os << "symbol(";
   if (!symbol.description().IsUndefined()) {
     os << "\"";
@@ -200,7 +250,7 @@ void Log::MessageBuilder::AppendSymbolNameDetails(String str,
   if (str.is_null()) return;
 
   DisallowHeapAllocation no_gc;  // Ensure string stays valid.
-  OFStream& os = log_->os_;
+  std::ostream& os = *os_;
   int limit = str.length();
   if (limit > 0x1000) limit = 0x1000;
   if (show_impl_info) {
@@ -214,7 +264,7 @@ void Log::MessageBuilder::AppendSymbolNameDetails(String str,
 
 int Log::MessageBuilder::FormatStringIntoBuffer(const char* format,
                                                 va_list args) {
-  Vector<char> buf(log_->format_buffer_.get(), Log::kMessageBufferSize);
+  Vector<char> buf(format_buffer_, Log::kMessageBufferSize);
   int length = v8::internal::VSNPrintF(buf, format, args);
   // |length| is -1 if output was truncated.
   if (length == -1) length = Log::kMessageBufferSize;
@@ -229,15 +279,32 @@ void Log::MessageBuilder::AppendRawFormatString(const char* format, ...) {
   const int length = FormatStringIntoBuffer(format, args);
   va_end(args);
   for (int i = 0; i < length; i++) {
-    DCHECK_NE(log_->format_buffer_[i], '\0');
-    AppendRawCharacter(log_->format_buffer_[i]);
+    DCHECK_NE(format_buffer_[i], '\0');
+    AppendRawCharacter(format_buffer_[i]);
   }
 }
 
-void Log::MessageBuilder::AppendRawCharacter(char c) { log_->os_ << c; }
+void Log::MessageBuilder::AppendRawCharacter(char c) { *os_ << c; }
 
 void Log::MessageBuilder::WriteToLogFile() {
-  log_->os_ << std::endl;
+  if (!binary_buffer_) {
+    log_->os_ << std::endl;
+    return;
+  }
+  std::string text = binary_buffer_->text_stream().str();
+  if (is_code_creation_) {
+    binary_buffer_->StartRecord(BinaryLogWriter::kCodeCreation);
+    binary_buffer_->WriteVarint(code_creation_tag_);
+    binary_buffer_->WriteVarint(code_creation_kind_);
+    binary_buffer_->WriteVarint(code_creation_timestamp_);
+    binary_buffer_->WriteVarint(code_creation_address_);
+    binary_buffer_->WriteVarint(code_creation_size_);
+  } else {
+    binary_buffer_->StartRecord(BinaryLogWriter::kText);
+  }
+  binary_buffer_->WriteString(text.data(), text.size());
+  binary_buffer_->text_stream().str(std::string());
+  is_code_creation_ = false;
 }
 
 template <>
@@ -249,7 +316,7 @@ Log::MessageBuilder& Log::MessageBuilder::operator<<<const char*>(
 
 template <>
 Log::MessageBuilder& Log::MessageBuilder::operator<<<void*>(void* pointer) {
-  OFStream& os = log_->os_;
+  std::ostream& os = *os_;
   // Manually format the pointer since on Windows we do not consistently
   // get a "0x" prefix.
   os << "0x" << std::hex << reinterpret_cast<intptr_t>(pointer) << std::dec;
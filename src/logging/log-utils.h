@@ -15,6 +15,8 @@
 #include "src/base/optional.h"
 #include "src/base/platform/mutex.h"
 #include "src/flags/flags.h"
+#include "src/logging/binary-log.h"
+#include "src/logging/code-events.h"
 #include "src/utils/allocation.h"
 #include "src/utils/ostreams.h"
 
@@ -51,6 +53,10 @@ class Log {
 
   std::string file_name() const;
 
+  // Whether the log is written in the binary format, see BinaryLogWriter.
+  bool is_binary() const { return binary_writer_ != nullptr; }
+  BinaryLogWriter* binary_writer() const { return binary_writer_.get(); }
+
   // Size of buffer used for formatting log messages.
   static const int kMessageBufferSize = 2048;
 
@@ -60,10 +66,12 @@ class Log {
   static const char* const kLogToConsole;
 
   // Utility class for formatting log messages. It escapes the given messages
-  // and then appends them to the static buffer in Log.
+  // and then appends them to the static buffer in Log. For binary logs the
+  // message is formatted into the buffer of the current thread instead, and
+  // no lock is taken.
   class MessageBuilder {
    public:
-    ~MessageBuilder() = default;
+    ~MessageBuilder();
 
     void AppendString(String str,
                       base::Optional<int> length_limit = base::nullopt);
@@ -79,17 +87,24 @@ class Log {
     // All appended strings are escaped to maintain one-line log entries.
     template <typename T>
     MessageBuilder& operator<<(T value) {
-      log_->os_ << value;
+      *os_ << value;
       return *this;
     }
 
+    // For binary logs, records the leading columns of a code-creation event
+    // in binary form, the rest of the message is appended as text. Returns
+    // false for text logs, where the caller formats the columns itself.
+    bool AppendBinaryCodeCreateHeader(CodeEventListener::LogEventsAndTags tag,
+                                      int kind, int64_t timestamp,
+                                      Address address, int size);
+
     // Finish the current log line an flush the it to the log file.
     void WriteToLogFile();
 
    private:
     // Create a message builder starting from position 0.
-    // This acquires the mutex in the log as well.
-    explicit MessageBuilder(Log* log);
+    // This acquires the mutex in the log as well, unless the log is binary.
+    MessageBuilder(Log* log, BinaryLogWriter::ThreadBuffer* binary_buffer);
 
     // Prints the format string into |log_->format_buffer_|. Returns the length
     // of the result, or kMessageBufferSize if it was truncated.
@@ -102,7 +117,19 @@ class Log {
     void AppendRawCharacter(const char character);
 
     Log* log_;
-    base::MutexGuard lock_guard_;
+    BinaryLogWriter::ThreadBuffer* const binary_buffer_;
+    base::LockGuard<base::Mutex, base::NullBehavior::kIgnoreIfNull>
+        lock_guard_;
+    std::ostream* const os_;
+    char* const format_buffer_;
+
+    // Columns of a code-creation event in a binary log.
+    bool is_code_creation_ = false;
+    CodeEventListener::LogEventsAndTags code_creation_tag_;
+    int code_creation_kind_;
+    int64_t code_creation_timestamp_;
+    Address code_creation_address_;
+    int code_creation_size_;
 
     friend class Log;
   };
@@ -111,6 +138,11 @@ class Log {
   // will return null if logging is disabled.
   std::unique_ptr<Log::MessageBuilder> NewMessageBuilder();
 
+  // For binary logs, returns the buffer of the current thread to write
+  // binary records to, which must be followed by a call to End() on it.
+  // Returns null if logging is disabled.
+  BinaryLogWriter::ThreadBuffer* BeginBinaryRecords();
+
  private:
   static FILE* CreateOutputHandle(std::string file_name);
   base::Mutex* mutex() { return &mutex_; }
@@ -135,6 +167,9 @@ class Log {
   // mutex_ should be acquired before using it.
   std::unique_ptr<char[]> format_buffer_;
 
+  // Only set with --log-binary.
+  std::unique_ptr<BinaryLogWriter> binary_writer_;
+
   friend class Logger;
 };
 
@@ -1193,6 +1193,11 @@ void AppendCodeCreateHeader(
     Log::MessageBuilder& msg,  // NOLINT(runtime/references)
     CodeEventListener::LogEventsAndTags tag, CodeKind kind, uint8_t* address,
     int size, base::ElapsedTimer* timer) {
+  if (msg.AppendBinaryCodeCreateHeader(
+          tag, static_cast<int>(kind), timer->Elapsed().InMicroseconds(),
+          reinterpret_cast<Address>(address), size)) {
+    return;
+  }
   msg << kLogEventsNames[CodeEventListener::CODE_CREATION_EVENT]
       << Logger::kNext << kLogEventsNames[tag] << Logger::kNext
       << static_cast<int>(kind) << Logger::kNext
@@ -1541,6 +1546,16 @@ void Logger::CodeNameEvent(Address addr, int pos, const char* code_name) {
 void Logger::MoveEventInternal(LogEventsAndTags event, Address from,
                                Address to) {
   if (!FLAG_log_code) return;
+  if (log_->is_binary()) {
+    BinaryLogWriter::ThreadBuffer* buffer = log_->BeginBinaryRecords();
+    if (!buffer) return;
+    buffer->StartRecord(BinaryLogWriter::kMove);
+    buffer->WriteVarint(event);
+    buffer->WriteVarint(from);
+    buffer->WriteVarint(to);
+    buffer->End();
+    return;
+  }
   std::unique_ptr<Log::MessageBuilder> msg_ptr = log_->NewMessageBuilder();
   if (!msg_ptr) return;
   Log::MessageBuilder& msg = *msg_ptr.get();
@@ -1728,6 +1743,25 @@ void Logger::TickEvent(TickSample* sample, bool overflow) {
                   v8::tracing::TracingCategoryObserver::ENABLED_BY_NATIVE)) {
     RuntimeCallTimerEvent();
   }
+  if (log_->is_binary()) {
+    BinaryLogWriter::ThreadBuffer* buffer = log_->BeginBinaryRecords();
+    if (!buffer) return;
+    buffer->StartRecord(BinaryLogWriter::kTick);
+    buffer->WriteVarint(reinterpret_cast<Address>(sample->pc));
+    buffer->WriteVarint(timer_.Elapsed().InMicroseconds());
+    buffer->WriteVarint(sample->has_external_callback);
+    buffer->WriteVarint(reinterpret_cast<Address>(
+        sample->has_external_callback ? sample->external_callback_entry
+                                      : sample->tos));
+    buffer->WriteVarint(static_cast<int>(sample->state));
+    buffer->WriteVarint(overflow);
+    buffer->WriteVarint(sample->frames_count);
+    for (unsigned i = 0; i < sample->frames_count; ++i) {
+      buffer->WriteVarint(reinterpret_cast<Address>(sample->stack[i]));
+    }
+    buffer->End();
+    return;
+  }
   std::unique_ptr<Log::MessageBuilder> msg_ptr = log_->NewMessageBuilder();
   if (!msg_ptr) return;
   Log::MessageBuilder& msg = *msg_ptr.get();
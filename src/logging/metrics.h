@@ -28,6 +28,9 @@ class Recorder : public std::enable_shared_from_this<Recorder> {
 
   V8_EXPORT_PRIVATE void NotifyIsolateDisposal();
 
+  // Allows callers to skip collecting event data nobody is interested in.
+  bool HasEmbedderRecorder() const { return embedder_recorder_ != nullptr; }
+
   template <class T>
   void AddMainThreadEvent(const T& event,
                           v8::metrics::Recorder::ContextId id) {
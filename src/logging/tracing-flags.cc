@@ -12,6 +12,7 @@ std::atomic_uint TracingFlags::gc{0};
 std::atomic_uint TracingFlags::gc_stats{0};
 std::atomic_uint TracingFlags::ic_stats{0};
 std::atomic_uint TracingFlags::zone_stats{0};
+std::atomic_uint TracingFlags::runtime_stats_sampling_interval{0};
 
 }  // namespace internal
 }  // namespace v8
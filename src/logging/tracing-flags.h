@@ -22,6 +22,10 @@ struct TracingFlags {
   static V8_EXPORT_PRIVATE std::atomic_uint gc_stats;
   static V8_EXPORT_PRIVATE std::atomic_uint ic_stats;
   static V8_EXPORT_PRIVATE std::atomic_uint zone_stats;
+  // When non-zero and runtime call stats are only enabled by
+  // debug::StartSampledRuntimeCallStats(), they only record every Nth
+  // outermost RuntimeCallTimerScope, see RuntimeCallStats::ShouldRecordScope.
+  static V8_EXPORT_PRIVATE std::atomic_uint runtime_stats_sampling_interval;
 
   static bool is_runtime_stats_enabled() {
     return runtime_stats.load(std::memory_order_relaxed) != 0;
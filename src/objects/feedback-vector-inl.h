@@ -67,6 +67,7 @@ int FeedbackMetadata::GetSlotSize(FeedbackSlotKind kind) {
     case FeedbackSlotKind::kBinaryOp:
     case FeedbackSlotKind::kLiteral:
     case FeedbackSlotKind::kTypeProfile:
+    case FeedbackSlotKind::kBranchCounter:
       return 1;
 
     case FeedbackSlotKind::kCall:
@@ -188,6 +188,8 @@ const char* FeedbackMetadata::Kind2String(FeedbackSlotKind kind) {
       return "InstanceOf";
     case FeedbackSlotKind::kCloneObject:
       return "CloneObject";
+    case FeedbackSlotKind::kBranchCounter:
+      return "BranchCounter";
     case FeedbackSlotKind::kKindsNumber:
       break;
   }
@@ -280,6 +282,7 @@ Handle<FeedbackVector> FeedbackVector::New(
       case FeedbackSlotKind::kForIn:
       case FeedbackSlotKind::kCompareOp:
       case FeedbackSlotKind::kBinaryOp:
+      case FeedbackSlotKind::kBranchCounter:
         vector->Set(slot, Smi::zero(), SKIP_WRITE_BARRIER);
         break;
       case FeedbackSlotKind::kLiteral:
@@ -514,6 +517,7 @@ bool FeedbackNexus::Clear() {
     case FeedbackSlotKind::kCompareOp:
     case FeedbackSlotKind::kForIn:
     case FeedbackSlotKind::kBinaryOp:
+    case FeedbackSlotKind::kBranchCounter:
       // We don't clear these, either.
       break;
 
@@ -755,6 +759,10 @@ InlineCacheState FeedbackNexus::ic_state() const {
       return POLYMORPHIC;
     }
 
+    case FeedbackSlotKind::kBranchCounter: {
+      return GetBranchCount() == 0 ? UNINITIALIZED : MONOMORPHIC;
+    }
+
     case FeedbackSlotKind::kInvalid:
     case FeedbackSlotKind::kKindsNumber:
       UNREACHABLE();
@@ -1203,6 +1211,11 @@ ForInHint FeedbackNexus::GetForInFeedback() const {
   return ForInHintFromFeedback(feedback);
 }
 
+int FeedbackNexus::GetBranchCount() const {
+  DCHECK(IsBranchCounterKind(kind()));
+  return GetFeedback().ToSmi().value();
+}
+
 MaybeHandle<JSObject> FeedbackNexus::GetConstructorFeedback() const {
   DCHECK_EQ(kind(), FeedbackSlotKind::kInstanceOf);
   Isolate* isolate = GetIsolate();
@@ -59,6 +59,7 @@ enum class FeedbackSlotKind {
   kForIn,
   kInstanceOf,
   kCloneObject,
+  kBranchCounter,
 
   kKindsNumber  // Last value indicating number of kinds.
 };
@@ -126,6 +127,10 @@ inline bool IsCloneObjectKind(FeedbackSlotKind kind) {
   return kind == FeedbackSlotKind::kCloneObject;
 }
 
+inline bool IsBranchCounterKind(FeedbackSlotKind kind) {
+  return kind == FeedbackSlotKind::kBranchCounter;
+}
+
 inline TypeofMode GetTypeofModeFromSlotKind(FeedbackSlotKind kind) {
   DCHECK(IsLoadGlobalICKind(kind));
   return (kind == FeedbackSlotKind::kLoadGlobalInsideTypeof)
@@ -418,6 +423,10 @@ class V8_EXPORT_PRIVATE FeedbackVectorSpec {
     return AddSlot(FeedbackSlotKind::kCloneObject);
   }
 
+  FeedbackSlot AddBranchCounterSlot() {
+    return AddSlot(FeedbackSlotKind::kBranchCounter);
+  }
+
 #ifdef OBJECT_PRINT
   // For gdb debugging.
   void Print();
@@ -667,6 +676,9 @@ class V8_EXPORT_PRIVATE FeedbackNexus final {
   CompareOperationHint GetCompareOperationFeedback() const;
   ForInHint GetForInFeedback() const;
 
+  // For branch counters, the number of times the branch was taken.
+  int GetBranchCount() const;
+
   // For KeyedLoad ICs.
   KeyedAccessLoadMode GetKeyedAccessLoadMode() const;
 
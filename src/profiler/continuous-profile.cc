@@ -0,0 +1,279 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/profiler/continuous-profile.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "src/base/functional.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// Field numbers from pprof's profile.proto.
+enum ProfileField {
+  kProfileSampleType = 1,
+  kProfileSample = 2,
+  kProfileLocation = 4,
+  kProfileFunction = 5,
+  kProfileStringTable = 6,
+  kProfileTimeNanos = 9,
+  kProfileDurationNanos = 10,
+  kProfilePeriodType = 11,
+  kProfilePeriod = 12,
+};
+
+enum ValueTypeField { kValueTypeType = 1, kValueTypeUnit = 2 };
+
+enum SampleField { kSampleLocationId = 1, kSampleValue = 2 };
+
+enum LocationField { kLocationId = 1, kLocationLine = 4 };
+
+enum LineField { kLineFunctionId = 1, kLineLine = 2 };
+
+enum FunctionField {
+  kFunctionId = 1,
+  kFunctionName = 2,
+  kFunctionSystemName = 3,
+  kFunctionFilename = 4,
+  kFunctionStartLine = 5,
+};
+
+// Minimal protobuf wire format encoder, sufficient for the messages above.
+// Nested messages are encoded into their own writer and then appended as a
+// length-delimited field.
+class ProtoWriter {
+ public:
+  void WriteVarintField(int field, uint64_t value) {
+    WriteTag(field, kVarint);
+    WriteVarint(value);
+  }
+
+  void WriteBytesField(int field, const uint8_t* data, size_t size) {
+    WriteTag(field, kLengthDelimited);
+    WriteVarint(size);
+    buffer_.insert(buffer_.end(), data, data + size);
+  }
+
+  void WriteStringField(int field, const char* str) {
+    WriteBytesField(field, reinterpret_cast<const uint8_t*>(str), strlen(str));
+  }
+
+  void WriteMessageField(int field, const ProtoWriter& message) {
+    WriteBytesField(field, message.buffer_.data(), message.buffer_.size());
+  }
+
+  template <typename T>
+  void WritePackedVarintField(int field, const std::vector<T>& values) {
+    ProtoWriter packed;
+    for (T value : values) packed.WriteVarint(static_cast<uint64_t>(value));
+    WriteMessageField(field, packed);
+  }
+
+  std::vector<uint8_t>& buffer() { return buffer_; }
+
+ private:
+  enum WireType { kVarint = 0, kLengthDelimited = 2 };
+
+  void WriteTag(int field, WireType type) {
+    WriteVarint((static_cast<uint64_t>(field) << 3) | type);
+  }
+
+  void WriteVarint(uint64_t value) {
+    while (value >= 0x80) {
+      buffer_.push_back(static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    buffer_.push_back(static_cast<uint8_t>(value));
+  }
+
+  std::vector<uint8_t> buffer_;
+};
+
+void WriteValueType(ProtoWriter* writer, int field, uint64_t type,
+                    uint64_t unit) {
+  ProtoWriter value_type;
+  value_type.WriteVarintField(kValueTypeType, type);
+  value_type.WriteVarintField(kValueTypeUnit, unit);
+  writer->WriteMessageField(field, value_type);
+}
+
+}  // namespace
+
+size_t ContinuousProfile::StackHasher::operator()(const Stack& stack) const {
+  size_t hash = 0;
+  for (uint64_t location_id : stack) {
+    hash = base::hash_combine(hash, location_id);
+  }
+  return hash;
+}
+
+size_t ContinuousProfile::FunctionKeyHasher::operator()(
+    const FunctionKey& key) const {
+  return base::hash_combine(key.name, key.resource_name, key.start_line);
+}
+
+ContinuousProfile::ContinuousProfile(v8::ContinuousProfileDelegate* delegate,
+                                     base::TimeDelta flush_interval,
+                                     size_t max_stacks)
+    : delegate_(delegate),
+      flush_interval_(flush_interval),
+      max_stacks_(max_stacks) {
+  DCHECK_NOT_NULL(delegate_);
+  DCHECK_LT(0u, max_stacks_);
+  Reset();
+}
+
+void ContinuousProfile::Reset() {
+  stacks_.clear();
+  strings_.clear();
+  string_ids_.clear();
+  functions_.clear();
+  function_ids_.clear();
+  locations_.clear();
+  location_ids_.clear();
+  strings_.push_back("");
+  string_ids_.emplace(strings_[0], 0);
+  window_start_ = base::TimeTicks();
+}
+
+uint64_t ContinuousProfile::StringId(const char* str) {
+  auto it = string_ids_.find(str);
+  if (it != string_ids_.end()) return it->second;
+  uint64_t id = strings_.size();
+  strings_.push_back(str);
+  string_ids_.emplace(str, id);
+  return id;
+}
+
+uint64_t ContinuousProfile::LocationId(const CodeEntryAndLineNumber& frame) {
+  CodeEntry* entry = frame.code_entry;
+  FunctionKey key = {entry->name(), entry->resource_name(),
+                     entry->line_number()};
+  uint64_t function_id;
+  auto function_it = function_ids_.find(key);
+  if (function_it != function_ids_.end()) {
+    function_id = function_it->second;
+  } else {
+    functions_.push_back(
+        {StringId(key.name), StringId(key.resource_name), key.start_line});
+    function_id = functions_.size();
+    function_ids_.emplace(key, function_id);
+  }
+
+  int line = std::max(frame.line_number, 0);
+  uint64_t location_key = (function_id << 32) | static_cast<uint32_t>(line);
+  auto location_it = location_ids_.find(location_key);
+  if (location_it != location_ids_.end()) return location_it->second;
+  locations_.push_back({function_id, line});
+  uint64_t location_id = locations_.size();
+  location_ids_.emplace(location_key, location_id);
+  return location_id;
+}
+
+void ContinuousProfile::AddSample(base::TimeTicks timestamp,
+                                  const ProfileStackTrace& path,
+                                  base::TimeDelta sampling_interval) {
+  if (window_start_.IsNull()) {
+    window_start_ = timestamp;
+    window_start_js_time_ = base::Time::Now().ToJsTime();
+  }
+  window_end_ = timestamp;
+  sampling_interval_ = sampling_interval;
+
+  Stack stack;
+  stack.reserve(path.size());
+  // The path starts at the leaf frame, which is also what pprof expects.
+  for (const CodeEntryAndLineNumber& frame : path) {
+    if (frame.code_entry == nullptr) continue;
+    stack.push_back(LocationId(frame));
+  }
+  Counts& counts = stacks_[std::move(stack)];
+  counts.samples++;
+  counts.cpu_nanos += sampling_interval.InNanoseconds();
+}
+
+bool ContinuousProfile::IsWindowFull(base::TimeTicks now) const {
+  if (stacks_.empty()) return false;
+  return stacks_.size() >= max_stacks_ ||
+         now - window_start_ >= flush_interval_;
+}
+
+std::vector<uint8_t> ContinuousProfile::TakeChunk() {
+  if (stacks_.empty()) return {};
+  std::vector<uint8_t> chunk = Serialize();
+  Reset();
+  return chunk;
+}
+
+std::vector<uint8_t> ContinuousProfile::Serialize() const {
+  // The strings naming the sample values are appended after the interned
+  // ones, so that the tables of the window are left untouched.
+  static const char* const kSamples = "samples";
+  static const char* const kCount = "count";
+  static const char* const kCpu = "cpu";
+  static const char* const kNanoseconds = "nanoseconds";
+  uint64_t samples_id = strings_.size();
+  uint64_t count_id = samples_id + 1;
+  uint64_t cpu_id = samples_id + 2;
+  uint64_t nanoseconds_id = samples_id + 3;
+
+  ProtoWriter profile;
+  WriteValueType(&profile, kProfileSampleType, samples_id, count_id);
+  WriteValueType(&profile, kProfileSampleType, cpu_id, nanoseconds_id);
+
+  for (const auto& pair : stacks_) {
+    ProtoWriter sample;
+    sample.WritePackedVarintField(kSampleLocationId, pair.first);
+    sample.WritePackedVarintField(
+        kSampleValue,
+        std::vector<int64_t>{pair.second.samples, pair.second.cpu_nanos});
+    profile.WriteMessageField(kProfileSample, sample);
+  }
+
+  for (size_t i = 0; i < locations_.size(); i++) {
+    ProtoWriter line;
+    line.WriteVarintField(kLineFunctionId, locations_[i].function_id);
+    line.WriteVarintField(kLineLine, locations_[i].line);
+    ProtoWriter location;
+    location.WriteVarintField(kLocationId, i + 1);
+    location.WriteMessageField(kLocationLine, line);
+    profile.WriteMessageField(kProfileLocation, location);
+  }
+
+  for (size_t i = 0; i < functions_.size(); i++) {
+    const Function& function = functions_[i];
+    ProtoWriter message;
+    message.WriteVarintField(kFunctionId, i + 1);
+    message.WriteVarintField(kFunctionName, function.name);
+    message.WriteVarintField(kFunctionSystemName, function.name);
+    message.WriteVarintField(kFunctionFilename, function.filename);
+    message.WriteVarintField(kFunctionStartLine,
+                             std::max(function.start_line, 0));
+    profile.WriteMessageField(kProfileFunction, message);
+  }
+
+  for (const char* str : strings_) {
+    profile.WriteStringField(kProfileStringTable, str);
+  }
+  for (const char* str : {kSamples, kCount, kCpu, kNanoseconds}) {
+    profile.WriteStringField(kProfileStringTable, str);
+  }
+
+  int64_t time_nanos = static_cast<int64_t>(
+      window_start_js_time_ * base::Time::kNanosecondsPerMicrosecond *
+      base::Time::kMicrosecondsPerMillisecond);
+  profile.WriteVarintField(kProfileTimeNanos, time_nanos);
+  profile.WriteVarintField(kProfileDurationNanos,
+                           (window_end_ - window_start_).InNanoseconds());
+  WriteValueType(&profile, kProfilePeriodType, cpu_id, nanoseconds_id);
+  profile.WriteVarintField(kProfilePeriod, sampling_interval_.InNanoseconds());
+  return std::move(profile.buffer());
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,115 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_PROFILER_CONTINUOUS_PROFILE_H_
+#define V8_PROFILER_CONTINUOUS_PROFILE_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "include/v8-profiler.h"
+#include "src/base/platform/time.h"
+#include "src/profiler/profile-generator.h"
+
+namespace v8 {
+namespace internal {
+
+// Aggregates symbolized samples by stack for continuous profiling. Instead of
+// growing a ProfileTree for the lifetime of the profile, the samples of the
+// current window are kept as stack -> count, and the window is periodically
+// handed to the embedder as a serialized pprof Profile message, see
+// https://github.com/google/pprof/blob/master/proto/profile.proto.
+//
+// Frames are resolved to pprof functions and locations as samples arrive, so
+// that no CodeEntry is referenced after the sample has been added; code
+// entries may be deleted by the CodeMap at any time while profiling.
+//
+// Samples are added on the profiler thread, under the lock protecting the
+// current profiles in CpuProfilesCollection. The serialized windows are
+// taken under that lock too, but handed to the delegate by the caller after
+// releasing it.
+class V8_EXPORT_PRIVATE ContinuousProfile {
+ public:
+  ContinuousProfile(v8::ContinuousProfileDelegate* delegate,
+                    base::TimeDelta flush_interval, size_t max_stacks);
+
+  void AddSample(base::TimeTicks timestamp, const ProfileStackTrace& path,
+                 base::TimeDelta sampling_interval);
+  // Whether the current window holds samples and, as of |now|, has become
+  // too long or contains too many distinct stacks.
+  bool IsWindowFull(base::TimeTicks now) const;
+  // Serializes the current window and starts a new one. Returns an empty
+  // chunk if the window is empty.
+  std::vector<uint8_t> TakeChunk();
+
+  v8::ContinuousProfileDelegate* delegate() const { return delegate_; }
+  size_t stack_count() const { return stacks_.size(); }
+
+ private:
+  // Location ids of a stack, leaf first.
+  using Stack = std::vector<uint64_t>;
+  struct StackHasher {
+    size_t operator()(const Stack& stack) const;
+  };
+  struct Counts {
+    int64_t samples;
+    int64_t cpu_nanos;
+  };
+  struct Function {
+    uint64_t name;
+    uint64_t filename;
+    int start_line;
+  };
+  struct FunctionKey {
+    const char* name;
+    const char* resource_name;
+    int start_line;
+    bool operator==(const FunctionKey& other) const {
+      return name == other.name && resource_name == other.resource_name &&
+             start_line == other.start_line;
+    }
+  };
+  struct FunctionKeyHasher {
+    size_t operator()(const FunctionKey& key) const;
+  };
+  struct Location {
+    uint64_t function_id;
+    int line;
+  };
+
+  uint64_t StringId(const char* str);
+  uint64_t LocationId(const CodeEntryAndLineNumber& frame);
+  std::vector<uint8_t> Serialize() const;
+  void Reset();
+
+  v8::ContinuousProfileDelegate* const delegate_;
+  const base::TimeDelta flush_interval_;
+  const size_t max_stacks_;
+
+  // Tables of the current window. Ids are 1-based indices into functions_
+  // and locations_, and 0-based indices into strings_ whose first entry is
+  // the empty string, as required by pprof. Strings are owned by the
+  // StringsStorage instances of the profiler and outlive the profile.
+  std::unordered_map<Stack, Counts, StackHasher> stacks_;
+  std::vector<const char*> strings_;
+  std::unordered_map<const char*, uint64_t> string_ids_;
+  std::vector<Function> functions_;
+  std::unordered_map<FunctionKey, uint64_t, FunctionKeyHasher> function_ids_;
+  std::vector<Location> locations_;
+  std::unordered_map<uint64_t, uint64_t> location_ids_;
+
+  base::TimeTicks window_start_;
+  base::TimeTicks window_end_;
+  // Wall clock time of the window start in milliseconds, pprof reports
+  // absolute times.
+  double window_start_js_time_ = 0;
+  base::TimeDelta sampling_interval_;
+
+  DISALLOW_COPY_AND_ASSIGN(ContinuousProfile);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_PROFILER_CONTINUOUS_PROFILE_H_
@@ -4,6 +4,8 @@
 
 #include "src/profiler/cpu-profiler.h"
 
+#include <algorithm>
+#include <iterator>
 #include <unordered_map>
 #include <utility>
 
@@ -17,8 +19,10 @@
 #include "src/logging/counters.h"
 #include "src/logging/log.h"
 #include "src/profiler/cpu-profiler-inl.h"
+#include "src/profiler/hardware-counters.h"
 #include "src/profiler/profiler-stats.h"
 #include "src/profiler/symbolizer.h"
+#include "src/utils/lock-free-queue-inl.h"
 #include "src/utils/locked-queue-inl.h"
 #include "src/wasm/wasm-engine.h"
 
@@ -53,6 +57,12 @@ class CpuSampler : public sampler::Sampler {
     sample->Init(isolate, regs, TickSample::kIncludeCEntryFrame,
                  /* update_stats */ true,
                  /* use_simulator_reg_state */ true, processor_->period());
+    HardwareCounters* counters = processor_->hardware_counters();
+    if (counters != nullptr) {
+      counters->ReadDeltas(sample->counters);
+    } else {
+      std::fill(std::begin(sample->counters), std::end(sample->counters), 0);
+    }
     if (is_counting_samples_ && !sample->timestamp.IsNull()) {
       if (sample->state == JS) ++js_sample_count_;
       if (sample->state == EXTERNAL) ++external_sample_count_;
@@ -121,7 +131,21 @@ SamplingEventsProcessor::SamplingEventsProcessor(
   sampler_->Start();
 }
 
-SamplingEventsProcessor::~SamplingEventsProcessor() { sampler_->Stop(); }
+SamplingEventsProcessor::~SamplingEventsProcessor() {
+  if (counters_) {
+    counters_->Disable();
+    sampler_->set_signal_fd(sampler::Sampler::kNoSignalFd);
+  }
+  sampler_->Stop();
+}
+
+void SamplingEventsProcessor::SetHardwareCounters(
+    std::unique_ptr<HardwareCounters> counters) {
+  DCHECK(!counters_);
+  counters_ = std::move(counters);
+  sampler_->set_signal_fd(counters_->signal_fd());
+  counters_->Enable();
+}
 
 ProfilerEventsProcessor::~ProfilerEventsProcessor() {
   DCHECK_EQ(code_observer_->processor(), this);
@@ -217,7 +241,8 @@ void SamplingEventsProcessor::SymbolizeAndAddToProfiles(
       symbolizer_->SymbolizeTickSample(record->sample);
   profiles_->AddPathToCurrentProfiles(
       record->sample.timestamp, symbolized.stack_trace, symbolized.src_line,
-      record->sample.update_stats, record->sample.sampling_interval);
+      record->sample.update_stats, record->sample.sampling_interval,
+      record->sample.counters);
 }
 
 ProfilerEventsProcessor::SampleProcessingResult
@@ -254,7 +279,11 @@ void SamplingEventsProcessor::Run() {
     // Keep processing existing events until we need to do next sample
     // or the ticks buffer is empty.
     do {
-      result = ProcessOneSample();
+      // Symbolize samples in batches to amortize reading the clock.
+      int processed = 0;
+      do {
+        result = ProcessOneSample();
+      } while (result == OneSampleProcessed && ++processed < kSampleBatchSize);
       if (result == FoundSampleForNextCodeEvent) {
         // All ticks of the current last_processed_code_event_id_ are
         // processed, proceed to the next code event.
@@ -262,6 +291,7 @@ void SamplingEventsProcessor::Run() {
       }
       now = base::TimeTicks::HighResolutionNow();
     } while (result != NoSamplesInQueue && now < nextSampleTime);
+    profiles_->FlushContinuousProfileIfDue(now);
 
     if (nextSampleTime > now) {
 #if V8_OS_WIN
@@ -291,8 +321,8 @@ void SamplingEventsProcessor::Run() {
       }
     }
 
-    // Schedule next sample.
-    sampler_->DoSample();
+    // Schedule next sample, unless the hardware counters trigger them.
+    if (!counters_) sampler_->DoSample();
   }
 
   // Process remaining tick events.
@@ -390,6 +420,9 @@ CpuProfile* CpuProfiler::GetProfile(int index) {
 
 
 void CpuProfiler::DeleteAllProfiles() {
+  // Deliver the pending window of a continuous profile, which is deleted
+  // with the other profiles.
+  StopContinuousProfiling();
   if (is_profiling_) StopProcessor();
   ResetProfiles();
 }
@@ -483,6 +516,15 @@ void CpuProfiler::set_use_precise_sampling(bool value) {
   use_precise_sampling_ = value;
 }
 
+bool CpuProfiler::SetHardwareCounterSampling(v8::CpuProfilingCounter trigger,
+                                             uint64_t period) {
+  DCHECK(!is_profiling_);
+  if (period != 0 && !HardwareCounters::New(trigger, period)) return false;
+  counter_trigger_ = trigger;
+  counter_period_ = period;
+  return true;
+}
+
 void CpuProfiler::ResetProfiles() {
   profiles_.reset(new CpuProfilesCollection(isolate_));
   profiles_->set_cpu_profiler(this);
@@ -559,9 +601,17 @@ void CpuProfiler::StartProcessorIfNotStarted() {
   }
 
   base::TimeDelta sampling_interval = ComputeSamplingInterval();
-  processor_.reset(new SamplingEventsProcessor(
+  SamplingEventsProcessor* processor = new SamplingEventsProcessor(
       isolate_, symbolizer_.get(), &code_observer_, profiles_.get(),
-      sampling_interval, use_precise_sampling_));
+      sampling_interval, use_precise_sampling_);
+  processor_.reset(processor);
+  if (counter_period_ != 0) {
+    // The counters are opened for the calling thread, which is the one the
+    // sampler was created for.
+    std::unique_ptr<HardwareCounters> counters =
+        HardwareCounters::New(counter_trigger_, counter_period_);
+    if (counters) processor->SetHardwareCounters(std::move(counters));
+  }
   is_profiling_ = true;
 
   // Enable stack sampling.
@@ -581,6 +631,28 @@ CpuProfile* CpuProfiler::StopProfiling(String title) {
   return StopProfiling(profiles_->GetName(title));
 }
 
+bool CpuProfiler::StartContinuousProfiling(
+    v8::ContinuousProfileDelegate* delegate, base::TimeDelta flush_interval,
+    size_t max_stacks) {
+  if (!profiles_->StartContinuousProfiling(delegate, flush_interval,
+                                           max_stacks)) {
+    return false;
+  }
+  TRACE_EVENT0("v8", "CpuProfiler::StartContinuousProfiling");
+  AdjustSamplingInterval();
+  StartProcessorIfNotStarted();
+  return true;
+}
+
+void CpuProfiler::StopContinuousProfiling() {
+  if (!profiles_->is_continuous_profiling()) return;
+  // Stop the processor first if nothing else needs it, so that the last
+  // window can be flushed without racing with the profiler thread.
+  if (is_profiling_ && !profiles_->HasCurrentProfiles()) StopProcessor();
+  profiles_->StopContinuousProfiling();
+  AdjustSamplingInterval();
+}
+
 void CpuProfiler::StopProcessorIfLastProfile(const char* title) {
   if (!profiles_->IsLastProfile(title)) return;
   StopProcessor();
@@ -14,6 +14,7 @@
 #include "src/profiler/circular-queue.h"
 #include "src/profiler/profiler-listener.h"
 #include "src/profiler/tick-sample.h"
+#include "src/utils/lock-free-queue.h"
 #include "src/utils/locked-queue.h"
 
 namespace v8 {
@@ -26,6 +27,7 @@ namespace internal {
 class CodeEntry;
 class CodeMap;
 class CpuProfilesCollection;
+class HardwareCounters;
 class Isolate;
 class Symbolizer;
 
@@ -183,7 +185,9 @@ class V8_EXPORT_PRIVATE ProfilerEventsProcessor : public base::Thread,
   std::atomic_bool running_{true};
   base::ConditionVariable running_cond_;
   base::Mutex running_mutex_;
-  LockedQueue<CodeEventsContainer> events_buffer_;
+  // Code events may be produced by several threads (e.g. wasm compilation),
+  // but are only consumed by the processor thread.
+  LockFreeQueue<CodeEventsContainer> events_buffer_;
   LockedQueue<TickSampleEventRecord> ticks_from_vm_buffer_;
   std::atomic<unsigned> last_code_event_id_;
   unsigned last_processed_code_event_id_;
@@ -208,6 +212,12 @@ class V8_EXPORT_PRIVATE SamplingEventsProcessor
 
   void SetSamplingInterval(base::TimeDelta period) override;
 
+  // Takes samples on the overflow of |counters| instead of on the sampling
+  // interval. Must be called on the sampled thread before the processor is
+  // started.
+  void SetHardwareCounters(std::unique_ptr<HardwareCounters> counters);
+  HardwareCounters* hardware_counters() const { return counters_.get(); }
+
   // Tick sample events are filled directly in the buffer of the circular
   // queue (because the structure is of fixed width, but usually not all
   // stack frame entries are filled.) This method returns a pointer to the
@@ -224,12 +234,15 @@ class V8_EXPORT_PRIVATE SamplingEventsProcessor
   SampleProcessingResult ProcessOneSample() override;
   void SymbolizeAndAddToProfiles(const TickSampleEventRecord* record);
 
+  // Number of samples symbolized between checks of the sampling deadline.
+  static const int kSampleBatchSize = 16;
   static const size_t kTickSampleBufferSize = 512 * KB;
   static const size_t kTickSampleQueueLength =
       kTickSampleBufferSize / sizeof(TickSampleEventRecord);
   SamplingCircularQueue<TickSampleEventRecord,
                         kTickSampleQueueLength> ticks_buffer_;
   std::unique_ptr<sampler::Sampler> sampler_;
+  std::unique_ptr<HardwareCounters> counters_;
   CpuProfilesCollection* profiles_;
   base::TimeDelta period_;           // Samples & code events processing period.
   const bool use_precise_sampling_;  // Whether or not busy-waiting is used for
@@ -311,12 +324,18 @@ class V8_EXPORT_PRIVATE CpuProfiler {
   base::TimeDelta sampling_interval() const { return base_sampling_interval_; }
   void set_sampling_interval(base::TimeDelta value);
   void set_use_precise_sampling(bool);
+  bool SetHardwareCounterSampling(v8::CpuProfilingCounter trigger,
+                                  uint64_t period);
   void CollectSample();
   void StartProfiling(const char* title, CpuProfilingOptions options = {});
   void StartProfiling(String title, CpuProfilingOptions options = {});
 
   CpuProfile* StopProfiling(const char* title);
   CpuProfile* StopProfiling(String title);
+  bool StartContinuousProfiling(v8::ContinuousProfileDelegate* delegate,
+                                base::TimeDelta flush_interval,
+                                size_t max_stacks);
+  void StopContinuousProfiling();
   int GetProfilesCount();
   CpuProfile* GetProfile(int index);
   void DeleteAllProfiles();
@@ -351,6 +370,9 @@ class V8_EXPORT_PRIVATE CpuProfiler {
   const NamingMode naming_mode_;
   const LoggingMode logging_mode_;
   bool use_precise_sampling_ = true;
+  // Hardware counter sampling is used if the period is not zero.
+  v8::CpuProfilingCounter counter_trigger_ = v8::kCpuCycles;
+  uint64_t counter_period_ = 0;
   // Sampling interval to which per-profile sampling intervals will be clamped
   // to a multiple of, or used as the default if unspecified.
   base::TimeDelta base_sampling_interval_;
@@ -0,0 +1,146 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/profiler/hardware-counters.h"
+
+#if V8_OS_LINUX
+#include <fcntl.h>
+#include <linux/perf_event.h>
+#include <signal.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif  // V8_OS_LINUX
+
+#include "src/base/platform/platform.h"
+
+namespace v8 {
+namespace internal {
+
+HardwareCounters::HardwareCounters(CpuProfilingCounter trigger)
+    : trigger_(trigger) {
+  for (int i = 0; i < kCount; i++) {
+    fds_[i] = -1;
+    group_index_[i] = -1;
+  }
+}
+
+#if V8_OS_LINUX
+
+namespace {
+
+uint64_t EventConfig(int counter) {
+  switch (counter) {
+    case kCpuCycles:
+      return PERF_COUNT_HW_CPU_CYCLES;
+    case kCpuCacheMisses:
+      return PERF_COUNT_HW_CACHE_MISSES;
+    case kCpuBranchMisses:
+      return PERF_COUNT_HW_BRANCH_MISSES;
+  }
+  UNREACHABLE();
+}
+
+int OpenCounter(int counter, pid_t tid, uint64_t period, int group_fd) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = EventConfig(counter);
+  attr.sample_period = period;
+  attr.read_format = PERF_FORMAT_GROUP;
+  // The group counts while the leader is enabled.
+  attr.disabled = group_fd == -1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return static_cast<int>(syscall(__NR_perf_event_open, &attr, tid, -1,
+                                  group_fd, PERF_FLAG_FD_CLOEXEC));
+}
+
+}  // namespace
+
+// static
+std::unique_ptr<HardwareCounters> HardwareCounters::New(
+    CpuProfilingCounter trigger, uint64_t period) {
+  DCHECK_LT(0u, period);
+  pid_t tid = static_cast<pid_t>(base::OS::GetCurrentThreadId());
+  std::unique_ptr<HardwareCounters> counters(new HardwareCounters(trigger));
+  int leader = OpenCounter(trigger, tid, period, -1);
+  if (leader == -1) return nullptr;
+  counters->fds_[trigger] = leader;
+  counters->group_index_[trigger] = counters->group_size_++;
+  for (int i = 0; i < kCount; i++) {
+    if (i == trigger) continue;
+    int fd = OpenCounter(i, tid, 0, leader);
+    if (fd == -1) continue;
+    counters->fds_[i] = fd;
+    counters->group_index_[i] = counters->group_size_++;
+  }
+
+  // Raise SIGPROF on this thread whenever the leader overflows.
+  struct f_owner_ex owner;
+  owner.type = F_OWNER_TID;
+  owner.pid = tid;
+  if (fcntl(leader, F_SETOWN_EX, &owner) == -1 ||
+      fcntl(leader, F_SETSIG, SIGPROF) == -1 ||
+      fcntl(leader, F_SETFL, fcntl(leader, F_GETFL) | O_ASYNC) == -1) {
+    return nullptr;
+  }
+  return counters;
+}
+
+HardwareCounters::~HardwareCounters() {
+  for (int fd : fds_) {
+    if (fd != -1) close(fd);
+  }
+}
+
+void HardwareCounters::Enable() {
+  for (uint64_t& value : last_values_) value = 0;
+  ioctl(signal_fd(), PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(signal_fd(), PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void HardwareCounters::Disable() {
+  ioctl(signal_fd(), PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void HardwareCounters::ReadDeltas(uint64_t deltas[kCount]) {
+  // With PERF_FORMAT_GROUP, the number of counters followed by their values.
+  uint64_t values[1 + kCount];
+  ssize_t size = static_cast<ssize_t>(sizeof(values[0]) * (1 + group_size_));
+  bool success = read(signal_fd(), values, size) == size;
+  for (int i = 0; i < kCount; i++) {
+    if (!success || group_index_[i] == -1) {
+      deltas[i] = 0;
+      continue;
+    }
+    uint64_t value = values[1 + group_index_[i]];
+    deltas[i] = value - last_values_[i];
+    last_values_[i] = value;
+  }
+}
+
+#else  // V8_OS_LINUX
+
+// static
+std::unique_ptr<HardwareCounters> HardwareCounters::New(
+    CpuProfilingCounter trigger, uint64_t period) {
+  return nullptr;
+}
+
+HardwareCounters::~HardwareCounters() = default;
+
+void HardwareCounters::Enable() { UNREACHABLE(); }
+
+void HardwareCounters::Disable() { UNREACHABLE(); }
+
+void HardwareCounters::ReadDeltas(uint64_t deltas[kCount]) { UNREACHABLE(); }
+
+#endif  // V8_OS_LINUX
+
+}  // namespace internal
+}  // namespace v8
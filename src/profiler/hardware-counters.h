@@ -0,0 +1,61 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_PROFILER_HARDWARE_COUNTERS_H_
+#define V8_PROFILER_HARDWARE_COUNTERS_H_
+
+#include <memory>
+
+#include "include/v8-profiler.h"
+#include "src/base/macros.h"
+#include "src/profiler/tick-sample.h"
+
+namespace v8 {
+namespace internal {
+
+// The hardware performance counters of one thread, opened as a group with
+// perf_event_open(2). The trigger counter leads the group and raises SIGPROF
+// on the thread every |period| events, which libsampler dispatches to the
+// sampler waiting for signal_fd(). The other counters are read along with it
+// and may be missing if the hardware does not provide them.
+//
+// Only implemented on Linux.
+class V8_EXPORT_PRIVATE HardwareCounters {
+ public:
+  static const int kCount = TickSample::kCounterCount;
+
+  // Opens the counters for the calling thread, disabled. Returns nullptr if
+  // the trigger counter is not available.
+  static std::unique_ptr<HardwareCounters> New(CpuProfilingCounter trigger,
+                                               uint64_t period);
+  ~HardwareCounters();
+
+  int signal_fd() const { return fds_[trigger_]; }
+
+  void Enable();
+  void Disable();
+
+  // Stores the events since the previous call, or since the counters were
+  // opened, into |deltas|. Async-signal-safe, so it can be called from the
+  // sampler's signal handler.
+  void ReadDeltas(uint64_t deltas[kCount]);
+
+ private:
+  explicit HardwareCounters(CpuProfilingCounter trigger);
+
+  const CpuProfilingCounter trigger_;
+  // File descriptors indexed by counter, -1 for missing counters.
+  int fds_[kCount];
+  // Position of each counter in the group read, -1 for missing counters.
+  int group_index_[kCount];
+  int group_size_ = 0;
+  uint64_t last_values_[kCount] = {};
+
+  DISALLOW_COPY_AND_ASSIGN(HardwareCounters);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_PROFILER_HARDWARE_COUNTERS_H_
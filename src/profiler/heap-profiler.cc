@@ -10,6 +10,7 @@
 #include "src/heap/heap-inl.h"
 #include "src/profiler/allocation-tracker.h"
 #include "src/profiler/heap-snapshot-generator-inl.h"
+#include "src/profiler/retained-size-summary.h"
 #include "src/profiler/sampling-heap-profiler.h"
 
 namespace v8 {
@@ -85,6 +86,12 @@ HeapSnapshot* HeapProfiler::TakeSnapshot(
   return result;
 }
 
+std::vector<v8::HeapProfiler::RetainedSizeSummaryEntry>
+HeapProfiler::GetRetainedSizeSummary(size_t max_entries) {
+  RetainedSizeSummaryBuilder builder(heap());
+  return builder.Build(max_entries);
+}
+
 bool HeapProfiler::StartSamplingHeapProfiler(
     uint64_t sample_interval, int stack_depth,
     v8::HeapProfiler::SamplingFlags flags) {
@@ -111,6 +118,15 @@ v8::AllocationProfile* HeapProfiler::GetAllocationProfile() {
   }
 }
 
+std::vector<v8::HeapProfiler::AllocationSiteUpdate>
+HeapProfiler::GetAllocationSiteUpdates() {
+  if (!sampling_heap_profiler_ ||
+      !sampling_heap_profiler_->aggregate_by_site()) {
+    return {};
+  }
+  return sampling_heap_profiler_->GetAllocationSiteUpdates();
+}
+
 
 void HeapProfiler::StartHeapObjectsTracking(bool track_allocations) {
   ids_->UpdateHeapObjectsMap();
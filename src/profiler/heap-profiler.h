@@ -33,11 +33,16 @@ class HeapProfiler : public HeapObjectAllocationTracker {
                              v8::HeapProfiler::ObjectNameResolver* resolver,
                              bool treat_global_objects_as_roots);
 
+  std::vector<v8::HeapProfiler::RetainedSizeSummaryEntry>
+  GetRetainedSizeSummary(size_t max_entries);
+
   bool StartSamplingHeapProfiler(uint64_t sample_interval, int stack_depth,
                                  v8::HeapProfiler::SamplingFlags);
   void StopSamplingHeapProfiler();
   bool is_sampling_allocations() { return !!sampling_heap_profiler_; }
   AllocationProfile* GetAllocationProfile();
+  std::vector<v8::HeapProfiler::AllocationSiteUpdate>
+  GetAllocationSiteUpdates();
 
   void StartHeapObjectsTracking(bool track_allocations);
   void StopHeapObjectsTracking();
@@ -2202,6 +2202,25 @@ class OutputStreamWriter {
     }
   }
   void AddNumber(unsigned n) { AddNumberImpl<unsigned>(n, "%u"); }
+  // Unlike AddCharacter and AddSubstring, these accept arbitrary bytes
+  // including '\0' and are used by the binary snapshot format.
+  void AddByte(uint8_t b) {
+    DCHECK(chunk_pos_ < chunk_size_);
+    chunk_[chunk_pos_++] = static_cast<char>(b);
+    MaybeWriteChunk();
+  }
+  void AddBytes(const char* s, size_t n) {
+    const char* s_end = s + n;
+    while (s < s_end) {
+      int s_chunk_size =
+          Min(chunk_size_ - chunk_pos_, static_cast<int>(s_end - s));
+      DCHECK_GT(s_chunk_size, 0);
+      MemCopy(chunk_.begin() + chunk_pos_, s, s_chunk_size);
+      s += s_chunk_size;
+      chunk_pos_ += s_chunk_size;
+      MaybeWriteChunk();
+    }
+  }
   void Finalize() {
     if (aborted_) return;
     DCHECK(chunk_pos_ < chunk_size_);
@@ -2755,5 +2774,106 @@ void HeapSnapshotJSONSerializer::SerializeLocations() {
   }
 }
 
+const char HeapSnapshotBinarySerializer::kMagic[4] = {'V', '8', 'H', 'S'};
+const uint32_t HeapSnapshotBinarySerializer::kVersion = 2;
+const uint32_t HeapSnapshotBinarySerializer::kStringCacheSize;
+
+void HeapSnapshotBinarySerializer::Serialize(v8::OutputStream* stream) {
+  DCHECK_NULL(writer_);
+  writer_ = new OutputStreamWriter(stream);
+  string_cache_.assign(kStringCacheSize, nullptr);
+  SerializeImpl();
+  string_cache_.clear();
+  delete writer_;
+  writer_ = nullptr;
+}
+
+void HeapSnapshotBinarySerializer::SerializeImpl() {
+  DCHECK_EQ(0, snapshot_->root()->index());
+  SerializeHeader();
+  if (writer_->aborted()) return;
+  SerializeNodes();
+  if (writer_->aborted()) return;
+  SerializeEdges();
+  if (writer_->aborted()) return;
+  SerializeLocations();
+  if (writer_->aborted()) return;
+  writer_->Finalize();
+}
+
+void HeapSnapshotBinarySerializer::WriteString(const char* s) {
+  int length = static_cast<int>(strlen(s));
+  uint32_t hash_field =
+      StringHasher::HashSequentialString(s, length, kZeroHashSeed);
+  uint32_t slot = (hash_field >> Name::kHashShift) & (kStringCacheSize - 1);
+  const char* cached = string_cache_[slot];
+  if (cached != nullptr && (cached == s || strcmp(cached, s) == 0)) {
+    WriteVarint(slot << 1);
+    return;
+  }
+  // Strings are written inline on a cache miss, so neither side has to keep
+  // more than kStringCacheSize of them.
+  string_cache_[slot] = s;
+  WriteVarint((slot << 1) | 1);
+  WriteVarint(length);
+  writer_->AddBytes(s, length);
+}
+
+void HeapSnapshotBinarySerializer::WriteVarint(uint64_t value) {
+  while (value >= 0x80) {
+    writer_->AddByte(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  writer_->AddByte(static_cast<uint8_t>(value));
+}
+
+void HeapSnapshotBinarySerializer::SerializeHeader() {
+  writer_->AddBytes(kMagic, sizeof(kMagic));
+  WriteVarint(kVersion);
+  WriteVarint(kStringCacheSize);
+  WriteVarint(snapshot_->entries().size());
+  WriteVarint(snapshot_->children().size());
+}
+
+void HeapSnapshotBinarySerializer::SerializeNodes() {
+  for (const HeapEntry& entry : snapshot_->entries()) {
+    WriteVarint(entry.type());
+    WriteString(entry.name());
+    WriteVarint(entry.id());
+    WriteVarint(entry.self_size());
+    WriteVarint(entry.children_count());
+    WriteVarint(entry.trace_node_id());
+    WriteVarint(entry.detachedness());
+    if (writer_->aborted()) return;
+  }
+}
+
+void HeapSnapshotBinarySerializer::SerializeEdges() {
+  for (HeapGraphEdge* edge : snapshot_->children()) {
+    bool indexed = edge->type() == HeapGraphEdge::kElement ||
+                   edge->type() == HeapGraphEdge::kHidden;
+    WriteVarint(edge->type());
+    if (indexed) {
+      WriteVarint(static_cast<uint32_t>(edge->index()));
+    } else {
+      WriteString(edge->name());
+    }
+    WriteVarint(edge->to()->index());
+    if (writer_->aborted()) return;
+  }
+}
+
+void HeapSnapshotBinarySerializer::SerializeLocations() {
+  const std::vector<SourceLocation>& locations = snapshot_->locations();
+  WriteVarint(locations.size());
+  for (const SourceLocation& location : locations) {
+    WriteVarint(static_cast<uint32_t>(location.entry_index));
+    WriteVarint(static_cast<uint32_t>(location.scriptId));
+    WriteVarint(static_cast<uint32_t>(location.line));
+    WriteVarint(static_cast<uint32_t>(location.col));
+    if (writer_->aborted()) return;
+  }
+}
+
 }  // namespace internal
 }  // namespace v8
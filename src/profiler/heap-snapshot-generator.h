@@ -588,6 +588,40 @@ class HeapSnapshotJSONSerializer {
   DISALLOW_COPY_AND_ASSIGN(HeapSnapshotJSONSerializer);
 };
 
+// Writes a snapshot in the compact binary format described near
+// v8::HeapSnapshot::Serialize. All integers are encoded as unsigned LEB128
+// varints, and node references are node ordinals rather than offsets into
+// the flattened nodes array. Strings are written inline into the slots of a
+// fixed size cache, which bounds the memory used for them while writing and
+// reading.
+class HeapSnapshotBinarySerializer {
+ public:
+  explicit HeapSnapshotBinarySerializer(HeapSnapshot* snapshot)
+      : snapshot_(snapshot), writer_(nullptr) {}
+  void Serialize(v8::OutputStream* stream);
+
+  static const char kMagic[4];
+  static const uint32_t kVersion;
+  // Must be a power of two.
+  static const uint32_t kStringCacheSize = 1 << 16;
+
+ private:
+  void WriteString(const char* s);
+  void WriteVarint(uint64_t value);
+  void SerializeImpl();
+  void SerializeHeader();
+  void SerializeNodes();
+  void SerializeEdges();
+  void SerializeLocations();
+
+  HeapSnapshot* snapshot_;
+  // Strings by slot, indexed by their content hash.
+  std::vector<const char*> string_cache_;
+  OutputStreamWriter* writer_;
+
+  DISALLOW_COPY_AND_ASSIGN(HeapSnapshotBinarySerializer);
+};
+
 
 }  // namespace internal
 }  // namespace v8
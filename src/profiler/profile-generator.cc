@@ -8,6 +8,7 @@
 
 #include "src/codegen/source-position.h"
 #include "src/objects/shared-function-info-inl.h"
+#include "src/profiler/continuous-profile.h"
 #include "src/profiler/cpu-profiler.h"
 #include "src/profiler/profile-generator-inl.h"
 #include "src/profiler/profiler-stats.h"
@@ -292,6 +293,13 @@ ProfileNode* ProfileNode::FindOrAddChild(CodeEntry* entry, int line_number) {
 }
 
 
+void ProfileNode::AddCounters(
+    const uint64_t counters[TickSample::kCounterCount]) {
+  for (int i = 0; i < TickSample::kCounterCount; i++) {
+    counters_[i] += counters[i];
+  }
+}
+
 void ProfileNode::IncrementLineTicks(int src_line) {
   if (src_line == v8::CpuProfileNode::kNoLineNumberInfo) return;
   // Increment a hit counter of a certain source line.
@@ -398,7 +406,8 @@ ProfileNode* ProfileTree::AddPathFromEnd(const std::vector<CodeEntry*>& path,
 
 ProfileNode* ProfileTree::AddPathFromEnd(const ProfileStackTrace& path,
                                          int src_line, bool update_stats,
-                                         ProfilingMode mode) {
+                                         ProfilingMode mode,
+                                         const uint64_t* counters) {
   ProfileNode* node = root_;
   CodeEntry* last_entry = nullptr;
   int parent_line_number = v8::CpuProfileNode::kNoLineNumberInfo;
@@ -418,6 +427,7 @@ ProfileNode* ProfileTree::AddPathFromEnd(const ProfileStackTrace& path,
     if (src_line != v8::CpuProfileNode::kNoLineNumberInfo) {
       node->IncrementLineTicks(src_line);
     }
+    if (counters != nullptr) node->AddCounters(counters);
   }
   return node;
 }
@@ -506,11 +516,12 @@ bool CpuProfile::CheckSubsample(base::TimeDelta source_sampling_interval) {
 
 void CpuProfile::AddPath(base::TimeTicks timestamp,
                          const ProfileStackTrace& path, int src_line,
-                         bool update_stats, base::TimeDelta sampling_interval) {
+                         bool update_stats, base::TimeDelta sampling_interval,
+                         const uint64_t* counters) {
   if (!CheckSubsample(sampling_interval)) return;
 
-  ProfileNode* top_frame_node =
-      top_down_.AddPathFromEnd(path, src_line, update_stats, options_.mode());
+  ProfileNode* top_frame_node = top_down_.AddPathFromEnd(
+      path, src_line, update_stats, options_.mode(), counters);
 
   bool should_record_sample =
       !timestamp.IsNull() && timestamp >= start_time_ &&
@@ -663,6 +674,7 @@ void CodeMap::AddCode(Address addr, CodeEntry* entry, unsigned size) {
 }
 
 void CodeMap::ClearCodesInRange(Address start, Address end) {
+  generation_++;
   auto left = code_map_.upper_bound(start);
   if (left != code_map_.begin()) {
     --left;
@@ -693,6 +705,7 @@ void CodeMap::MoveCode(Address from, Address to) {
   if (from == to) return;
   auto it = code_map_.find(from);
   if (it == code_map_.end()) return;
+  generation_++;
   CodeEntryMapInfo info = it->second;
   code_map_.erase(it);
   DCHECK(from + info.size <= to || to + info.size <= from);
@@ -727,6 +740,8 @@ void CodeMap::Print() {
 CpuProfilesCollection::CpuProfilesCollection(Isolate* isolate)
     : profiler_(nullptr), current_profiles_semaphore_(1) {}
 
+CpuProfilesCollection::~CpuProfilesCollection() = default;
+
 bool CpuProfilesCollection::StartProfiling(const char* title,
                                            CpuProfilingOptions options) {
   current_profiles_semaphore_.Wait();
@@ -770,9 +785,34 @@ CpuProfile* CpuProfilesCollection::StopProfiling(const char* title) {
 }
 
 
+bool CpuProfilesCollection::StartContinuousProfiling(
+    v8::ContinuousProfileDelegate* delegate, base::TimeDelta flush_interval,
+    size_t max_stacks) {
+  if (continuous_profile_) return false;
+  auto profile =
+      std::make_unique<ContinuousProfile>(delegate, flush_interval, max_stacks);
+  current_profiles_semaphore_.Wait();
+  continuous_profile_ = std::move(profile);
+  current_profiles_semaphore_.Signal();
+  return true;
+}
+
+void CpuProfilesCollection::StopContinuousProfiling() {
+  current_profiles_semaphore_.Wait();
+  std::unique_ptr<ContinuousProfile> profile = std::move(continuous_profile_);
+  current_profiles_semaphore_.Signal();
+  if (!profile) return;
+  base::MutexGuard guard(&continuous_profile_delegate_mutex_);
+  std::vector<uint8_t> chunk = profile->TakeChunk();
+  if (!chunk.empty()) {
+    profile->delegate()->OnProfileChunk(chunk.data(), chunk.size());
+  }
+}
+
 bool CpuProfilesCollection::IsLastProfile(const char* title) {
   // Called from VM thread, and only it can mutate the list,
   // so no locking is needed here.
+  if (continuous_profile_) return false;
   if (current_profiles_.size() != 1) return false;
   return title[0] == '\0' || strcmp(current_profiles_[0]->title(), title) == 0;
 }
@@ -816,21 +856,49 @@ base::TimeDelta CpuProfilesCollection::GetCommonSamplingInterval() const {
         base_sampling_interval_us;
     interval_us = GreatestCommonDivisor(interval_us, profile_interval_us);
   }
+  // Continuous profiling samples at the base sampling interval.
+  if (continuous_profile_) {
+    interval_us = GreatestCommonDivisor(interval_us, base_sampling_interval_us);
+  }
   return base::TimeDelta::FromMicroseconds(interval_us);
 }
 
 void CpuProfilesCollection::AddPathToCurrentProfiles(
     base::TimeTicks timestamp, const ProfileStackTrace& path, int src_line,
-    bool update_stats, base::TimeDelta sampling_interval) {
+    bool update_stats, base::TimeDelta sampling_interval,
+    const uint64_t* counters) {
   // As starting / stopping profiles is rare relatively to this
   // method, we don't bother minimizing the duration of lock holding,
   // e.g. copying contents of the list to a local vector.
   current_profiles_semaphore_.Wait();
   for (const std::unique_ptr<CpuProfile>& profile : current_profiles_) {
     profile->AddPath(timestamp, path, src_line, update_stats,
-                     sampling_interval);
+                     sampling_interval, counters);
+  }
+  if (continuous_profile_ && update_stats) {
+    continuous_profile_->AddSample(timestamp, path, sampling_interval);
+  }
+  FlushFullContinuousProfileWindowAndSignal(timestamp);
+}
+
+void CpuProfilesCollection::FlushContinuousProfileIfDue(base::TimeTicks now) {
+  current_profiles_semaphore_.Wait();
+  FlushFullContinuousProfileWindowAndSignal(now);
+}
+
+void CpuProfilesCollection::FlushFullContinuousProfileWindowAndSignal(
+    base::TimeTicks now) {
+  if (!continuous_profile_ || !continuous_profile_->IsWindowFull(now)) {
+    current_profiles_semaphore_.Signal();
+    return;
   }
+  std::vector<uint8_t> chunk = continuous_profile_->TakeChunk();
+  v8::ContinuousProfileDelegate* delegate = continuous_profile_->delegate();
+  // Hand the chunk to the delegate without blocking the VM thread from
+  // starting or stopping profiles.
+  base::MutexGuard guard(&continuous_profile_delegate_mutex_);
   current_profiles_semaphore_.Signal();
+  delegate->OnProfileChunk(chunk.data(), chunk.size());
 }
 
 }  // namespace internal
@@ -15,10 +15,12 @@
 #include <vector>
 
 #include "include/v8-profiler.h"
+#include "src/base/platform/mutex.h"
 #include "src/base/platform/time.h"
 #include "src/builtins/builtins.h"
 #include "src/logging/code-events.h"
 #include "src/profiler/strings-storage.h"
+#include "src/profiler/tick-sample.h"
 #include "src/utils/allocation.h"
 
 namespace v8 {
@@ -244,9 +246,13 @@ class V8_EXPORT_PRIVATE ProfileNode {
   void IncrementSelfTicks() { ++self_ticks_; }
   void IncreaseSelfTicks(unsigned amount) { self_ticks_ += amount; }
   void IncrementLineTicks(int src_line);
+  void AddCounters(const uint64_t counters[TickSample::kCounterCount]);
 
   CodeEntry* entry() const { return entry_; }
   unsigned self_ticks() const { return self_ticks_; }
+  uint64_t counter(v8::CpuProfilingCounter counter) const {
+    return counters_[counter];
+  }
   const std::vector<ProfileNode*>* children() const { return &children_list_; }
   unsigned id() const { return id_; }
   ProfileNode* parent() const { return parent_; }
@@ -295,6 +301,8 @@ class V8_EXPORT_PRIVATE ProfileNode {
   std::unordered_map<int, int> line_ticks_;
 
   std::vector<CpuProfileDeoptInfo> deopt_infos_;
+  // Hardware counter events of the samples with this node on top.
+  uint64_t counters_[TickSample::kCounterCount] = {};
 
   DISALLOW_COPY_AND_ASSIGN(ProfileNode);
 };
@@ -314,7 +322,8 @@ class V8_EXPORT_PRIVATE ProfileTree {
       const ProfileStackTrace& path,
       int src_line = v8::CpuProfileNode::kNoLineNumberInfo,
       bool update_stats = true,
-      ProfilingMode mode = ProfilingMode::kLeafNodeLineNumbers);
+      ProfilingMode mode = ProfilingMode::kLeafNodeLineNumbers,
+      const uint64_t* counters = nullptr);
   ProfileNode* root() const { return root_; }
   unsigned next_node_id() { return next_node_id_++; }
 
@@ -360,7 +369,8 @@ class CpuProfile {
   // Add pc -> ... -> main() call path to the profile.
   void AddPath(base::TimeTicks timestamp, const ProfileStackTrace& path,
                int src_line, bool update_stats,
-               base::TimeDelta sampling_interval);
+               base::TimeDelta sampling_interval,
+               const uint64_t* counters = nullptr);
   void FinishProfile();
 
   const char* title() const { return title_; }
@@ -412,6 +422,10 @@ class V8_EXPORT_PRIVATE CodeMap {
   CodeEntry* FindEntry(Address addr, Address* out_instruction_start = nullptr);
   void Print();
 
+  // Incremented whenever the mapping from addresses to entries changes, so
+  // that lookup caches can tell when they have to be flushed.
+  unsigned generation() const { return generation_; }
+
  private:
   struct CodeEntryMapInfo {
     unsigned index;
@@ -434,13 +448,17 @@ class V8_EXPORT_PRIVATE CodeMap {
   std::deque<CodeEntrySlotInfo> code_entries_;
   std::map<Address, CodeEntryMapInfo> code_map_;
   unsigned free_list_head_ = kNoFreeSlot;
+  unsigned generation_ = 0;
 
   DISALLOW_COPY_AND_ASSIGN(CodeMap);
 };
 
+class ContinuousProfile;
+
 class V8_EXPORT_PRIVATE CpuProfilesCollection {
  public:
   explicit CpuProfilesCollection(Isolate* isolate);
+  ~CpuProfilesCollection();
 
   void set_cpu_profiler(CpuProfiler* profiler) { profiler_ = profiler; }
   bool StartProfiling(const char* title, CpuProfilingOptions options = {});
@@ -451,8 +469,18 @@ class V8_EXPORT_PRIVATE CpuProfilesCollection {
   }
   const char* GetName(Name name) { return resource_names_.GetName(name); }
   bool IsLastProfile(const char* title);
+  bool HasCurrentProfiles() const { return !current_profiles_.empty(); }
   void RemoveProfile(CpuProfile* profile);
 
+  bool StartContinuousProfiling(v8::ContinuousProfileDelegate* delegate,
+                                base::TimeDelta flush_interval,
+                                size_t max_stacks);
+  // Flushes the samples that have not been handed to the delegate yet.
+  void StopContinuousProfiling();
+  bool is_continuous_profiling() const {
+    return continuous_profile_ != nullptr;
+  }
+
   // Finds a common sampling interval dividing each CpuProfile's interval,
   // rounded up to the nearest multiple of the CpuProfiler's sampling interval.
   // Returns 0 if no profiles are attached.
@@ -462,19 +490,33 @@ class V8_EXPORT_PRIVATE CpuProfilesCollection {
   void AddPathToCurrentProfiles(base::TimeTicks timestamp,
                                 const ProfileStackTrace& path, int src_line,
                                 bool update_stats,
-                                base::TimeDelta sampling_interval);
+                                base::TimeDelta sampling_interval,
+                                const uint64_t* counters = nullptr);
+  // Hands the window of the continuous profile to the delegate if it is due
+  // at |now|, so that the last window is delivered even when no samples
+  // arrive. Called from profile generator thread.
+  void FlushContinuousProfileIfDue(base::TimeTicks now);
 
   // Limits the number of profiles that can be simultaneously collected.
   static const int kMaxSimultaneousProfiles = 100;
 
  private:
+  // Must be called with {current_profiles_semaphore_} taken, and releases it.
+  void FlushFullContinuousProfileWindowAndSignal(base::TimeTicks now);
+
   StringsStorage resource_names_;
   std::vector<std::unique_ptr<CpuProfile>> finished_profiles_;
   CpuProfiler* profiler_;
 
   // Accessed by VM thread and profile generator thread.
   std::vector<std::unique_ptr<CpuProfile>> current_profiles_;
+  std::unique_ptr<ContinuousProfile> continuous_profile_;
   base::Semaphore current_profiles_semaphore_;
+  // Held while a chunk of the continuous profile is handed to its delegate,
+  // which happens outside of {current_profiles_semaphore_}. Taken before that
+  // semaphore is released, so that StopContinuousProfiling waits for chunks
+  // taken before it and the delegate is not used after it returns.
+  base::Mutex continuous_profile_delegate_mutex_;
 
   DISALLOW_COPY_AND_ASSIGN(CpuProfilesCollection);
 };
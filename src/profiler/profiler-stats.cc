@@ -11,8 +11,8 @@
 namespace v8 {
 namespace internal {
 
-void ProfilerStats::AddReason(Reason reason) {
-  counts_[reason].fetch_add(1, std::memory_order_relaxed);
+void ProfilerStats::AddReason(Reason reason, int count) {
+  counts_[reason].fetch_add(count, std::memory_order_relaxed);
 }
 
 void ProfilerStats::Clear() {
@@ -46,6 +46,10 @@ const char* ProfilerStats::ReasonToString(Reason reason) {
       return "kNoSymbolizedFrames";
     case kNullPC:
       return "kNullPC";
+    case kSymbolizerCacheHit:
+      return "kSymbolizerCacheHit";
+    case kSymbolizerCacheMiss:
+      return "kSymbolizerCacheMiss";
     case kNumberOfReasons:
       return "kNumberOfReasons";
   }
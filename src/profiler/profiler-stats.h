@@ -10,7 +10,8 @@
 namespace v8 {
 namespace internal {
 
-// Stats are used to diagnose the reasons for dropped or unnattributed frames.
+// Stats are used to diagnose the reasons for dropped or unnattributed frames,
+// and to see how well the Symbolizer's cache works.
 class ProfilerStats {
  public:
   enum Reason {
@@ -23,6 +24,9 @@ class ProfilerStats {
     kInCallOrApply,
     kNoSymbolizedFrames,
     kNullPC,
+    // Symbolizer lookups of frame addresses; these do not drop frames.
+    kSymbolizerCacheHit,
+    kSymbolizerCacheMiss,
 
     kNumberOfReasons,
   };
@@ -32,7 +36,7 @@ class ProfilerStats {
     return &stats;
   }
 
-  void AddReason(Reason reason);
+  void AddReason(Reason reason, int count = 1);
   void Clear();
   void Print() const;
 
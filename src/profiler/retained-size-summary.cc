@@ -0,0 +1,345 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/profiler/retained-size-summary.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "src/heap/combined-heap.h"
+#include "src/heap/heap-inl.h"
+#include "src/heap/safepoint.h"
+#include "src/objects/objects-inl.h"
+#include "src/objects/visitors.h"
+#include "src/profiler/heap-snapshot-generator.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// Names for objects that are not attributed to a constructor.
+enum FixedName : uint32_t {
+  kRootName,
+  kStringName,
+  kCodeName,
+  kArrayName,
+  kNumberName,
+  kSystemName,
+  kNumberOfFixedNames
+};
+
+const char* const kFixedNames[] = {"(root)",   "(string)", "(compiled code)",
+                                   "(array)",  "(number)", "(system)"};
+STATIC_ASSERT(arraysize(kFixedNames) == kNumberOfFixedNames);
+
+}  // namespace
+
+class RetainedSizeSummaryBuilder::EdgeCollector : public ObjectVisitor {
+ public:
+  explicit EdgeCollector(RetainedSizeSummaryBuilder* builder)
+      : builder_(builder) {}
+
+  void VisitPointers(HeapObject host, ObjectSlot start,
+                     ObjectSlot end) override {
+    VisitPointers(host, MaybeObjectSlot(start), MaybeObjectSlot(end));
+  }
+  void VisitPointers(HeapObject host, MaybeObjectSlot start,
+                     MaybeObjectSlot end) override {
+    for (MaybeObjectSlot p = start; p < end; ++p) {
+      HeapObject heap_object;
+      // Weak references do not retain their targets.
+      if ((*p)->GetHeapObjectIfStrong(&heap_object)) Add(heap_object);
+    }
+  }
+  void VisitCustomWeakPointers(HeapObject host, ObjectSlot start,
+                               ObjectSlot end) override {}
+
+  void VisitCodeTarget(Code host, RelocInfo* rinfo) override {
+    Add(Code::GetCodeFromTargetAddress(rinfo->target_address()));
+  }
+  void VisitEmbeddedPointer(Code host, RelocInfo* rinfo) override {
+    Add(rinfo->target_object());
+  }
+
+ private:
+  void Add(HeapObject target) { builder_->AddSuccessor(target); }
+
+  RetainedSizeSummaryBuilder* builder_;
+};
+
+class RetainedSizeSummaryBuilder::RootCollector : public RootVisitor {
+ public:
+  explicit RootCollector(RetainedSizeSummaryBuilder* builder)
+      : builder_(builder) {}
+
+  void VisitRootPointers(Root root, const char* description,
+                         FullObjectSlot start, FullObjectSlot end) override {
+    for (FullObjectSlot p = start; p < end; ++p) {
+      Object object = *p;
+      if (object.IsHeapObject()) {
+        builder_->AddSuccessor(HeapObject::cast(object));
+      }
+    }
+  }
+  void VisitRootPointers(Root root, const char* description,
+                         OffHeapObjectSlot start,
+                         OffHeapObjectSlot end) override {
+    // The string table does not retain its entries.
+    DCHECK_EQ(root, Root::kStringTable);
+  }
+
+ private:
+  RetainedSizeSummaryBuilder* builder_;
+};
+
+std::vector<v8::HeapProfiler::RetainedSizeSummaryEntry>
+RetainedSizeSummaryBuilder::Build(size_t max_entries) {
+  {
+    SafepointScope scope(heap_);
+    CollectGraph();
+  }
+  ComputePostOrder();
+  ComputeDominators();
+  ComputeRetainedSizes();
+
+  // Walk the dominator tree, attributing an object's retained size to its
+  // name only if none of its dominators carries the same name, so that
+  // e.g. linked lists are not counted once per element.
+  uint32_t count = static_cast<uint32_t>(post_order_.size());
+  uint32_t root = count - 1;
+  std::vector<uint32_t> first_child(count + 1, 0);
+  for (uint32_t i = 0; i < root; ++i) first_child[dominators_[i] + 1]++;
+  for (uint32_t i = 0; i < count; ++i) first_child[i + 1] += first_child[i];
+  std::vector<uint32_t> children(first_child[count]);
+  {
+    std::vector<uint32_t> next(first_child.begin(), first_child.end() - 1);
+    for (uint32_t i = 0; i < root; ++i) children[next[dominators_[i]]++] = i;
+  }
+
+  std::vector<v8::HeapProfiler::RetainedSizeSummaryEntry> totals(
+      names_.size(), {std::string(), 0, 0, 0});
+  std::vector<uint32_t> active(names_.size(), 0);
+  std::vector<std::pair<uint32_t, uint32_t>> stack;
+  stack.emplace_back(root, first_child[root]);
+  active[kRootName]++;
+  while (!stack.empty()) {
+    uint32_t node = stack.back().first;
+    uint32_t position = stack.back().second;
+    if (position == first_child[node + 1]) {
+      active[name_ids_[post_order_[node]]]--;
+      stack.pop_back();
+      continue;
+    }
+    stack.back().second++;
+    uint32_t child = children[position];
+    uint32_t name = name_ids_[post_order_[child]];
+    v8::HeapProfiler::RetainedSizeSummaryEntry& total = totals[name];
+    total.count++;
+    total.self_size += self_sizes_[post_order_[child]];
+    if (active[name] == 0) total.retained_size += retained_sizes_[child];
+    active[name]++;
+    stack.emplace_back(child, first_child[child]);
+  }
+
+  // Different String objects may carry the same constructor name.
+  std::unordered_map<std::string, size_t> merged_index;
+  std::vector<v8::HeapProfiler::RetainedSizeSummaryEntry> result;
+  for (size_t i = 0; i < totals.size(); ++i) {
+    if (i == kRootName || totals[i].count == 0) continue;
+    auto it = merged_index.emplace(names_[i].second, result.size());
+    if (it.second) {
+      totals[i].name = names_[i].second;
+      result.push_back(totals[i]);
+    } else {
+      v8::HeapProfiler::RetainedSizeSummaryEntry& entry =
+          result[it.first->second];
+      entry.count += totals[i].count;
+      entry.self_size += totals[i].self_size;
+      entry.retained_size += totals[i].retained_size;
+    }
+  }
+  std::sort(result.begin(), result.end(),
+            [](const v8::HeapProfiler::RetainedSizeSummaryEntry& a,
+               const v8::HeapProfiler::RetainedSizeSummaryEntry& b) {
+              return a.retained_size > b.retained_size;
+            });
+  if (result.size() > max_entries) result.resize(max_entries);
+  return result;
+}
+
+void RetainedSizeSummaryBuilder::CollectGraph() {
+  for (const char* name : kFixedNames) {
+    names_.emplace_back(kNullAddress, name);
+  }
+  self_sizes_.push_back(0);
+  name_ids_.push_back(kRootName);
+
+  // No GC is needed first: objects that are no longer reachable are never
+  // visited from the root below, so they do not show up in the summary.
+  {
+    CombinedHeapObjectIterator iterator(heap_);
+    for (HeapObject obj = iterator.Next(); !obj.is_null();
+         obj = iterator.Next()) {
+      uint32_t node = static_cast<uint32_t>(self_sizes_.size());
+      self_sizes_.push_back(obj.Size());
+      name_ids_.push_back(NameIdFor(obj));
+      nodes_by_address_.emplace_back(obj.address(), node);
+    }
+  }
+  std::sort(nodes_by_address_.begin(), nodes_by_address_.end());
+
+  // With all nodes known, the edges are resolved as they are visited and
+  // stored only in compressed sparse row form. The heap does not change in
+  // between, so the second walk visits the objects in the same order.
+  first_successor_.reserve(self_sizes_.size() + 1);
+  first_successor_.push_back(0);
+  RootCollector root_collector(this);
+  ReadOnlyRoots(heap_).Iterate(&root_collector);
+  heap_->IterateRoots(&root_collector,
+                      base::EnumSet<SkipRoot>{SkipRoot::kWeak});
+  first_successor_.push_back(static_cast<uint32_t>(successors_.size()));
+
+  EdgeCollector edge_collector(this);
+  CombinedHeapObjectIterator iterator(heap_);
+  for (HeapObject obj = iterator.Next(); !obj.is_null();
+       obj = iterator.Next()) {
+    DCHECK_EQ(first_successor_.size() - 1, FindNode(obj.address()));
+    obj.Iterate(&edge_collector);
+    first_successor_.push_back(static_cast<uint32_t>(successors_.size()));
+  }
+  DCHECK_EQ(self_sizes_.size() + 1, first_successor_.size());
+  std::vector<std::pair<Address, uint32_t>>().swap(nodes_by_address_);
+}
+
+void RetainedSizeSummaryBuilder::AddSuccessor(HeapObject target) {
+  uint32_t node = FindNode(target.address());
+  if (node != kNoNode) successors_.push_back(node);
+}
+
+uint32_t RetainedSizeSummaryBuilder::NameIdFor(HeapObject object) {
+  if (object.IsJSObject()) {
+    String name = V8HeapExplorer::GetConstructorName(JSObject::cast(object));
+    auto it = name_ids_by_string_.find(name.ptr());
+    if (it != name_ids_by_string_.end()) return it->second;
+    uint32_t id = static_cast<uint32_t>(names_.size());
+    names_.emplace_back(name.ptr(), name.ToCString().get());
+    name_ids_by_string_.emplace(name.ptr(), id);
+    return id;
+  }
+  if (object.IsString()) return kStringName;
+  if (object.IsCode() || object.IsBytecodeArray()) return kCodeName;
+  if (object.IsFixedArrayBase()) return kArrayName;
+  if (object.IsHeapNumber()) return kNumberName;
+  return kSystemName;
+}
+
+uint32_t RetainedSizeSummaryBuilder::FindNode(Address address) const {
+  auto it = std::lower_bound(
+      nodes_by_address_.begin(), nodes_by_address_.end(), address,
+      [](const std::pair<Address, uint32_t>& entry, Address address) {
+        return entry.first < address;
+      });
+  if (it == nodes_by_address_.end() || it->first != address) return kNoNode;
+  return it->second;
+}
+
+void RetainedSizeSummaryBuilder::ComputePostOrder() {
+  uint32_t node_count = static_cast<uint32_t>(self_sizes_.size());
+  post_order_index_.assign(node_count, kNoNode);
+  std::vector<bool> visited(node_count, false);
+  // Pairs of node and the position of its next successor to visit.
+  std::vector<std::pair<uint32_t, uint32_t>> stack;
+  stack.emplace_back(kRootNode, first_successor_[kRootNode]);
+  visited[kRootNode] = true;
+  while (!stack.empty()) {
+    uint32_t node = stack.back().first;
+    uint32_t position = stack.back().second;
+    if (position < first_successor_[node + 1]) {
+      stack.back().second++;
+      uint32_t successor = successors_[position];
+      if (!visited[successor]) {
+        visited[successor] = true;
+        stack.emplace_back(successor, first_successor_[successor]);
+      }
+    } else {
+      post_order_index_[node] = static_cast<uint32_t>(post_order_.size());
+      post_order_.push_back(node);
+      stack.pop_back();
+    }
+  }
+}
+
+void RetainedSizeSummaryBuilder::ComputeDominators() {
+  // Predecessors of reachable nodes, in post order numbering.
+  uint32_t count = static_cast<uint32_t>(post_order_.size());
+  std::vector<uint32_t> first_predecessor(count + 1, 0);
+  for (uint32_t node : post_order_) {
+    for (uint32_t i = first_successor_[node]; i < first_successor_[node + 1];
+         ++i) {
+      first_predecessor[post_order_index_[successors_[i]] + 1]++;
+    }
+  }
+  for (uint32_t i = 0; i < count; ++i) {
+    first_predecessor[i + 1] += first_predecessor[i];
+  }
+  std::vector<uint32_t> predecessors(first_predecessor[count]);
+  {
+    std::vector<uint32_t> next(first_predecessor.begin(),
+                               first_predecessor.end() - 1);
+    for (uint32_t po = 0; po < count; ++po) {
+      uint32_t node = post_order_[po];
+      for (uint32_t i = first_successor_[node];
+           i < first_successor_[node + 1]; ++i) {
+        predecessors[next[post_order_index_[successors_[i]]]++] = po;
+      }
+    }
+  }
+
+  uint32_t root = count - 1;
+  dominators_.assign(count, kNoNode);
+  dominators_[root] = root;
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (uint32_t po = root; po-- > 0;) {
+      uint32_t new_dominator = kNoNode;
+      for (uint32_t i = first_predecessor[po]; i < first_predecessor[po + 1];
+           ++i) {
+        uint32_t finger1 = predecessors[i];
+        if (dominators_[finger1] == kNoNode) continue;
+        if (new_dominator == kNoNode) {
+          new_dominator = finger1;
+          continue;
+        }
+        uint32_t finger2 = new_dominator;
+        while (finger1 != finger2) {
+          while (finger1 < finger2) finger1 = dominators_[finger1];
+          while (finger2 < finger1) finger2 = dominators_[finger2];
+        }
+        new_dominator = finger1;
+      }
+      DCHECK_NE(kNoNode, new_dominator);
+      if (dominators_[po] != new_dominator) {
+        dominators_[po] = new_dominator;
+        changed = true;
+      }
+    }
+  }
+}
+
+void RetainedSizeSummaryBuilder::ComputeRetainedSizes() {
+  // A dominator always comes later in post order than the nodes it
+  // dominates, so a single forward pass accumulates retained sizes.
+  uint32_t count = static_cast<uint32_t>(post_order_.size());
+  retained_sizes_.assign(count, 0);
+  for (uint32_t po = 0; po < count; ++po) {
+    retained_sizes_[po] += self_sizes_[post_order_[po]];
+    if (po == count - 1) continue;
+    retained_sizes_[dominators_[po]] += retained_sizes_[po];
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,77 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_PROFILER_RETAINED_SIZE_SUMMARY_H_
+#define V8_PROFILER_RETAINED_SIZE_SUMMARY_H_
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "include/v8-profiler.h"
+#include "src/common/globals.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+class HeapObject;
+
+// Computes retained sizes aggregated by constructor name without building a
+// HeapSnapshot. The object graph is recorded as compact index arrays in two
+// walks over the heap, one for the objects and one for their edges, which
+// are resolved to node indices right away. Immediate dominators of the
+// objects reachable from the roots are computed with the iterative
+// Cooper-Harvey-Kennedy algorithm, and each object contributes its retained
+// size to its constructor name unless it is dominated by an object with the
+// same name. All of this happens in one pause on the main thread; it is not
+// hooked into the GC's marking.
+class RetainedSizeSummaryBuilder {
+ public:
+  explicit RetainedSizeSummaryBuilder(Heap* heap) : heap_(heap) {}
+
+  std::vector<v8::HeapProfiler::RetainedSizeSummaryEntry> Build(
+      size_t max_entries);
+
+ private:
+  static constexpr uint32_t kRootNode = 0;
+  static constexpr uint32_t kNoNode = static_cast<uint32_t>(-1);
+
+  class EdgeCollector;
+  class RootCollector;
+
+  void CollectGraph();
+  uint32_t NameIdFor(HeapObject object);
+  uint32_t FindNode(Address address) const;
+  void AddSuccessor(HeapObject target);
+  void ComputePostOrder();
+  void ComputeDominators();
+  void ComputeRetainedSizes();
+
+  Heap* heap_;
+
+  // Node 0 is the synthetic root, heap objects start at index 1.
+  std::vector<uint32_t> self_sizes_;
+  std::vector<uint32_t> name_ids_;
+  // (address, node) pairs sorted by address, used to resolve edge targets.
+  std::vector<std::pair<Address, uint32_t>> nodes_by_address_;
+  // Successors in compressed sparse row form.
+  std::vector<uint32_t> first_successor_;
+  std::vector<uint32_t> successors_;
+  std::vector<uint32_t> post_order_index_;
+  std::vector<uint32_t> post_order_;
+  std::vector<uint32_t> dominators_;
+  std::vector<size_t> retained_sizes_;
+
+  // Constructor names are interned by the address of their String, and
+  // merged by contents only when the report is produced.
+  std::vector<std::pair<Address, std::string>> names_;
+  std::unordered_map<Address, uint32_t> name_ids_by_string_;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_PROFILER_RETAINED_SIZE_SUMMARY_H_
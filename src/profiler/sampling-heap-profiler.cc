@@ -5,6 +5,7 @@
 #include "src/profiler/sampling-heap-profiler.h"
 
 #include <stdint.h>
+#include <algorithm>
 #include <memory>
 
 #include "src/api/api-inl.h"
@@ -12,7 +13,9 @@
 #include "src/base/utils/random-number-generator.h"
 #include "src/execution/frames-inl.h"
 #include "src/execution/isolate.h"
+#include "src/handles/global-handles.h"
 #include "src/heap/heap.h"
+#include "src/objects/fixed-array-inl.h"
 #include "src/profiler/strings-storage.h"
 
 namespace v8 {
@@ -64,11 +67,28 @@ SamplingHeapProfiler::SamplingHeapProfiler(
   CHECK_GT(rate_, 0u);
   heap_->AddAllocationObserversToAllSpaces(&allocation_observer_,
                                            &allocation_observer_);
+  if (aggregate_by_site()) {
+    HandleScope scope(isolate_);
+    site_sample_refs_ = isolate_->global_handles()->Create(
+        *isolate_->factory()->NewWeakArrayList(kMinFreeSiteSampleRefs,
+                                               AllocationType::kOld));
+    heap_->AddGCEpilogueCallback(OnScavengeEpilogue, kGCTypeScavenge, this);
+    heap_->AddGCEpilogueCallback(OnMarkCompactEpilogue,
+                                 kGCTypeMarkSweepCompact, this);
+  }
 }
 
 SamplingHeapProfiler::~SamplingHeapProfiler() {
   heap_->RemoveAllocationObserversFromAllSpaces(&allocation_observer_,
                                                 &allocation_observer_);
+  if (aggregate_by_site()) {
+    heap_->RemoveGCEpilogueCallback(OnScavengeEpilogue, this);
+    heap_->RemoveGCEpilogueCallback(OnMarkCompactEpilogue, this);
+    GlobalHandles::Destroy(site_sample_refs_.location());
+    for (const PendingSiteSample& pending : pending_site_samples_) {
+      if (pending.handle) GlobalHandles::Destroy(pending.handle);
+    }
+  }
 }
 
 void SamplingHeapProfiler::SampleObject(Address soon_object, size_t size) {
@@ -85,6 +105,10 @@ void SamplingHeapProfiler::SampleObject(Address soon_object, size_t size) {
 
   AllocationNode* node = AddStack();
   node->allocations_[size]++;
+  if (aggregate_by_site()) {
+    AddSiteSample(heap_object, node, size);
+    return;
+  }
   auto sample =
       std::make_unique<Sample>(size, node, loc, this, next_sample_id());
   sample->global.SetWeak(sample.get(), OnWeakCallback,
@@ -113,6 +137,119 @@ void SamplingHeapProfiler::OnWeakCallback(
   // sample is deleted because its unique ptr was erased from samples_.
 }
 
+void SamplingHeapProfiler::AddSiteSample(HeapObject object,
+                                         AllocationNode* node, size_t size) {
+  v8::AllocationProfile::Allocation scaled = ScaleSample(size, 1);
+  node->allocated_count_ += scaled.count;
+  node->allocated_bytes_ += static_cast<double>(scaled.count) * size;
+  node->live_count_ += scaled.count;
+  node->live_bytes_ += static_cast<double>(scaled.count) * size;
+  MarkDirty(node);
+
+  // Samples are taken while allocating, so the table cannot grow here.
+  WeakArrayList refs = *site_sample_refs_;
+  int length = refs.length();
+  if (length < refs.capacity()) {
+    refs.Set(length, HeapObjectReference::Weak(object));
+    refs.set_length(length + 1);
+    site_samples_.push_back({node, size});
+    return;
+  }
+  Address* handle = isolate_->global_handles()->Create(object).location();
+  GlobalHandles::MakeWeak(&handle);
+  pending_site_samples_.push_back({handle, {node, size}});
+}
+
+void SamplingHeapProfiler::RemoveSiteSample(const SiteSample& sample) {
+  AllocationNode* node = sample.owner;
+  v8::AllocationProfile::Allocation scaled = ScaleSample(sample.size, 1);
+  node->live_count_ -= scaled.count;
+  node->live_bytes_ -= static_cast<double>(scaled.count) * sample.size;
+  DCHECK_GT(node->allocations_[sample.size], 0);
+  if (--node->allocations_[sample.size] == 0) {
+    node->allocations_.erase(sample.size);
+  }
+  MarkDirty(node);
+}
+
+void SamplingHeapProfiler::MarkDirty(AllocationNode* node) {
+  if (node->dirty_) return;
+  node->dirty_ = true;
+  dirty_nodes_.push_back(node);
+}
+
+// static
+void SamplingHeapProfiler::OnScavengeEpilogue(v8::Isolate* isolate,
+                                              v8::GCType type,
+                                              v8::GCCallbackFlags flags,
+                                              void* data) {
+  reinterpret_cast<SamplingHeapProfiler*>(data)->FlushPendingSiteSamples();
+}
+
+// static
+void SamplingHeapProfiler::OnMarkCompactEpilogue(v8::Isolate* isolate,
+                                                 v8::GCType type,
+                                                 v8::GCCallbackFlags flags,
+                                                 void* data) {
+  SamplingHeapProfiler* profiler =
+      reinterpret_cast<SamplingHeapProfiler*>(data);
+  profiler->SweepSiteSamples();
+  profiler->FlushPendingSiteSamples();
+}
+
+void SamplingHeapProfiler::FlushPendingSiteSamples() {
+  int length = site_sample_refs_->length();
+  int free_refs = site_sample_refs_->capacity() - length;
+  if (pending_site_samples_.empty() && free_refs >= kMinFreeSiteSampleRefs) {
+    return;
+  }
+  int needed = length + static_cast<int>(pending_site_samples_.size()) +
+               std::max(kMinFreeSiteSampleRefs, length / 2);
+  Handle<WeakArrayList> refs = WeakArrayList::EnsureSpace(
+      isolate_, site_sample_refs_, needed, AllocationType::kOld);
+  if (*refs != *site_sample_refs_) {
+    GlobalHandles::Destroy(site_sample_refs_.location());
+    site_sample_refs_ = isolate_->global_handles()->Create(*refs);
+  }
+  for (const PendingSiteSample& pending : pending_site_samples_) {
+    if (*pending.handle == kNullAddress) {
+      // The object died before it was moved into the table.
+      RemoveSiteSample(pending.sample);
+      continue;
+    }
+    length = refs->length();
+    refs->Set(length, HeapObjectReference::Weak(
+                          HeapObject::cast(Object(*pending.handle))));
+    refs->set_length(length + 1);
+    site_samples_.push_back(pending.sample);
+    GlobalHandles::Destroy(pending.handle);
+  }
+  pending_site_samples_.clear();
+}
+
+void SamplingHeapProfiler::SweepSiteSamples() {
+  // Mark-compact has cleared the references to the dead samples, account for
+  // them in their sites and compact the table. Nodes are never removed in
+  // this mode, so that the allocated totals are kept.
+  DisallowHeapAllocation no_allocation;
+  WeakArrayList refs = *site_sample_refs_;
+  int live = 0;
+  for (int i = 0; i < refs.length(); i++) {
+    MaybeObject ref = refs.Get(i);
+    if (ref->IsCleared()) {
+      RemoveSiteSample(site_samples_[i]);
+      continue;
+    }
+    if (live != i) {
+      refs.Set(live, ref);
+      site_samples_[live] = site_samples_[i];
+    }
+    live++;
+  }
+  refs.set_length(live);
+  site_samples_.resize(live);
+}
+
 SamplingHeapProfiler::AllocationNode* SamplingHeapProfiler::FindOrAddChildNode(
     AllocationNode* parent, const char* name, int script_id,
     int start_position) {
@@ -279,6 +416,28 @@ v8::AllocationProfile* SamplingHeapProfiler::GetAllocationProfile() {
   return profile;
 }
 
+std::vector<v8::HeapProfiler::AllocationSiteUpdate>
+SamplingHeapProfiler::GetAllocationSiteUpdates() {
+  DCHECK(aggregate_by_site());
+  if (flags_ & v8::HeapProfiler::kSamplingForceGC) {
+    isolate_->heap()->CollectAllGarbage(
+        Heap::kNoGCFlags, GarbageCollectionReason::kSamplingProfiler);
+  }
+  std::vector<v8::HeapProfiler::AllocationSiteUpdate> updates;
+  updates.reserve(dirty_nodes_.size());
+  for (AllocationNode* node : dirty_nodes_) {
+    node->dirty_ = false;
+    updates.push_back({node->id_, node->parent_ ? node->parent_->id_ : 0,
+                       node->name_, node->script_id_, node->script_position_,
+                       static_cast<size_t>(node->allocated_count_ + 0.5),
+                       static_cast<size_t>(node->allocated_bytes_ + 0.5),
+                       static_cast<size_t>(node->live_count_ + 0.5),
+                       static_cast<size_t>(node->live_bytes_ + 0.5)});
+  }
+  dirty_nodes_.clear();
+  return updates;
+}
+
 const std::vector<v8::AllocationProfile::Sample>
 SamplingHeapProfiler::BuildSamples() const {
   std::vector<v8::AllocationProfile::Sample> samples;
@@ -9,6 +9,7 @@
 #include <map>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "include/v8-profiler.h"
 #include "src/heap/heap.h"
@@ -94,6 +95,15 @@ class SamplingHeapProfiler {
     uint32_t id_;
     bool pinned_ = false;
 
+    // Estimated totals, only maintained when aggregating by site. They are
+    // scaled at sampling time since the scale depends on the sample size.
+    double allocated_count_ = 0;
+    double allocated_bytes_ = 0;
+    double live_count_ = 0;
+    double live_bytes_ = 0;
+    // Whether the totals changed since the last GetAllocationSiteUpdates.
+    bool dirty_ = false;
+
     friend class SamplingHeapProfiler;
 
     DISALLOW_COPY_AND_ASSIGN(AllocationNode);
@@ -122,8 +132,14 @@ class SamplingHeapProfiler {
   ~SamplingHeapProfiler();
 
   v8::AllocationProfile* GetAllocationProfile();
+  std::vector<v8::HeapProfiler::AllocationSiteUpdate>
+  GetAllocationSiteUpdates();
   StringsStorage* names() const { return names_; }
 
+  bool aggregate_by_site() const {
+    return flags_ & v8::HeapProfiler::kSamplingAggregateBySite;
+  }
+
  private:
   class Observer : public AllocationObserver {
    public:
@@ -157,7 +173,35 @@ class SamplingHeapProfiler {
     uint64_t const rate_;
   };
 
+  // The free space |site_sample_refs_| is grown to after each GC.
+  static const int kMinFreeSiteSampleRefs = 256;
+
+  // A sample recorded when aggregating by site.
+  struct SiteSample {
+    AllocationNode* owner;
+    size_t size;
+  };
+
+  // A sample taken while |site_sample_refs_| was full. |handle| is a phantom
+  // global handle without callback, which the GC resets to nullptr once the
+  // object dies.
+  struct PendingSiteSample {
+    Address* handle;
+    SiteSample sample;
+  };
+
   void SampleObject(Address soon_object, size_t size);
+  void AddSiteSample(HeapObject object, AllocationNode* node, size_t size);
+  void RemoveSiteSample(const SiteSample& sample);
+  // Moves the pending samples into |site_sample_refs_| and makes room for the
+  // samples taken until the next GC.
+  void FlushPendingSiteSamples();
+  void SweepSiteSamples();
+  void MarkDirty(AllocationNode* node);
+  static void OnScavengeEpilogue(v8::Isolate* isolate, v8::GCType type,
+                                 v8::GCCallbackFlags flags, void* data);
+  static void OnMarkCompactEpilogue(v8::Isolate* isolate, v8::GCType type,
+                                    v8::GCCallbackFlags flags, void* data);
 
   const std::vector<v8::AllocationProfile::Sample> BuildSamples() const;
 
@@ -190,6 +234,13 @@ class SamplingHeapProfiler {
   StringsStorage* const names_;
   AllocationNode profile_root_;
   std::unordered_map<Sample*, std::unique_ptr<Sample>> samples_;
+  // Weak references to the objects sampled when aggregating by site, held by
+  // a single global handle. Element i belongs to |site_samples_[i]|. Only
+  // mark-compact clears weak references, so the table is swept after it.
+  Handle<WeakArrayList> site_sample_refs_;
+  std::vector<SiteSample> site_samples_;
+  std::vector<PendingSiteSample> pending_site_samples_;
+  std::vector<AllocationNode*> dirty_nodes_;
   const int stack_depth_;
   const uint64_t rate_;
   v8::HeapProfiler::SamplingFlags flags_;
@@ -4,6 +4,10 @@
 
 #include "src/profiler/symbolizer.h"
 
+#include <algorithm>
+#include <iterator>
+
+#include "src/base/bits.h"
 #include "src/execution/vm-state.h"
 #include "src/profiler/profile-generator.h"
 #include "src/profiler/profiler-stats.h"
@@ -12,12 +16,33 @@
 namespace v8 {
 namespace internal {
 
-Symbolizer::Symbolizer(CodeMap* code_map) : code_map_(code_map) {}
+Symbolizer::Symbolizer(CodeMap* code_map)
+    : code_map_(code_map), cache_() {}
 
 CodeEntry* Symbolizer::FindEntry(Address address,
                                  Address* out_instruction_start) {
-  CodeEntry* entry = code_map_->FindEntry(address, out_instruction_start);
-  if (entry) entry->mark_used();
+  STATIC_ASSERT(base::bits::IsPowerOfTwo(kCacheSize));
+  if (cache_generation_ != code_map_->generation()) {
+    std::fill(std::begin(cache_), std::end(cache_), CacheEntry{});
+    cache_generation_ = code_map_->generation();
+  }
+  CacheEntry& cached =
+      cache_[(address ^ (address >> 10)) & (kCacheSize - 1)];
+  if (cached.address != address || address == kNullAddress) {
+    cache_misses_++;
+    cached.address = address;
+    cached.instruction_start = kNullAddress;
+    cached.entry = code_map_->FindEntry(address, &cached.instruction_start);
+  } else {
+    cache_hits_++;
+  }
+  CodeEntry* entry = cached.entry;
+  if (entry) {
+    entry->mark_used();
+    if (out_instruction_start) {
+      *out_instruction_start = cached.instruction_start;
+    }
+  }
   return entry;
 }
 
@@ -47,6 +72,8 @@ CodeEntry* EntryForVMState(StateTag tag) {
 
 Symbolizer::SymbolizedSample Symbolizer::SymbolizeTickSample(
     const TickSample& sample) {
+  size_t cache_hits = cache_hits_;
+  size_t cache_misses = cache_misses_;
   ProfileStackTrace stack_trace;
   // Conservatively reserve space for stack frames + pc + function + vm-state.
   // There could in fact be more of them because of inlined entries.
@@ -183,6 +210,13 @@ Symbolizer::SymbolizedSample Symbolizer::SymbolizeTickSample(
     }
   }
 
+  // Forward the cache counts once per sample rather than once per frame.
+  ProfilerStats::Instance()->AddReason(
+      ProfilerStats::Reason::kSymbolizerCacheHit,
+      static_cast<int>(cache_hits_ - cache_hits));
+  ProfilerStats::Instance()->AddReason(
+      ProfilerStats::Reason::kSymbolizerCacheMiss,
+      static_cast<int>(cache_misses_ - cache_misses));
   return SymbolizedSample{stack_trace, src_line};
 }
 
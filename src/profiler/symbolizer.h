@@ -29,11 +29,29 @@ class V8_EXPORT_PRIVATE Symbolizer {
 
   CodeMap* code_map() { return code_map_; }
 
+  // Number of frame addresses looked up in and missing from the cache below.
+  size_t cache_hits() const { return cache_hits_; }
+  size_t cache_misses() const { return cache_misses_; }
+
  private:
+  // Direct-mapped cache of recent CodeMap lookups. Sampled stacks repeat the
+  // same return addresses over and over, which makes this much cheaper than
+  // searching the CodeMap for every frame.
+  struct CacheEntry {
+    Address address;
+    Address instruction_start;
+    CodeEntry* entry;
+  };
+  static constexpr size_t kCacheSize = 1024;
+
   CodeEntry* FindEntry(Address address,
                        Address* out_instruction_start = nullptr);
 
   CodeMap* const code_map_;
+  CacheEntry cache_[kCacheSize];
+  unsigned cache_generation_ = 0;
+  size_t cache_hits_ = 0;
+  size_t cache_misses_ = 0;
 
   DISALLOW_COPY_AND_ASSIGN(Symbolizer);
 };
@@ -5,6 +5,7 @@
 #ifndef V8_PROFILER_TICK_SAMPLE_H_
 #define V8_PROFILER_TICK_SAMPLE_H_
 
+#include "include/v8-profiler.h"
 #include "include/v8.h"
 #include "src/base/platform/time.h"
 #include "src/common/globals.h"
@@ -88,6 +89,11 @@ struct V8_EXPORT TickSample {
 
   base::TimeTicks timestamp;
   base::TimeDelta sampling_interval;  // Sampling interval used to capture.
+
+  // Events of each v8::CpuProfilingCounter since the previous sample, only
+  // recorded with hardware counter sampling.
+  static const int kCounterCount = v8::kCpuBranchMisses + 1;
+  uint64_t counters[kCounterCount] = {};
 };
 
 }  // namespace internal
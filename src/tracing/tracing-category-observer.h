@@ -16,6 +16,8 @@ class TracingCategoryObserver : public TracingController::TraceStateObserver {
     ENABLED_BY_NATIVE = 1 << 0,
     ENABLED_BY_TRACING = 1 << 1,
     ENABLED_BY_SAMPLING = 1 << 2,
+    // Runtime call stats enabled by debug::StartSampledRuntimeCallStats().
+    ENABLED_BY_SAMPLED_STATS = 1 << 3,
   };
 
   static void SetUp();
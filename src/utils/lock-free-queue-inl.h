@@ -0,0 +1,67 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_UTILS_LOCK_FREE_QUEUE_INL_H_
+#define V8_UTILS_LOCK_FREE_QUEUE_INL_H_
+
+#include "src/utils/lock-free-queue.h"
+
+namespace v8 {
+namespace internal {
+
+template <typename Record>
+struct LockFreeQueue<Record>::Node : Malloced {
+  Node() : next(nullptr) {}
+  Record value;
+  std::atomic<Node*> next;
+};
+
+template <typename Record>
+inline LockFreeQueue<Record>::LockFreeQueue() {
+  Node* stub = new Node();
+  CHECK_NOT_NULL(stub);
+  head_.store(stub, std::memory_order_relaxed);
+  tail_ = stub;
+}
+
+template <typename Record>
+inline LockFreeQueue<Record>::~LockFreeQueue() {
+  // Destroy all remaining nodes. Note that we do not destroy the actual values.
+  Node* cur_node = tail_;
+  while (cur_node != nullptr) {
+    Node* old_node = cur_node;
+    cur_node = cur_node->next.load(std::memory_order_relaxed);
+    delete old_node;
+  }
+}
+
+template <typename Record>
+inline void LockFreeQueue<Record>::Enqueue(const Record& record) {
+  Node* n = new Node();
+  CHECK_NOT_NULL(n);
+  n->value = record;
+  Node* prev = head_.exchange(n, std::memory_order_acq_rel);
+  prev->next.store(n, std::memory_order_release);
+}
+
+template <typename Record>
+inline bool LockFreeQueue<Record>::Dequeue(Record* record) {
+  Node* old_tail = tail_;
+  Node* const next_node = old_tail->next.load(std::memory_order_acquire);
+  if (next_node == nullptr) return false;
+  *record = next_node->value;
+  tail_ = next_node;
+  delete old_tail;
+  return true;
+}
+
+template <typename Record>
+inline bool LockFreeQueue<Record>::IsEmpty() const {
+  return tail_->next.load(std::memory_order_acquire) == nullptr;
+}
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_UTILS_LOCK_FREE_QUEUE_INL_H_
@@ -0,0 +1,47 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_UTILS_LOCK_FREE_QUEUE_H_
+#define V8_UTILS_LOCK_FREE_QUEUE_H_
+
+#include <atomic>
+
+#include "src/base/macros.h"
+#include "src/utils/allocation.h"
+
+namespace v8 {
+namespace internal {
+
+// Lock-free unbounded size queue (multi producer; single consumer) based on
+// the intrusive MPSC node-based queue by Dmitry Vyukov. Enqueue is wait-free;
+// Dequeue may transiently report an empty queue while a concurrent Enqueue is
+// in the middle of linking its node, in which case the record becomes visible
+// once that Enqueue completes.
+// See:
+// http://www.1024cores.net/home/lock-free-algorithms/queues/intrusive-mpsc-node-based-queue
+template <typename Record>
+class LockFreeQueue final {
+ public:
+  inline LockFreeQueue();
+  inline ~LockFreeQueue();
+  // May be called from any thread.
+  inline void Enqueue(const Record& record);
+  // Must only be called from the single consumer thread.
+  inline bool Dequeue(Record* record);
+  inline bool IsEmpty() const;
+
+ private:
+  struct Node;
+
+  // Producers swap themselves into |head_|, the consumer owns |tail_|.
+  std::atomic<Node*> head_;
+  Node* tail_;
+
+  DISALLOW_COPY_AND_ASSIGN(LockFreeQueue);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_UTILS_LOCK_FREE_QUEUE_H_
@@ -0,0 +1,69 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "include/libplatform/v8-tracing.h"
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+
+namespace v8 {
+namespace platform {
+namespace tracing {
+namespace {
+
+using CreateTraceBuffer = TraceBuffer* (*)(size_t, TraceWriter*);
+
+class NullTraceWriter : public TraceWriter {
+ public:
+  void AppendTraceEvent(TraceObject* trace_event) override {}
+  void Flush() override {}
+};
+
+// Shared by all threads of a run, set up and torn down by the first one.
+TracingController* tracing_controller = nullptr;
+const uint8_t* category_enabled_flag = nullptr;
+
+void StartTracing(CreateTraceBuffer create_trace_buffer) {
+  tracing_controller = new TracingController();
+  tracing_controller->Initialize(create_trace_buffer(
+      TraceBuffer::kRingBufferChunks, new NullTraceWriter()));
+  TraceConfig* trace_config = new TraceConfig();
+  trace_config->AddIncludedCategory("v8");
+  tracing_controller->StartTracing(trace_config);
+  category_enabled_flag = tracing_controller->GetCategoryGroupEnabled("v8");
+}
+
+void StopTracing() {
+  tracing_controller->StopTracing();
+  delete tracing_controller;
+  tracing_controller = nullptr;
+}
+
+// Adds complete events the way TRACE_EVENT0 does, reporting events/second
+// over all threads.
+void AddCompleteEvents(benchmark::State& state,
+                       CreateTraceBuffer create_trace_buffer) {
+  if (state.thread_index == 0) StartTracing(create_trace_buffer);
+  for (auto _ : state) {
+    uint64_t handle = tracing_controller->AddTraceEvent(
+        'X', category_enabled_flag, "v8.Benchmark", nullptr, 0, 0, 0, nullptr,
+        nullptr, nullptr, nullptr, 0);
+    tracing_controller->UpdateTraceEventDuration(category_enabled_flag,
+                                                 "v8.Benchmark", handle);
+  }
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index == 0) StopTracing();
+}
+
+BENCHMARK_CAPTURE(AddCompleteEvents, RingBuffer,
+                  &TraceBuffer::CreateTraceBufferRingBuffer)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(AddCompleteEvents, PerThread,
+                  &TraceBuffer::CreateTraceBufferPerThread)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace tracing
+}  // namespace platform
+}  // namespace v8
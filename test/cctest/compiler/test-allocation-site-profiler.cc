@@ -0,0 +1,139 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <sstream>
+
+#include "src/diagnostics/allocation-site-profiler.h"
+#include "src/objects/objects-inl.h"
+#include "test/cctest/cctest.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+namespace {
+
+// Sums up the counters of all sites in optimized code for {function_name}.
+AllocationSiteProfilerData::Counters CountersFor(const char* function_name) {
+  AllocationSiteProfilerData::Counters result;
+  for (const auto& data : *AllocationSiteProfiler::Get()->data_list()) {
+    if (data->function_name() != function_name) continue;
+    for (const AllocationSiteProfilerData::Site& site : data->sites()) {
+      result.count += site.counters.count;
+      result.bytes += site.counters.bytes;
+    }
+  }
+  return result;
+}
+
+bool HasDataFor(const char* function_name) {
+  for (const auto& data : *AllocationSiteProfiler::Get()->data_list()) {
+    if (data->function_name() == function_name) return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+TEST(AllocationSiteProfilerCountsInlineAllocations) {
+  if (FLAG_always_opt || !FLAG_opt) return;
+  FLAG_allow_natives_syntax = true;
+  FLAG_turbo_allocation_profiling = true;
+  FLAG_turbo_allocation_profiling_interval = 1;
+  CcTest::InitializeVM();
+  if (!CcTest::i_isolate()->use_optimizer()) return;
+  v8::HandleScope scope(CcTest::isolate());
+
+  CompileRun(
+      "function f(x) { return {x: x}; }"
+      "%PrepareFunctionForOptimization(f);"
+      "f(1); f(2);"
+      "%OptimizeFunctionOnNextCall(f);"
+      "f(3);");
+  AllocationSiteProfiler::Get()->ResetCounts();
+  CHECK_EQ(0u, CountersFor("f").count);
+
+  CompileRun("for (var i = 0; i < 10; i++) f(i);");
+  AllocationSiteProfilerData::Counters counters = CountersFor("f");
+  CHECK_EQ(10u, counters.count);
+  CHECK_LE(10u * JSObject::kHeaderSize, counters.bytes);
+  CHECK_EQ(0u, counters.bytes % 10);
+
+  // The site is attributed to its position in the source.
+  bool found = false;
+  for (const auto& data : *AllocationSiteProfiler::Get()->data_list()) {
+    if (data->function_name() != "f") continue;
+    for (const AllocationSiteProfilerData::Site& site : data->sites()) {
+      if (site.counters.count == 0) continue;
+      CHECK_EQ(0, strcmp("f", site.function_name.c_str()));
+      CHECK(site.position.IsKnown());
+      found = true;
+    }
+  }
+  CHECK(found);
+}
+
+TEST(AllocationSiteProfilerSamplesAllocations) {
+  if (FLAG_always_opt || !FLAG_opt) return;
+  FLAG_allow_natives_syntax = true;
+  FLAG_turbo_allocation_profiling = true;
+  FLAG_turbo_allocation_profiling_interval = 4;
+  CcTest::InitializeVM();
+  if (!CcTest::i_isolate()->use_optimizer()) return;
+  v8::HandleScope scope(CcTest::isolate());
+
+  CompileRun(
+      "function f(x) { return {x: x}; }"
+      "%PrepareFunctionForOptimization(f);"
+      "f(1); f(2);"
+      "%OptimizeFunctionOnNextCall(f);"
+      "f(3);");
+  AllocationSiteProfiler::Get()->ResetCounts();
+
+  // Every fourth allocation is sampled, and stands for four allocations.
+  CompileRun("for (var i = 0; i < 3; i++) f(i);");
+  CHECK_EQ(0u, CountersFor("f").count);
+  CompileRun("f(3);");
+  AllocationSiteProfilerData::Counters counters = CountersFor("f");
+  CHECK_EQ(4u, counters.count);
+  CHECK_LE(4u * JSObject::kHeaderSize, counters.bytes);
+  CompileRun("for (var i = 0; i < 36; i++) f(i);");
+  CHECK_EQ(40u, CountersFor("f").count);
+  CHECK_EQ(10 * counters.bytes, CountersFor("f").bytes);
+}
+
+TEST(AllocationSiteProfilerFreesDataOfCollectedCode) {
+  if (FLAG_always_opt || !FLAG_opt) return;
+  FLAG_allow_natives_syntax = true;
+  FLAG_turbo_allocation_profiling = true;
+  FLAG_turbo_allocation_profiling_interval = 1;
+  CcTest::InitializeVM();
+  if (!CcTest::i_isolate()->use_optimizer()) return;
+
+  {
+    v8::HandleScope scope(CcTest::isolate());
+    CompileRun(
+        "(function() {"
+        "  function g(x) { return {x: x}; }"
+        "  %PrepareFunctionForOptimization(g);"
+        "  g(1); g(2);"
+        "  %OptimizeFunctionOnNextCall(g);"
+        "  for (var i = 0; i < 10; i++) g(i);"
+        "})();");
+  }
+  CHECK(HasDataFor("g"));
+  CHECK_EQ(10u, CountersFor("g").count);
+
+  CcTest::CollectAllAvailableGarbage();
+  CHECK(!HasDataFor("g"));
+
+  // The counts of the collected code are still reported.
+  std::ostringstream os;
+  AllocationSiteProfiler::Get()->Print(os);
+  CHECK_NE(std::string::npos, os.str().find(" 10  g:"));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
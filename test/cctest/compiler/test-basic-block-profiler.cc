@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <sstream>
+
 #include "src/diagnostics/basic-block-profiler.h"
 #include "src/objects/objects-inl.h"
 #include "test/cctest/cctest.h"
@@ -109,6 +111,62 @@ TEST(ProfileLoop) {
   }
 }
 
+namespace {
+
+// Returns the number of deferred blocks in the schedule of the last function
+// compiled with --turbo-profiling-verbose.
+int CountDeferredBlocksInLastSchedule() {
+  const BasicBlockProfiler::DataList* l =
+      BasicBlockProfiler::Get()->data_list();
+  CHECK_NE(0, static_cast<int>(l->size()));
+  std::ostringstream os;
+  os << *l->back();
+  // The schedule is printed before the block counts.
+  std::string schedule = os.str();
+  schedule = schedule.substr(0, schedule.find("block counts for"));
+  int count = 0;
+  for (size_t pos = schedule.find("(deferred)"); pos != std::string::npos;
+       pos = schedule.find("(deferred)", pos + 1)) {
+    count++;
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST(BranchFeedbackDefersColdBranch) {
+  if (FLAG_always_opt || !FLAG_opt) return;
+  FLAG_allow_natives_syntax = true;
+  FLAG_branch_feedback = true;
+  FLAG_turbo_profiling = true;
+  FLAG_turbo_profiling_verbose = true;
+  // Only the functions under test are compiled.
+  FLAG_use_osr = false;
+  CcTest::InitializeVM();
+  if (!CcTest::i_isolate()->use_optimizer()) return;
+  v8::HandleScope scope(CcTest::isolate());
+
+  // Both functions only differ in their branch counts.
+  CompileRun(
+      "function hot(x) { if (x) return 1; return 2; }"
+      "%PrepareFunctionForOptimization(hot);"
+      "for (var i = 0; i < 1000; i++) hot(1);"
+      "%OptimizeFunctionOnNextCall(hot);"
+      "hot(1);");
+  int hot_deferred = CountDeferredBlocksInLastSchedule();
+
+  CompileRun(
+      "function balanced(x) { if (x) return 1; return 2; }"
+      "%PrepareFunctionForOptimization(balanced);"
+      "for (var i = 0; i < 1000; i++) balanced(i & 1);"
+      "%OptimizeFunctionOnNextCall(balanced);"
+      "balanced(1);");
+  int balanced_deferred = CountDeferredBlocksInLastSchedule();
+
+  // The never taken branch of {hot} is deferred.
+  CHECK_LT(balanced_deferred, hot_deferred);
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
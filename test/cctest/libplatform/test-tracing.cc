@@ -139,6 +139,62 @@ TEST(TestTraceBufferRingBuffer) {
   }
   delete ring_buffer;
 }
+
+TEST(TestTraceBufferPerThread) {
+  const int HANDLES_COUNT = TraceBufferChunk::kChunkSize * 2 + 1;
+  MockTraceWriter* writer = new MockTraceWriter();
+  TraceBuffer* buffer = TraceBuffer::CreateTraceBufferPerThread(3, writer);
+  std::string names[HANDLES_COUNT];
+  for (int i = 0; i < HANDLES_COUNT; ++i) {
+    names[i] = "Test.EventNo" + std::to_string(i);
+  }
+
+  // Complete events are not written before their duration is final, so all
+  // of them are kept until Flush().
+  std::vector<uint64_t> handles(HANDLES_COUNT);
+  uint8_t category_enabled_flag = 41;
+  for (size_t i = 0; i < handles.size(); ++i) {
+    TraceObject* trace_object = buffer->AddTraceEvent(&handles[i]);
+    CHECK_NOT_NULL(trace_object);
+    trace_object->Initialize('X', &category_enabled_flag, names[i].c_str(),
+                             "Test.Scope", 42, 123, 0, nullptr, nullptr,
+                             nullptr, nullptr, 0, 1729, 4104);
+    buffer->CommitTraceEvent(handles[i]);
+  }
+  for (size_t i = 0; i < handles.size(); ++i) {
+    TraceObject* trace_object = buffer->GetEventByHandle(handles[i]);
+    CHECK_NOT_NULL(trace_object);
+    CHECK_EQ('X', trace_object->phase());
+    CHECK_EQ(names[i], std::string(trace_object->name()));
+  }
+
+  // All chunks are in use.
+  uint64_t handle;
+  for (size_t i = handles.size(); i < 3 * TraceBufferChunk::kChunkSize; ++i) {
+    TraceObject* trace_object = buffer->AddTraceEvent(&handle);
+    CHECK_NOT_NULL(trace_object);
+    trace_object->Initialize('X', &category_enabled_flag, "Test.Filler",
+                             "Test.Scope", 42, 123, 0, nullptr, nullptr,
+                             nullptr, nullptr, 0, 1729, 4104);
+    buffer->CommitTraceEvent(handle);
+  }
+  CHECK_NULL(buffer->AddTraceEvent(&handle));
+
+  buffer->Flush();
+  auto events = writer->events();
+  CHECK_EQ(3 * TraceBufferChunk::kChunkSize, events.size());
+  for (size_t i = 0; i < handles.size(); ++i) {
+    CHECK_EQ(names[i], events[i]);
+  }
+  // Flushing frees the chunks, later duration updates are ignored.
+  for (size_t i = 0; i < handles.size(); ++i) {
+    CHECK_NULL(buffer->GetEventByHandle(handles[i]));
+    buffer->UpdateTraceEventDuration(handles[i], 1730, 4105);
+  }
+  CHECK_NOT_NULL(buffer->AddTraceEvent(&handle));
+  buffer->CommitTraceEvent(handle);
+  delete buffer;
+}
 #endif  // !defined(V8_USE_PERFETTO)
 
 // Perfetto has an internal JSON exporter.
@@ -526,6 +582,110 @@ TEST(AddTraceEventMultiThreaded) {
 
   i::V8::SetPlatformForTesting(old_platform);
 }
+
+class CompleteEventsThread : public base::Thread {
+ public:
+  CompleteEventsThread(
+      v8::platform::tracing::TracingController* tracing_controller,
+      const uint8_t* category_enabled_flag, int count)
+      : base::Thread(base::Thread::Options("CompleteEventsThread")),
+        tracing_controller_(tracing_controller),
+        category_enabled_flag_(category_enabled_flag),
+        count_(count) {}
+
+  void Run() override {
+    for (int i = 0; i < count_; ++i) {
+      uint64_t handle = tracing_controller_->AddTraceEvent(
+          'X', category_enabled_flag_, "v8.Test", "", 0, 0, 0, nullptr,
+          nullptr, nullptr, nullptr, 0);
+      tracing_controller_->UpdateTraceEventDuration(category_enabled_flag_,
+                                                    "v8.Test", handle);
+    }
+  }
+
+ private:
+  v8::platform::tracing::TracingController* tracing_controller_;
+  const uint8_t* category_enabled_flag_;
+  int count_;
+};
+
+TEST(AddTraceEventMultiThreadedPerThreadBuffer) {
+  const int kThreads = 4;
+  const int kEventsPerThread = 1000;
+  auto tracing_controller =
+      std::make_unique<v8::platform::tracing::TracingController>();
+  MockTraceWriter* writer = new MockTraceWriter();
+  tracing_controller->Initialize(TraceBuffer::CreateTraceBufferPerThread(
+      TraceBuffer::kRingBufferChunks, writer));
+  TraceConfig* trace_config = new TraceConfig();
+  trace_config->AddIncludedCategory("v8");
+  tracing_controller->StartTracing(trace_config);
+
+  const uint8_t* category_enabled_flag =
+      tracing_controller->GetCategoryGroupEnabled("v8");
+  std::vector<std::unique_ptr<CompleteEventsThread>> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back(new CompleteEventsThread(
+        tracing_controller.get(), category_enabled_flag, kEventsPerThread));
+    CHECK(threads.back()->Start());
+  }
+  for (auto& thread : threads) thread->Join();
+  tracing_controller->StopTracing();
+
+  // Full chunks have been written in the background, the rest on flushing.
+  auto events = writer->events();
+  CHECK_EQ(static_cast<size_t>(kThreads * kEventsPerThread), events.size());
+  for (const std::string& name : events) {
+    CHECK_EQ(std::string("v8.Test"), name);
+  }
+}
+
+class BufferEventsThread : public base::Thread {
+ public:
+  BufferEventsThread(TraceBuffer* buffer, int count)
+      : base::Thread(base::Thread::Options("BufferEventsThread")),
+        buffer_(buffer),
+        count_(count) {}
+
+  void Run() override {
+    uint8_t category_enabled_flag = 41;
+    for (int i = 0; i < count_; ++i) {
+      uint64_t handle;
+      TraceObject* trace_object = buffer_->AddTraceEvent(&handle);
+      CHECK_NOT_NULL(trace_object);
+      trace_object->Initialize('X', &category_enabled_flag, "Test.Event",
+                               "Test.Scope", 42, 123, 0, nullptr, nullptr,
+                               nullptr, nullptr, 0, 1729, 4104);
+      buffer_->CommitTraceEvent(handle);
+      buffer_->UpdateTraceEventDuration(handle, 1730, 4105);
+    }
+  }
+
+ private:
+  TraceBuffer* buffer_;
+  int count_;
+};
+
+TEST(FlushPerThreadBufferWhileAddingEvents) {
+  const int kThreads = 4;
+  const int kEventsPerThread = 10000;
+  MockTraceWriter* writer = new MockTraceWriter();
+  std::unique_ptr<TraceBuffer> buffer(TraceBuffer::CreateTraceBufferPerThread(
+      TraceBuffer::kRingBufferChunks, writer));
+  std::vector<std::unique_ptr<BufferEventsThread>> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back(
+        new BufferEventsThread(buffer.get(), kEventsPerThread));
+    CHECK(threads.back()->Start());
+  }
+  // Flushing takes the chunks the threads are adding events to, no events
+  // are dropped.
+  for (int i = 0; i < 100; ++i) buffer->Flush();
+  for (auto& thread : threads) thread->Join();
+  buffer->Flush();
+  CHECK_EQ(static_cast<size_t>(kThreads * kEventsPerThread),
+           writer->events().size());
+}
 #endif  // !defined(V8_USE_PERFETTO)
 
 #ifdef V8_USE_PERFETTO
@@ -28579,3 +28579,248 @@ TEST(TriggerThreadSafeMetricsEvent) {
   CHECK_EQ(recorder->count_, 1);  // Increased.
   CHECK_EQ(recorder->module_count_, 42);
 }
+
+namespace {
+
+class EngineMetricsRecorder : public v8::metrics::Recorder {
+ public:
+  size_t full_gc_count_ = 0;
+  size_t young_gc_count_ = 0;
+  size_t compile_job_count_ = 0;
+  size_t successful_compile_job_count_ = 0;
+  std::vector<v8::metrics::Deoptimization> deopts_;
+
+  void AddMainThreadEvent(const v8::metrics::GarbageCollectionFullCycle& event,
+                          v8::metrics::Recorder::ContextId id) override {
+    ++full_gc_count_;
+    CHECK_NOT_NULL(event.reason);
+    CHECK_LE(0, event.atomic_pause_wall_clock_duration_in_us);
+    CHECK_LE(0, event.main_thread.mark_wall_clock_duration_in_us);
+    CHECK_LE(0, event.objects.bytes_after);
+    CHECK_EQ(event.objects.bytes_before - event.objects.bytes_after,
+             event.objects.bytes_freed);
+  }
+
+  void AddMainThreadEvent(const v8::metrics::GarbageCollectionYoungCycle& event,
+                          v8::metrics::Recorder::ContextId id) override {
+    ++young_gc_count_;
+    CHECK_NOT_NULL(event.reason);
+    CHECK_LE(0, event.total_wall_clock_duration_in_us);
+    CHECK_LE(event.survived_bytes, event.young_object_bytes_before);
+  }
+
+  void AddMainThreadEvent(const v8::metrics::TurbofanCompileJob& event,
+                          v8::metrics::Recorder::ContextId id) override {
+    ++compile_job_count_;
+    CHECK(!id.IsEmpty());
+    if (!event.success) return;
+    ++successful_compile_job_count_;
+    CHECK_LT(0u, event.bytecode_size_in_bytes);
+    CHECK_LT(0u, event.code_size_in_bytes);
+    CHECK_LE(0, event.execute_wall_clock_duration_in_us);
+  }
+
+  void AddMainThreadEvent(const v8::metrics::Deoptimization& event,
+                          v8::metrics::Recorder::ContextId id) override {
+    CHECK(!id.IsEmpty());
+    deopts_.push_back(event);
+  }
+};
+
+}  // namespace
+
+TEST(GarbageCollectionMetricsEvents) {
+  v8::Isolate* iso = CcTest::isolate();
+  std::shared_ptr<EngineMetricsRecorder> recorder =
+      std::make_shared<EngineMetricsRecorder>();
+  iso->SetMetricsRecorder(recorder);
+
+  CcTest::CollectAllGarbage();
+  CHECK_LE(1u, recorder->full_gc_count_);
+
+  if (!i::FLAG_single_generation) {
+    size_t young_gc_count = recorder->young_gc_count_;
+    CcTest::CollectGarbage(i::NEW_SPACE);
+    CHECK_LT(young_gc_count, recorder->young_gc_count_);
+  }
+}
+
+TEST(CompileAndDeoptimizationMetricsEvents) {
+  if (!i::FLAG_opt || i::FLAG_always_opt) return;
+  i::FLAG_allow_natives_syntax = true;
+  // Keep the test deterministic.
+  i::FLAG_concurrent_recompilation = false;
+
+  LocalContext env;
+  v8::Isolate* iso = env->GetIsolate();
+  v8::HandleScope scope(iso);
+  std::shared_ptr<EngineMetricsRecorder> recorder =
+      std::make_shared<EngineMetricsRecorder>();
+  iso->SetMetricsRecorder(recorder);
+
+  v8::Local<v8::Script> script = v8_compile(
+      "function f(o) { return o.a; };"
+      "%PrepareFunctionForOptimization(f);"
+      "f({a: 1});"
+      "f({a: 2});"
+      "%OptimizeFunctionOnNextCall(f);"
+      "f({a: 3});");
+  script->Run(env.local()).ToLocalChecked();
+  CHECK_EQ(1u, recorder->compile_job_count_);
+  CHECK_EQ(1u, recorder->successful_compile_job_count_);
+  CHECK(recorder->deopts_.empty());
+
+  CompileRun("f({b: 1, a: 4});");
+  CHECK_EQ(1u, recorder->deopts_.size());
+  const v8::metrics::Deoptimization& deopt = recorder->deopts_[0];
+  CHECK_EQ(0, strcmp("deopt-eager", deopt.kind));
+  CHECK_EQ(0, strcmp("wrong map", deopt.reason));
+  CHECK_EQ(script->GetUnboundScript()->GetId(), deopt.script_id);
+  CHECK_LE(0, deopt.position);
+}
+
+namespace {
+
+class DeoptimizationStatisticsCollector
+    : public v8::DeoptimizationStatisticsVisitor {
+ public:
+  struct Entry {
+    std::string function_name;
+    std::string reason;
+    v8::DeoptimizationStatisticsEntry entry;
+  };
+
+  void VisitEntry(const v8::DeoptimizationStatisticsEntry& entry) override {
+    entries_.push_back({entry.function_name, entry.reason, entry});
+  }
+
+  std::vector<Entry> entries_;
+};
+
+}  // namespace
+
+TEST(DeoptimizationStatistics) {
+  if (!i::FLAG_opt || i::FLAG_always_opt) return;
+  i::FLAG_allow_natives_syntax = true;
+  i::FLAG_concurrent_recompilation = false;
+
+  LocalContext env;
+  v8::Isolate* iso = env->GetIsolate();
+  v8::HandleScope scope(iso);
+  iso->ResetDeoptimizationStatistics();
+
+  v8::Local<v8::Script> script = v8_compile(
+      "function f(o) { return o.a; };"
+      "%PrepareFunctionForOptimization(f);"
+      "f({a: 1});"
+      "f({a: 2});"
+      "%OptimizeFunctionOnNextCall(f);"
+      "f({a: 3});"
+      "f({b: 1, a: 4});"
+      "%PrepareFunctionForOptimization(f);"
+      "%OptimizeFunctionOnNextCall(f);"
+      "f({a: 5});"
+      "f({c: 1, a: 6});");
+  script->Run(env.local()).ToLocalChecked();
+
+  DeoptimizationStatisticsCollector collector;
+  iso->GetDeoptimizationStatistics(&collector);
+  CHECK_EQ(1u, collector.entries_.size());
+  const DeoptimizationStatisticsCollector::Entry& entry =
+      collector.entries_[0];
+  CHECK_EQ(std::string("f"), entry.function_name);
+  CHECK_EQ(std::string("wrong map"), entry.reason);
+  CHECK_EQ(script->GetUnboundScript()->GetId(), entry.entry.script_id);
+  CHECK_LE(0, entry.entry.function_position);
+  CHECK_EQ(2u, entry.entry.count);
+  CHECK_EQ(script->GetUnboundScript()->GetId(), entry.entry.last_script_id);
+  CHECK_LT(entry.entry.function_position, entry.entry.last_position);
+  CHECK_EQ(1u, entry.entry.reoptimization_count);
+
+  iso->ResetDeoptimizationStatistics();
+  collector.entries_.clear();
+  iso->GetDeoptimizationStatistics(&collector);
+  CHECK(collector.entries_.empty());
+}
+
+namespace {
+
+class InlineCacheSiteCollector : public v8::InlineCacheSiteVisitor {
+ public:
+  struct Site {
+    std::string function_name;
+    std::string kind;
+    v8::InlineCacheSite site;
+  };
+
+  void VisitSite(const v8::InlineCacheSite& site) override {
+    sites_.push_back({site.function_name, site.kind, site});
+  }
+
+  std::vector<Site> sites_;
+};
+
+}  // namespace
+
+TEST(InlineCacheCensus) {
+  if (i::FLAG_lite_mode) return;
+  i::FLAG_allow_natives_syntax = true;
+
+  LocalContext env;
+  v8::Isolate* iso = env->GetIsolate();
+  v8::HandleScope scope(iso);
+
+  const char* source =
+      "function mono(o) { return o.x; }"
+      "%EnsureFeedbackVectorForFunction(mono);"
+      "mono({x: 1});"
+      "mono({x: 2});"
+      "function poly(o) { return o.x; }"
+      "%EnsureFeedbackVectorForFunction(poly);"
+      "poly({x: 1});"
+      "poly({x: 1, y: 2});"
+      "function mega(o) { return o.x; }"
+      "%EnsureFeedbackVectorForFunction(mega);"
+      "for (var i = 0; i < 10; i++) mega({['p' + i]: i, x: 1});";
+  v8::Local<v8::Script> script = v8_compile(source);
+  script->Run(env.local()).ToLocalChecked();
+  int script_id = script->GetUnboundScript()->GetId();
+
+  InlineCacheSiteCollector collector;
+  iso->GetInlineCacheCensus(&collector, 100);
+  const InlineCacheSiteCollector::Site* mega = nullptr;
+  const InlineCacheSiteCollector::Site* poly = nullptr;
+  for (const InlineCacheSiteCollector::Site& site : collector.sites_) {
+    CHECK_NE(std::string("mono"), site.function_name);
+    if (site.function_name == "mega") mega = &site;
+    if (site.function_name == "poly") poly = &site;
+  }
+  CHECK_NOT_NULL(mega);
+  CHECK_NOT_NULL(poly);
+  // Megamorphic sites are reported first.
+  CHECK_EQ(std::string("mega"), collector.sites_[0].function_name);
+
+  std::string source_string(source);
+  CHECK(mega->site.megamorphic);
+  CHECK_EQ(std::string("LoadProperty"), mega->kind);
+  CHECK_EQ(0, mega->site.map_count);
+  CHECK_EQ(10, mega->site.invocation_count);
+  CHECK_EQ(script_id, mega->site.script_id);
+  CHECK_LT(static_cast<int>(source_string.find("function mega")),
+           mega->site.position);
+
+  CHECK(!poly->site.megamorphic);
+  CHECK_EQ(std::string("LoadProperty"), poly->kind);
+  CHECK_EQ(2, poly->site.map_count);
+  CHECK_EQ(2, poly->site.invocation_count);
+  CHECK_EQ(script_id, poly->site.script_id);
+  CHECK_LT(static_cast<int>(source_string.find("function poly")),
+           poly->site.position);
+  CHECK_GT(static_cast<int>(source_string.find("function mega")),
+           poly->site.position);
+
+  InlineCacheSiteCollector top;
+  iso->GetInlineCacheCensus(&top, 1);
+  CHECK_EQ(1u, top.sites_.size());
+  CHECK_EQ(std::string("mega"), top.sites_[0].function_name);
+}
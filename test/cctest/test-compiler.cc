@@ -27,7 +27,10 @@
 
 #include <stdlib.h>
 #include <wchar.h>
+#include <fstream>
+#include <functional>
 #include <memory>
+#include <string>
 
 #include "src/init/v8.h"
 
@@ -37,6 +40,7 @@
 #include "src/codegen/compilation-cache.h"
 #include "src/codegen/compiler.h"
 #include "src/diagnostics/disasm.h"
+#include "src/execution/runtime-profiler.h"
 #include "src/heap/factory.h"
 #include "src/heap/spaces.h"
 #include "src/interpreter/interpreter.h"
@@ -1129,5 +1133,104 @@ TEST(ProfilerEnabledDuringBackgroundCompile) {
   cpu_profiler->StopProfiling(profile);
 }
 
+namespace {
+
+const char* kHotFunctionsSource =
+    "function hot(n) {"
+    "  let sum = 0;"
+    "  for (let i = 0; i < n; ++i) sum += i;"
+    "  return sum;"
+    "}"
+    "function cold() { return 0; }";
+
+// Runs the {source} in a fresh isolate, which reads and writes the hot
+// functions files at creation and disposal.
+void RunWithHotFunctions(const char* source,
+                         std::function<void(i::Isolate*)> check) {
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    LocalContext context(isolate);
+    CompileRunWithOrigin(source, "hot-functions.js");
+    check(reinterpret_cast<i::Isolate*>(isolate));
+  }
+  isolate->Dispose();
+}
+
+Handle<JSFunction> GetFunctionFromIsolate(i::Isolate* isolate,
+                                          const char* name) {
+  Handle<String> name_string =
+      isolate->factory()->NewStringFromAsciiChecked(name);
+  Handle<JSObject> global(isolate->context().global_object(), isolate);
+  return Handle<JSFunction>::cast(
+      JSReceiver::GetProperty(isolate, global, name_string).ToHandleChecked());
+}
+
+}  // namespace
+
+// Tests that the functions marked for optimization in one run are optimized
+// early in the next one.
+TEST(HotFunctionsRoundTrip) {
+  if (!FLAG_opt || FLAG_always_opt || FLAG_lite_mode) return;
+  std::string path = "hot-functions-" +
+                     std::to_string(base::OS::GetCurrentProcessId()) + ".txt";
+
+  FLAG_hot_functions_output = path.c_str();
+  std::string source =
+      std::string(kHotFunctionsSource) + "hot(1e6); cold();";
+  // The loop in {hot} runs long enough to get it marked for optimization,
+  // and it is written to the file right away.
+  RunWithHotFunctions(source.c_str(), [&path](i::Isolate* isolate) {
+    std::ifstream file(path);
+    std::string line;
+    CHECK(std::getline(file, line));
+    CHECK_NE(std::string::npos, line.find(",hot-functions.js"));
+  });
+  FLAG_hot_functions_output = nullptr;
+
+  FLAG_hot_functions_input = path.c_str();
+  source = std::string(kHotFunctionsSource) + "hot(1); cold();";
+  RunWithHotFunctions(source.c_str(), [](i::Isolate* isolate) {
+    // {hot} is marked for optimization on its first call, and only then.
+    Handle<JSFunction> hot = GetFunctionFromIsolate(isolate, "hot");
+    CHECK(hot->HasOptimizationMarker() || hot->IsInOptimizationQueue() ||
+          hot->HasAvailableOptimizedCode());
+    RuntimeProfiler* profiler = isolate->runtime_profiler();
+    CHECK(!profiler->ConsumeHotInProfile(hot->shared()));
+    Handle<JSFunction> cold = GetFunctionFromIsolate(isolate, "cold");
+    CHECK(!cold->HasOptimizationMarker() && !cold->IsInOptimizationQueue() &&
+          !cold->HasAvailableOptimizedCode());
+  });
+  FLAG_hot_functions_input = nullptr;
+
+  base::OS::Remove(path.c_str());
+}
+
+// Tests that isolates writing to the same file do not overwrite each other's
+// hot functions.
+TEST(HotFunctionsOfSeveralIsolates) {
+  if (!FLAG_opt || FLAG_always_opt || FLAG_lite_mode) return;
+  std::string path = "hot-functions-shared-" +
+                     std::to_string(base::OS::GetCurrentProcessId()) + ".txt";
+
+  FLAG_hot_functions_output = path.c_str();
+  std::string source = std::string(kHotFunctionsSource) + "hot(1e6);";
+  RunWithHotFunctions(source.c_str(), [](i::Isolate* isolate) {});
+  RunWithHotFunctions(kHotFunctionsSource, [](i::Isolate* isolate) {});
+  FLAG_hot_functions_output = nullptr;
+
+  FLAG_hot_functions_input = path.c_str();
+  RunWithHotFunctions(kHotFunctionsSource, [](i::Isolate* isolate) {
+    CHECK(isolate->runtime_profiler()->ConsumeHotInProfile(
+        GetFunctionFromIsolate(isolate, "hot")->shared()));
+  });
+  FLAG_hot_functions_input = nullptr;
+
+  base::OS::Remove(path.c_str());
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -34,6 +34,7 @@
 #include "include/v8-profiler.h"
 #include "src/api/api-inl.h"
 #include "src/base/platform/platform.h"
+#include "src/base/platform/semaphore.h"
 #include "src/codegen/source-position-table.h"
 #include "src/deoptimizer/deoptimizer.h"
 #include "src/heap/spaces.h"
@@ -3737,6 +3738,222 @@ UNINITIALIZED_TEST(DetailedSourcePositionAPI_Inlining) {
   isolate->Dispose();
 }
 
+namespace {
+
+class TestContinuousProfileDelegate : public v8::ContinuousProfileDelegate {
+ public:
+  void OnProfileChunk(const uint8_t* data, size_t size) override {
+    chunks_.emplace_back(reinterpret_cast<const char*>(data), size);
+  }
+
+  const std::vector<std::string>& chunks() const { return chunks_; }
+
+ private:
+  std::vector<std::string> chunks_;
+};
+
+}  // namespace
+
+TEST(ContinuousProfiling) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+
+  TestContinuousProfileDelegate delegate;
+  v8::CpuProfiler* profiler = v8::CpuProfiler::New(env->GetIsolate());
+  profiler->SetSamplingInterval(100);
+  CHECK(profiler->StartContinuousProfiling(&delegate, 1));
+  CHECK(!profiler->StartContinuousProfiling(&delegate, 1));
+  CompileRun(R"(
+      function busyLoop() {
+        const start = Date.now();
+        while (Date.now() - start < 200) {}
+      }
+      busyLoop();
+  )");
+  profiler->StopContinuousProfiling();
+  size_t chunk_count = delegate.chunks().size();
+  CHECK_LT(1u, chunk_count);
+
+  // Each chunk is a pprof Profile starting with a sample_type field, and
+  // carries its own string table.
+  for (const std::string& chunk : delegate.chunks()) {
+    CHECK_EQ('\x0a', chunk[0]);
+    CHECK_NE(std::string::npos, chunk.find("samples"));
+    CHECK_NE(std::string::npos, chunk.find("nanoseconds"));
+  }
+  bool found_busy_loop = false;
+  for (const std::string& chunk : delegate.chunks()) {
+    if (chunk.find("busyLoop") != std::string::npos) found_busy_loop = true;
+  }
+  CHECK(found_busy_loop);
+
+  // Nothing is delivered once continuous profiling has stopped.
+  CompileRun("busyLoop();");
+  CHECK_EQ(chunk_count, delegate.chunks().size());
+  profiler->Dispose();
+}
+
+TEST(ContinuousProfilingWithRegularProfile) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+
+  TestContinuousProfileDelegate delegate;
+  std::unique_ptr<CpuProfiler> profiler(new CpuProfiler(CcTest::i_isolate()));
+  profiler->set_sampling_interval(base::TimeDelta::FromMicroseconds(100));
+  profiler->StartProfiling("regular", {kLeafNodeLineNumbers});
+  CHECK(profiler->StartContinuousProfiling(
+      &delegate, base::TimeDelta::FromSeconds(100), 10000));
+
+  CompileRun(R"(
+      const start = Date.now();
+      while (Date.now() - start < 50) {}
+  )");
+
+  // Stopping the regular profile keeps the processor alive for continuous
+  // profiling.
+  CHECK(profiler->StopProfiling("regular"));
+  CHECK(profiler->is_profiling());
+  CHECK(delegate.chunks().empty());
+
+  profiler->StopContinuousProfiling();
+  CHECK(!profiler->is_profiling());
+  CHECK_EQ(1u, delegate.chunks().size());
+}
+
+TEST(ContinuousProfilingDeleteAllProfiles) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+
+  TestContinuousProfileDelegate delegate;
+  std::unique_ptr<CpuProfiler> profiler(new CpuProfiler(CcTest::i_isolate()));
+  profiler->set_sampling_interval(base::TimeDelta::FromMicroseconds(100));
+  CHECK(profiler->StartContinuousProfiling(
+      &delegate, base::TimeDelta::FromSeconds(100), 10000));
+  CompileRun(R"(
+      const start = Date.now();
+      while (Date.now() - start < 50) {}
+  )");
+  CHECK(delegate.chunks().empty());
+
+  // The pending window is delivered rather than deleted.
+  profiler->DeleteAllProfiles();
+  CHECK(!profiler->is_profiling());
+  CHECK_EQ(1u, delegate.chunks().size());
+}
+
+TEST(ContinuousProfileFlushedWithoutSamples) {
+  TestContinuousProfileDelegate delegate;
+  CpuProfilesCollection profiles(CcTest::i_isolate());
+  CHECK(profiles.StartContinuousProfiling(
+      &delegate, base::TimeDelta::FromMilliseconds(10), 10000));
+
+  CodeEntry entry(CodeEventListener::FUNCTION_TAG, "quietFunction");
+  ProfileStackTrace path = {{&entry, 1}};
+  base::TimeTicks start = base::TimeTicks::HighResolutionNow();
+  profiles.AddPathToCurrentProfiles(start, path, 1, true,
+                                    base::TimeDelta::FromMicroseconds(100));
+
+  // The window is handed over once it is due, without another sample.
+  profiles.FlushContinuousProfileIfDue(start +
+                                       base::TimeDelta::FromMilliseconds(5));
+  CHECK(delegate.chunks().empty());
+  profiles.FlushContinuousProfileIfDue(start +
+                                       base::TimeDelta::FromMilliseconds(10));
+  CHECK_EQ(1u, delegate.chunks().size());
+  CHECK_NE(std::string::npos, delegate.chunks()[0].find("quietFunction"));
+
+  // Empty windows are not delivered.
+  profiles.FlushContinuousProfileIfDue(start + base::TimeDelta::FromSeconds(1));
+  profiles.StopContinuousProfiling();
+  CHECK_EQ(1u, delegate.chunks().size());
+}
+
+namespace {
+
+// Blocks the profiler thread in the first chunk until released.
+class BlockingContinuousProfileDelegate
+    : public v8::ContinuousProfileDelegate {
+ public:
+  void OnProfileChunk(const uint8_t* data, size_t size) override {
+    if (blocked_) return;
+    blocked_ = true;
+    entered_.Signal();
+    released_.Wait();
+  }
+
+  void WaitUntilBlocked() { entered_.Wait(); }
+  void Release() { released_.Signal(); }
+
+ private:
+  bool blocked_ = false;
+  base::Semaphore entered_{0};
+  base::Semaphore released_{0};
+};
+
+}  // namespace
+
+TEST(ContinuousProfilingDelegateDoesNotBlockProfiles) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+
+  BlockingContinuousProfileDelegate delegate;
+  std::unique_ptr<CpuProfiler> profiler(new CpuProfiler(CcTest::i_isolate()));
+  profiler->set_sampling_interval(base::TimeDelta::FromMicroseconds(100));
+  // Every sample fills the window.
+  CHECK(profiler->StartContinuousProfiling(
+      &delegate, base::TimeDelta::FromSeconds(100), 1));
+  delegate.WaitUntilBlocked();
+
+  // The delegate is called without holding the lock on the current profiles,
+  // so profiles can be started and stopped while it runs.
+  profiler->StartProfiling("regular");
+  CHECK(profiler->StopProfiling("regular"));
+
+  delegate.Release();
+  profiler->StopContinuousProfiling();
+  CHECK(!profiler->is_profiling());
+}
+
+namespace {
+
+uint64_t TotalCounterValue(const v8::CpuProfileNode* node,
+                           v8::CpuProfilingCounter counter) {
+  uint64_t total = node->GetCounterValue(counter);
+  for (int i = 0; i < node->GetChildrenCount(); i++) {
+    total += TotalCounterValue(node->GetChild(i), counter);
+  }
+  return total;
+}
+
+}  // namespace
+
+TEST(HardwareCounterSampling) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+
+  v8::CpuProfiler* profiler = v8::CpuProfiler::New(isolate);
+  // Hardware counters are not available on every platform and machine.
+  if (!profiler->SetHardwareCounterSampling(v8::kCpuCycles, 1000000)) {
+    profiler->Dispose();
+    return;
+  }
+  v8::Local<v8::String> title = v8_str("counters");
+  profiler->StartProfiling(title, v8::CpuProfilingOptions());
+  CompileRun(R"(
+      const start = Date.now();
+      while (Date.now() - start < 200) {}
+  )");
+  v8::CpuProfile* profile = profiler->StopProfiling(title);
+
+  const v8::CpuProfileNode* root = profile->GetTopDownRoot();
+  CHECK_LT(0u, TotalHitCount(root));
+  CHECK_LT(0u, TotalCounterValue(root, v8::kCpuCycles));
+
+  profile->Delete();
+  profiler->Dispose();
+}
+
 }  // namespace test_cpu_profiler
 }  // namespace internal
 }  // namespace v8
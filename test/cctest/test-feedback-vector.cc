@@ -450,6 +450,38 @@ TEST(VectorSpeculationMode) {
   CHECK_EQ(3, nexus.GetCallCount());
 }
 
+TEST(VectorBranchCounts) {
+  if (i::FLAG_always_opt) return;
+  FLAG_allow_natives_syntax = true;
+  FLAG_branch_feedback = true;
+
+  CcTest::InitializeVM();
+  LocalContext context;
+  v8::HandleScope scope(context->GetIsolate());
+  Isolate* isolate = CcTest::i_isolate();
+
+  // The if statement has a branch counter for its then and else branch.
+  CompileRun(
+      "%EnsureFeedbackVectorForFunction(f);"
+      "function f(a) { if (a) return 1; return 2; } f(true);");
+  Handle<JSFunction> f = GetFunction("f");
+  Handle<FeedbackVector> feedback_vector =
+      Handle<FeedbackVector>(f->feedback_vector(), isolate);
+
+  FeedbackNexus then_nexus(feedback_vector, FeedbackSlot(0));
+  FeedbackNexus else_nexus(feedback_vector, FeedbackSlot(1));
+  CHECK_EQ(FeedbackSlotKind::kBranchCounter, then_nexus.kind());
+  CHECK_EQ(FeedbackSlotKind::kBranchCounter, else_nexus.kind());
+  CHECK_EQ(MONOMORPHIC, then_nexus.ic_state());
+  CHECK_EQ(1, then_nexus.GetBranchCount());
+  CHECK_EQ(UNINITIALIZED, else_nexus.ic_state());
+  CHECK_EQ(0, else_nexus.GetBranchCount());
+
+  CompileRun("f(false); f(0); f({});");
+  CHECK_EQ(2, then_nexus.GetBranchCount());
+  CHECK_EQ(2, else_nexus.GetBranchCount());
+}
+
 TEST(VectorLoadICStates) {
   if (!i::FLAG_use_ic) return;
   if (i::FLAG_always_opt) return;
@@ -30,6 +30,7 @@
 #include <ctype.h>
 
 #include <memory>
+#include <set>
 
 #include "src/init/v8.h"
 
@@ -1200,6 +1201,178 @@ TEST(HeapSnapshotJSONSerializationAborting) {
 
 namespace {
 
+uint64_t ReadVarint(const i::Vector<char>& data, int* pos) {
+  uint64_t result = 0;
+  int shift = 0;
+  uint8_t byte;
+  do {
+    CHECK_LT(*pos, data.length());
+    byte = static_cast<uint8_t>(data[(*pos)++]);
+    result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    shift += 7;
+  } while (byte & 0x80);
+  return result;
+}
+
+// Reads a string of the binary format into its slot in |strings|.
+const std::string& ReadString(const i::Vector<char>& data, int* pos,
+                              std::vector<std::string>* strings) {
+  uint64_t slot_and_tag = ReadVarint(data, pos);
+  uint64_t slot = slot_and_tag >> 1;
+  CHECK_LT(slot, strings->size());
+  if (slot_and_tag & 1) {
+    int length = static_cast<int>(ReadVarint(data, pos));
+    CHECK_LE(*pos + length, data.length());
+    (*strings)[slot].assign(data.begin() + *pos, length);
+    *pos += length;
+  }
+  return (*strings)[slot];
+}
+
+}  // namespace
+
+TEST(HeapSnapshotBinarySerialization) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+  CompileRun(
+      "function BinarySnapshotClass(s) { this.s = s; }\n"
+      "var a = new BinarySnapshotClass('binary');\n");
+  const v8::HeapSnapshot* snapshot = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(snapshot));
+
+  TestJSONStream stream;
+  snapshot->Serialize(&stream, v8::HeapSnapshot::kBinary);
+  CHECK_GT(stream.size(), 0);
+  CHECK_EQ(1, stream.eos_signaled());
+  i::ScopedVector<char> data(stream.size());
+  stream.WriteTo(data);
+
+  CHECK_EQ(0, memcmp(data.begin(), "V8HS", 4));
+  int pos = 4;
+  CHECK_EQ(2u, ReadVarint(data, &pos));
+  std::vector<std::string> strings(ReadVarint(data, &pos));
+  uint64_t node_count = ReadVarint(data, &pos);
+  uint64_t edge_count = ReadVarint(data, &pos);
+  CHECK_EQ(static_cast<uint64_t>(snapshot->GetNodesCount()), node_count);
+
+  uint64_t total_edges = 0;
+  bool found_class_name = false;
+  for (uint64_t i = 0; i < node_count; ++i) {
+    ReadVarint(data, &pos);  // type
+    if (ReadString(data, &pos, &strings) == "BinarySnapshotClass") {
+      found_class_name = true;
+    }
+    uint64_t id = ReadVarint(data, &pos);
+    CHECK_EQ(snapshot->GetNode(static_cast<int>(i))->GetId(), id);
+    ReadVarint(data, &pos);  // self_size
+    total_edges += ReadVarint(data, &pos);
+    ReadVarint(data, &pos);  // trace_node_id
+    ReadVarint(data, &pos);  // detachedness
+  }
+  CHECK(found_class_name);
+  CHECK_EQ(edge_count, total_edges);
+  for (uint64_t i = 0; i < edge_count; ++i) {
+    uint64_t type = ReadVarint(data, &pos);
+    if (type == v8::HeapGraphEdge::kElement ||
+        type == v8::HeapGraphEdge::kHidden) {
+      ReadVarint(data, &pos);  // index
+    } else {
+      ReadString(data, &pos, &strings);
+    }
+    CHECK_LT(ReadVarint(data, &pos), node_count);
+  }
+  uint64_t location_count = ReadVarint(data, &pos);
+  for (uint64_t i = 0; i < location_count * 4; ++i) ReadVarint(data, &pos);
+  CHECK_EQ(data.length(), pos);
+
+  // Strings are written inline, but repeated names still refer to a slot.
+  TestJSONStream json_stream;
+  snapshot->Serialize(&json_stream, v8::HeapSnapshot::kJSON);
+  CHECK_LT(stream.size(), json_stream.size());
+}
+
+TEST(HeapSnapshotBinarySerializationManyStrings) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+  // Two dictionaries that share more than 16K distinct keys, so every key is
+  // referenced again after all other keys have been written.
+  static const int kKeyCount = 30000;
+  CompileRun(
+      "var first = {}, second = {};\n"
+      "for (var i = 0; i < 30000; i++) {\n"
+      "  first['binary_key_' + i] = i;\n"
+      "  second['binary_key_' + i] = i;\n"
+      "}\n");
+  const v8::HeapSnapshot* snapshot = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(snapshot));
+
+  TestJSONStream stream;
+  snapshot->Serialize(&stream, v8::HeapSnapshot::kBinary);
+  CHECK_EQ(1, stream.eos_signaled());
+  i::ScopedVector<char> data(stream.size());
+  stream.WriteTo(data);
+
+  int pos = 4;
+  ReadVarint(data, &pos);  // version
+  std::vector<std::string> strings(ReadVarint(data, &pos));
+  uint64_t node_count = ReadVarint(data, &pos);
+  uint64_t edge_count = ReadVarint(data, &pos);
+
+  std::set<uint64_t> used_slots;
+  int key_references = 0;
+  int inline_keys = 0;
+  auto read_string = [&]() {
+    int string_pos = pos;
+    uint64_t slot_and_tag = ReadVarint(data, &string_pos);
+    const std::string& s = ReadString(data, &pos, &strings);
+    used_slots.insert(slot_and_tag >> 1);
+    if (s.compare(0, 11, "binary_key_") == 0) {
+      ++key_references;
+      if (slot_and_tag & 1) ++inline_keys;
+    }
+  };
+  for (uint64_t i = 0; i < node_count; ++i) {
+    ReadVarint(data, &pos);  // type
+    read_string();
+    for (int j = 0; j < 5; ++j) ReadVarint(data, &pos);
+  }
+  for (uint64_t i = 0; i < edge_count; ++i) {
+    uint64_t type = ReadVarint(data, &pos);
+    if (type == v8::HeapGraphEdge::kElement ||
+        type == v8::HeapGraphEdge::kHidden) {
+      ReadVarint(data, &pos);  // index
+    } else {
+      read_string();
+    }
+    ReadVarint(data, &pos);  // to_node
+  }
+
+  // All cache slots are in use, not only those whose bits match the flag
+  // bits of a string's hash field.
+  CHECK_GT(used_slots.size(), 16 * 1024u);
+  // Every key is referenced by its string node and by both dictionaries,
+  // and repeated references are written as slot references.
+  CHECK_GE(key_references, 3 * kKeyCount);
+  CHECK_GE(inline_keys, kKeyCount);
+  CHECK_LT(inline_keys, key_references);
+}
+
+TEST(HeapSnapshotBinarySerializationAborting) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+  const v8::HeapSnapshot* snapshot = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(snapshot));
+  TestJSONStream stream(5);
+  snapshot->Serialize(&stream, v8::HeapSnapshot::kBinary);
+  CHECK_GT(stream.size(), 0);
+  CHECK_EQ(0, stream.eos_signaled());
+}
+
+namespace {
+
 class TestStatsStream : public v8::OutputStream {
  public:
   TestStatsStream()
@@ -1570,6 +1743,63 @@ TEST(TakeHeapSnapshotAborting) {
   CHECK_GT(control.total(), 0);
 }
 
+namespace {
+
+const v8::HeapProfiler::RetainedSizeSummaryEntry* FindSummaryEntry(
+    const std::vector<v8::HeapProfiler::RetainedSizeSummaryEntry>& summary,
+    const char* name) {
+  for (const auto& entry : summary) {
+    if (entry.name == name) return &entry;
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+TEST(RetainedSizeSummary) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+  CompileRun(
+      "function SummaryHolder() { this.data = new Array(1000).fill(0); }\n"
+      "var holders = [];\n"
+      "for (var i = 0; i < 10; i++) holders.push(new SummaryHolder());\n"
+      "function SummaryGarbage() {}\n"
+      "(function() {\n"
+      "  for (var i = 0; i < 10; i++) new SummaryGarbage();\n"
+      "})();\n"
+      "function SummaryNode(next) { this.next = next; }\n"
+      "var list = null;\n"
+      "for (var i = 0; i < 100; i++) list = new SummaryNode(list);\n");
+  std::vector<v8::HeapProfiler::RetainedSizeSummaryEntry> summary =
+      heap_profiler->GetRetainedSizeSummary(1000);
+  for (size_t i = 1; i < summary.size(); ++i) {
+    CHECK_GE(summary[i - 1].retained_size, summary[i].retained_size);
+  }
+
+  const v8::HeapProfiler::RetainedSizeSummaryEntry* holder =
+      FindSummaryEntry(summary, "SummaryHolder");
+  CHECK(holder);
+  CHECK_EQ(10u, holder->count);
+  // Each holder exclusively retains its backing store.
+  CHECK_GE(holder->retained_size,
+           holder->self_size + 10 * 1000 * i::kTaggedSize);
+
+  // Nodes retained by another node are not counted twice.
+  const v8::HeapProfiler::RetainedSizeSummaryEntry* node =
+      FindSummaryEntry(summary, "SummaryNode");
+  CHECK(node);
+  CHECK_EQ(100u, node->count);
+  CHECK_GE(node->retained_size, node->self_size);
+  CHECK_LT(node->retained_size, 2 * node->self_size);
+
+  // Dead objects are left out without a GC.
+  CHECK_NULL(FindSummaryEntry(summary, "SummaryGarbage"));
+
+  CHECK_EQ(0, heap_profiler->GetSnapshotCount());
+  CHECK_EQ(1u, heap_profiler->GetRetainedSizeSummary(1).size());
+}
+
 TEST(TakeHeapSnapshotReportFinishOnce) {
   LocalContext env;
   v8::HandleScope scope(env->GetIsolate());
@@ -3979,6 +4209,82 @@ TEST(SamplingHeapProfilerLargeInterval) {
   heap_profiler->StopSamplingHeapProfiler();
 }
 
+static const v8::HeapProfiler::AllocationSiteUpdate* FindAllocationSiteUpdate(
+    const std::vector<v8::HeapProfiler::AllocationSiteUpdate>& updates,
+    const char* name) {
+  for (const auto& update : updates) {
+    if (strcmp(update.name, name) == 0) return &update;
+  }
+  return nullptr;
+}
+
+TEST(SamplingHeapProfilerAggregateBySite) {
+  v8::HandleScope scope(CcTest::isolate());
+  LocalContext env;
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+
+  // Turn off always_opt. Inlining can cause stack traces to be shorter than
+  // what we expect in this test.
+  v8::internal::FLAG_always_opt = false;
+
+  // Suppress randomness to avoid flakiness in tests.
+  v8::internal::FLAG_sampling_heap_profiler_suppress_randomness = true;
+
+  // Nothing is reported unless sampling aggregates by site.
+  heap_profiler->StartSamplingHeapProfiler(1024);
+  CompileRun(simple_sampling_heap_profiler_script);
+  CHECK(heap_profiler->GetAllocationSiteUpdates().empty());
+  heap_profiler->StopSamplingHeapProfiler();
+
+  heap_profiler->StartSamplingHeapProfiler(
+      1024, 16, v8::HeapProfiler::kSamplingAggregateBySite);
+  CompileRun(simple_sampling_heap_profiler_script);
+
+  std::vector<v8::HeapProfiler::AllocationSiteUpdate> updates =
+      heap_profiler->GetAllocationSiteUpdates();
+  const v8::HeapProfiler::AllocationSiteUpdate* bar =
+      FindAllocationSiteUpdate(updates, "bar");
+  CHECK(bar);
+  CHECK_GT(bar->allocated_count, 0u);
+  CHECK_EQ(bar->allocated_count, bar->live_count);
+  CHECK_EQ(bar->allocated_bytes, bar->live_bytes);
+  CHECK_NE(0u, bar->parent_id);
+  uint32_t bar_id = bar->node_id;
+  size_t allocated_count = bar->allocated_count;
+  size_t allocated_bytes = bar->allocated_bytes;
+
+  // Unchanged sites are not reported again.
+  updates = heap_profiler->GetAllocationSiteUpdates();
+  CHECK_NULL(FindAllocationSiteUpdate(updates, "bar"));
+
+  // The tree is still available, without individual samples.
+  {
+    std::unique_ptr<v8::AllocationProfile> profile(
+        heap_profiler->GetAllocationProfile());
+    CHECK(profile);
+    const char* names[] = {"", "foo", "bar"};
+    auto node_bar = FindAllocationProfileNode(env->GetIsolate(), profile.get(),
+                                              ArrayVector(names));
+    CHECK(node_bar);
+    CHECK_EQ(bar_id, node_bar->node_id);
+    CHECK(profile->GetSamples().empty());
+  }
+
+  // Freed objects are accounted for after mark-compact.
+  CompileRun("A = null;");
+  CcTest::CollectAllGarbage();
+  updates = heap_profiler->GetAllocationSiteUpdates();
+  bar = FindAllocationSiteUpdate(updates, "bar");
+  CHECK(bar);
+  CHECK_EQ(bar_id, bar->node_id);
+  CHECK_EQ(allocated_count, bar->allocated_count);
+  CHECK_EQ(allocated_bytes, bar->allocated_bytes);
+  CHECK_EQ(0u, bar->live_count);
+  CHECK_EQ(0u, bar->live_bytes);
+
+  heap_profiler->StopSamplingHeapProfiler();
+}
+
 TEST(HeapSnapshotPrototypeNotJSReceiver) {
   LocalContext env;
   v8::HandleScope scope(env->GetIsolate());
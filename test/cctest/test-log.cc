@@ -27,6 +27,8 @@
 //
 // Tests of logging functions from log.h
 
+#include <map>
+#include <sstream>
 #include <unordered_set>
 #include <vector>
 #include "src/api/api-inl.h"
@@ -98,6 +100,8 @@ class ScopedLoggerInitializer {
         .ToLocalChecked();
   }
 
+  const std::string& raw_log() const { return raw_log_; }
+
   void PrintLog() {
     i::StdoutStream os;
     os << raw_log_ << std::flush;
@@ -558,6 +562,173 @@ UNINITIALIZED_TEST(LogAll) {
   isolate->Dispose();
 }
 
+namespace {
+
+// Decodes a log written with --log-binary into the lines of the text format,
+// like tools/binary-log-converter.py.
+class BinaryLogDecoder {
+ public:
+  explicit BinaryLogDecoder(const std::string& log) : log_(log) {}
+
+  std::vector<std::string> Decode() {
+    CHECK_EQ(0, log_.compare(0, 4, "V8BL"));
+    pos_ = 4;
+    uint64_t version = ReadVarint();
+    CHECK_EQ(static_cast<uint64_t>(i::BinaryLogWriter::kVersion), version);
+    uint64_t event_count = ReadVarint();
+    for (uint64_t n = 0; n < event_count; ++n) names_.push_back(ReadString());
+
+    std::map<uint64_t, std::string> lines;
+    while (pos_ < log_.size()) {
+      size_t chunk_end = pos_ + ReadVarint();
+      CHECK_LE(chunk_end, log_.size());
+      while (pos_ < chunk_end) {
+        uint64_t sequence_number = ReadVarint();
+        CHECK(lines.emplace(sequence_number, ReadRecord()).second);
+      }
+      CHECK_EQ(chunk_end, pos_);
+    }
+
+    // Every record that got a sequence number made it into the file.
+    std::vector<std::string> result;
+    for (const auto& line : lines) {
+      CHECK_EQ(static_cast<uint64_t>(result.size()), line.first);
+      result.push_back(line.second);
+    }
+    return result;
+  }
+
+ private:
+  uint64_t ReadVarint() {
+    uint64_t result = 0;
+    int shift = 0;
+    uint8_t byte;
+    do {
+      CHECK_LT(pos_, log_.size());
+      byte = static_cast<uint8_t>(log_[pos_++]);
+      result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      shift += 7;
+    } while (byte & 0x80);
+    return result;
+  }
+
+  std::string ReadString() {
+    size_t length = static_cast<size_t>(ReadVarint());
+    CHECK_LE(pos_ + length, log_.size());
+    std::string result = log_.substr(pos_, length);
+    pos_ += length;
+    return result;
+  }
+
+  const std::string& EventName(uint64_t event) {
+    CHECK_LT(event, names_.size());
+    return names_[event];
+  }
+
+  static std::string Pointer(uint64_t value) {
+    std::ostringstream os;
+    os << "0x" << std::hex << value;
+    return os.str();
+  }
+
+  std::string ReadRecord() {
+    CHECK_LT(pos_, log_.size());
+    uint8_t type = static_cast<uint8_t>(log_[pos_++]);
+    std::ostringstream line;
+    switch (type) {
+      case i::BinaryLogWriter::kText:
+        return ReadString();
+      case i::BinaryLogWriter::kCodeCreation: {
+        line << EventName(i::CodeEventListener::CODE_CREATION_EVENT) << ","
+             << EventName(ReadVarint());
+        line << "," << ReadVarint();  // kind
+        line << "," << ReadVarint();  // timestamp
+        line << "," << Pointer(ReadVarint());
+        line << "," << ReadVarint();  // size
+        line << "," << ReadString();
+        return line.str();
+      }
+      case i::BinaryLogWriter::kMove: {
+        line << EventName(ReadVarint());
+        line << "," << Pointer(ReadVarint());
+        line << "," << Pointer(ReadVarint());
+        return line.str();
+      }
+      case i::BinaryLogWriter::kTick: {
+        line << EventName(i::CodeEventListener::TICK_EVENT);
+        line << "," << Pointer(ReadVarint());  // pc
+        line << "," << ReadVarint();           // timestamp
+        line << "," << ReadVarint();           // has_external_callback
+        line << "," << Pointer(ReadVarint());  // callback or tos
+        line << "," << ReadVarint();           // vm state
+        if (ReadVarint()) line << ",overflow";
+        uint64_t frames_count = ReadVarint();
+        for (uint64_t n = 0; n < frames_count; ++n) {
+          line << "," << Pointer(ReadVarint());
+        }
+        return line.str();
+      }
+    }
+    FATAL("Unknown binary log record type %d", type);
+  }
+
+  const std::string& log_;
+  size_t pos_ = 0;
+  std::vector<std::string> names_;
+};
+
+}  // namespace
+
+UNINITIALIZED_TEST(LogBinary) {
+  SETUP_FLAGS();
+  i::FLAG_log_binary = true;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+
+  {
+    ScopedLoggerInitializer logger(isolate);
+    // Runs long enough for the profiler thread to record ticks.
+    CompileRun(R"(
+        function testBinaryLogFn(a, b) {
+          return a + b;
+        }
+        const start = Date.now();
+        for (let i = 0; Date.now() - start < 100; i++) testBinaryLogFn(i, i);
+      )");
+    i::Handle<i::AbstractCode> code(
+        i::AbstractCode::cast(logger.i_isolate()->builtins()->builtin(
+            i::Builtins::kArrayPrototypePush)),
+        logger.i_isolate());
+    logger.logger()->CodeMoveEvent(*code, *code);
+    logger.StopLogging();
+
+    const std::string& log = logger.raw_log();
+    // Code-creation records are binary apart from their text columns.
+    CHECK_EQ(std::string::npos, log.find("code-creation,"));
+
+    std::vector<std::string> lines = BinaryLogDecoder(log).Decode();
+    CHECK_EQ(0, lines[0].compare(0, 11, "v8-version,"));
+    auto contains_line = [&lines](const std::string& prefix,
+                                  const std::string& term) {
+      for (const std::string& line : lines) {
+        if (line.compare(0, prefix.size(), prefix) == 0 &&
+            line.find(term) != std::string::npos) {
+          return true;
+        }
+      }
+      return false;
+    };
+    CHECK(contains_line("code-creation,", "testBinaryLogFn"));
+    std::ostringstream address;
+    address << "0x" << std::hex << code->InstructionStart();
+    CHECK(contains_line("code-move,", address.str() + "," + address.str()));
+    CHECK(contains_line("tick,", ""));
+  }
+  isolate->Dispose();
+  i::FLAG_log_binary = false;
+}
+
 #ifndef V8_TARGET_ARCH_ARM
 UNINITIALIZED_TEST(LogInterpretedFramesNativeStack) {
   SETUP_FLAGS();
@@ -1191,3 +1362,73 @@ UNINITIALIZED_TEST(BuiltinsNotLoggedAsLazyCompile) {
   }
   isolate->Dispose();
 }
+
+#if V8_OS_LINUX
+// Tests that the jitdump file written by --perf-prof holds the code load and
+// debug info records of optimized code, once the writer thread is done.
+UNINITIALIZED_TEST(PerfJitDumpRecords) {
+  if (!i::FLAG_opt || i::FLAG_lite_mode) return;
+  i::FLAG_perf_prof = true;
+  i::FLAG_perf_prof_delete_file = false;
+  i::FLAG_allow_natives_syntax = true;
+  i::FlagList::EnforceFlagImplications();
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    CompileRun(
+        "function testPerfJitFn(a, b) { return a + b; }"
+        "%PrepareFunctionForOptimization(testPerfJitFn);"
+        "testPerfJitFn(1, 2);"
+        "%OptimizeFunctionOnNextCall(testPerfJitFn);"
+        "testPerfJitFn(1, 2);");
+  }
+  // Disposing the last isolate closes the file after all records are
+  // written.
+  isolate->Dispose();
+
+  std::string path =
+      "./jit-" + std::to_string(v8::base::OS::GetCurrentProcessId()) + ".dump";
+  bool exists = false;
+  std::string dump = i::ReadFile(path.c_str(), &exists, false);
+  CHECK(exists);
+
+  // See PerfJitHeader, PerfJitBase and PerfJitCodeLoad in perf-jit.cc.
+  const uint32_t kMagic = 0x4A695444;
+  const uint32_t kLoad = 0;
+  const uint32_t kDebugInfo = 2;
+  const size_t kCodeLoadNameOffset = 56;
+  auto read_uint32 = [&dump](size_t offset) {
+    uint32_t value;
+    memcpy(&value, dump.data() + offset, sizeof(value));
+    return value;
+  };
+  CHECK_GE(dump.size(), 12u);
+  CHECK_EQ(kMagic, read_uint32(0));
+
+  bool found_load = false;
+  bool found_debug_info = false;
+  size_t offset = read_uint32(8);
+  while (offset + 8 <= dump.size()) {
+    uint32_t event = read_uint32(offset);
+    uint32_t size = read_uint32(offset + 4);
+    CHECK_GT(size, 0u);
+    CHECK_LE(offset + size, dump.size());
+    if (event == kDebugInfo) found_debug_info = true;
+    if (event == kLoad &&
+        strstr(dump.data() + offset + kCodeLoadNameOffset, "testPerfJitFn")) {
+      found_load = true;
+    }
+    offset += size;
+  }
+  CHECK_EQ(dump.size(), offset);
+  CHECK(found_load);
+  CHECK(found_debug_info);
+
+  v8::base::OS::Remove(path.c_str());
+}
+#endif  // V8_OS_LINUX
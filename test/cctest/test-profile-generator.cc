@@ -217,6 +217,32 @@ TEST(ProfileTreeAddPathFromEndWithLineNumbers) {
   CHECK(c_node);
 }
 
+TEST(ProfileTreeAddPathFromEndWithCounters) {
+  CcTest::InitializeVM();
+  CodeEntry a(i::CodeEventListener::FUNCTION_TAG, "a");
+  CodeEntry b(i::CodeEventListener::FUNCTION_TAG, "b");
+  ProfileTree tree(CcTest::i_isolate());
+
+  ProfileStackTrace path = {{&b, 0}, {&a, 0}};
+  uint64_t counters[TickSample::kCounterCount] = {1000, 10, 1};
+  tree.AddPathFromEnd(path, v8::CpuProfileNode::kNoLineNumberInfo, true,
+                      v8::CpuProfilingMode::kLeafNodeLineNumbers, counters);
+  tree.AddPathFromEnd(path, v8::CpuProfileNode::kNoLineNumberInfo, true,
+                      v8::CpuProfilingMode::kLeafNodeLineNumbers, counters);
+  // Samples excluded from the stats do not count events either.
+  tree.AddPathFromEnd(path, v8::CpuProfileNode::kNoLineNumberInfo, false,
+                      v8::CpuProfilingMode::kLeafNodeLineNumbers, counters);
+
+  ProfileNode* a_node = tree.root()->FindChild(&a);
+  CHECK(a_node);
+  CHECK_EQ(0u, a_node->counter(v8::kCpuCycles));
+  ProfileNode* b_node = a_node->FindChild(&b);
+  CHECK(b_node);
+  CHECK_EQ(2000u, b_node->counter(v8::kCpuCycles));
+  CHECK_EQ(20u, b_node->counter(v8::kCpuCacheMisses));
+  CHECK_EQ(2u, b_node->counter(v8::kCpuBranchMisses));
+}
+
 TEST(ProfileTreeCalculateTotalTicks) {
   CcTest::InitializeVM();
   ProfileTree empty_tree(CcTest::i_isolate());
@@ -431,6 +457,47 @@ TEST(SymbolizeTickSample) {
   CHECK_EQ(entry1, stack_trace[2].code_entry);
 }
 
+TEST(SymbolizeTickSampleAfterCodeMove) {
+  TestSetup test_setup;
+  CodeMap code_map;
+  Symbolizer symbolizer(&code_map);
+  CodeEntry* entry1 = new CodeEntry(i::Logger::FUNCTION_TAG, "aaa");
+  CodeEntry* entry2 = new CodeEntry(i::Logger::FUNCTION_TAG, "bbb");
+  symbolizer.code_map()->AddCode(ToAddress(0x1500), entry1, 0x200);
+  symbolizer.code_map()->AddCode(ToAddress(0x1700), entry2, 0x100);
+
+  TickSample sample;
+  sample.pc = ToPointer(0x1510);
+  sample.tos = ToPointer(0x1500);
+  sample.stack[0] = ToPointer(0x1710);
+  sample.frames_count = 1;
+  // Symbolize twice so that the second lookup is served from the cache.
+  for (int i = 0; i < 2; i++) {
+    ProfileStackTrace stack_trace =
+        symbolizer.SymbolizeTickSample(sample).stack_trace;
+    CHECK_EQ(2, stack_trace.size());
+    CHECK_EQ(entry1, stack_trace[0].code_entry);
+    CHECK_EQ(entry2, stack_trace[1].code_entry);
+  }
+  size_t misses = symbolizer.cache_misses();
+  CHECK_LT(0u, misses);
+  CHECK_EQ(misses, symbolizer.cache_hits());
+
+  // Cached lookups must not survive changes to the code map.
+  symbolizer.code_map()->MoveCode(ToAddress(0x1500), ToAddress(0x2500));
+  ProfileStackTrace stack_trace =
+      symbolizer.SymbolizeTickSample(sample).stack_trace;
+  CHECK_EQ(1, stack_trace.size());
+  CHECK_EQ(entry2, stack_trace[0].code_entry);
+
+  sample.pc = ToPointer(0x2510);
+  sample.tos = ToPointer(0x2500);
+  stack_trace = symbolizer.SymbolizeTickSample(sample).stack_trace;
+  CHECK_EQ(2, stack_trace.size());
+  CHECK_EQ(entry1, stack_trace[0].code_entry);
+  CHECK_EQ(entry2, stack_trace[1].code_entry);
+}
+
 static void CheckNodeIds(const ProfileNode* node, unsigned* expectedId) {
   CHECK_EQ((*expectedId)++, node->id());
   for (const ProfileNode* child : *node->children()) {
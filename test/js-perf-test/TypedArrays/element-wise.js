@@ -0,0 +1,63 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+new BenchmarkSuite('ElementWise', [1000], [
+  new Benchmark('ElementWise-AddFloat64', false, false, 0,
+                AddFloat64, ElementWiseSetup, ElementWiseTearDown),
+  new Benchmark('ElementWise-MulAddFloat64', false, false, 0,
+                MulAddFloat64, ElementWiseSetup, ElementWiseTearDown),
+  new Benchmark('ElementWise-AddInt32', false, false, 0,
+                AddInt32, ElementWiseSetup, ElementWiseTearDown),
+  new Benchmark('ElementWise-AndInt32', false, false, 0,
+                AndInt32, ElementWiseSetup, ElementWiseTearDown),
+]);
+
+const kLength = 10000;
+var float64Arrays;
+var int32Arrays;
+var result;
+
+// The arrays are locals, so they are invariant in the loops.
+function AddFloat64() {
+  const [a, b, c] = float64Arrays;
+  for (let i = 0; i < c.length; ++i) c[i] = a[i] + b[i];
+  result = c[kLength - 1];
+}
+
+function MulAddFloat64() {
+  const [a, b, c] = float64Arrays;
+  for (let i = 0; i < c.length; ++i) c[i] = a[i] * 0.5 + b[i];
+  result = c[kLength - 1];
+}
+
+function AddInt32() {
+  const [a, b, c] = int32Arrays;
+  for (let i = 0; i < c.length; ++i) c[i] = a[i] + b[i];
+  result = c[kLength - 1];
+}
+
+function AndInt32() {
+  const [a, b, c] = int32Arrays;
+  for (let i = 0; i < c.length; ++i) c[i] = a[i] & b[i];
+  result = c[kLength - 1];
+}
+
+function ElementWiseSetup() {
+  float64Arrays = [0, 1, 2].map(() => new Float64Array(kLength));
+  int32Arrays = [0, 1, 2].map(() => new Int32Array(kLength));
+  for (let i = 0; i < kLength; ++i) {
+    float64Arrays[0][i] = i;
+    float64Arrays[1][i] = i / 3;
+    int32Arrays[0][i] = i * 31;
+    int32Arrays[1][i] = i ^ 0x5555;
+  }
+}
+
+function ElementWiseTearDown() {
+  if (typeof result !== 'number' || result !== result) {
+    throw new TypeError('Unexpected result: ' + result);
+  }
+  float64Arrays = void 0;
+  int32Arrays = void 0;
+}
@@ -0,0 +1,57 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+new BenchmarkSuite('Loops', [1000], [
+  new Benchmark('Loops-SumFloat64', false, false, 0,
+                SumFloat64, LoopsSetup, LoopsTearDown),
+  new Benchmark('Loops-ScaleFloat64', false, false, 0,
+                ScaleFloat64, LoopsSetup, LoopsTearDown),
+  new Benchmark('Loops-XorInt32', false, false, 0,
+                XorInt32, LoopsSetup, LoopsTearDown),
+]);
+
+const kLength = 10000;
+var float64Array;
+var int32Array;
+var result;
+
+function SumFloat64() {
+  let sum = 0;
+  for (let i = 0; i < float64Array.length; ++i) {
+    sum += float64Array[i];
+  }
+  result = sum;
+}
+
+function ScaleFloat64() {
+  for (let i = 0; i < float64Array.length; ++i) {
+    float64Array[i] = float64Array[i] * 0.5 + 1;
+  }
+  result = float64Array[kLength - 1];
+}
+
+function XorInt32() {
+  let hash = 0;
+  for (let i = 0; i < int32Array.length; ++i) {
+    hash = (hash ^ int32Array[i]) | 0;
+  }
+  result = hash;
+}
+
+function LoopsSetup() {
+  float64Array = new Float64Array(kLength);
+  int32Array = new Int32Array(kLength);
+  for (let i = 0; i < kLength; ++i) {
+    float64Array[i] = i;
+    int32Array[i] = i * 31;
+  }
+}
+
+function LoopsTearDown() {
+  if (typeof result !== 'number' || result !== result) {
+    throw new TypeError('Unexpected result: ' + result);
+  }
+  float64Array = void 0;
+  int32Array = void 0;
+}
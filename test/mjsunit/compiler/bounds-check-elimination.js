@@ -0,0 +1,77 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-bounds-check-elimination
+
+(function TestArrayLoop() {
+  function sum(a) {
+    let s = 0;
+    for (let i = 0; i < a.length; ++i) s += a[i];
+    return s;
+  }
+  %PrepareFunctionForOptimization(sum);
+  assertEquals(6, sum([1, 2, 3]));
+  assertEquals(10, sum([1, 2, 3, 4]));
+  %OptimizeFunctionOnNextCall(sum);
+  assertEquals(10, sum([1, 2, 3, 4]));
+  assertEquals(0, sum([]));
+  assertOptimized(sum);
+})();
+
+(function TestTypedArrayLoop() {
+  function sum(a) {
+    let s = 0;
+    for (let i = 0; i < a.length; ++i) s += a[i];
+    return s;
+  }
+  %PrepareFunctionForOptimization(sum);
+  assertEquals(6, sum(new Int32Array([1, 2, 3])));
+  %OptimizeFunctionOnNextCall(sum);
+  assertEquals(10, sum(new Int32Array([1, 2, 3, 4])));
+  assertEquals(0, sum(new Int32Array(0)));
+  assertOptimized(sum);
+})();
+
+(function TestReversedComparison() {
+  function sum(a) {
+    let s = 0;
+    for (let i = 0; a.length > i; ++i) s += a[i];
+    return s;
+  }
+  %PrepareFunctionForOptimization(sum);
+  assertEquals(6, sum([1, 2, 3]));
+  %OptimizeFunctionOnNextCall(sum);
+  assertEquals(10, sum([1, 2, 3, 4]));
+})();
+
+(function TestShrinkingArray() {
+  // The length is reloaded after every write, so the checks of the loads
+  // following the write remain.
+  function f(a) {
+    let s = 0;
+    for (let i = 0; i < a.length; ++i) {
+      s += a[i];
+      a.pop();
+      s += a[i] === undefined ? 100 : a[i];
+    }
+    return s;
+  }
+  %PrepareFunctionForOptimization(f);
+  assertEquals(104, f([1, 2, 3]));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(104, f([1, 2, 3]));
+  assertEquals(6, f([1, 2, 3, 4]));
+})();
+
+(function TestOutOfBoundsAfterLoop() {
+  function f(a) {
+    let i = 0;
+    for (; i < a.length; ++i) {}
+    return a[i];
+  }
+  %PrepareFunctionForOptimization(f);
+  assertEquals(undefined, f([1, 2]));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(undefined, f([1, 2, 3]));
+})();
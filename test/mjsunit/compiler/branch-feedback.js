@@ -0,0 +1,68 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --branch-feedback --opt --no-always-opt
+
+(function TestIfElse() {
+  function f(x) {
+    if (x < 0) {
+      return 'negative';
+    } else {
+      return 'positive';
+    }
+  }
+  // Branch counters are skipped while the function has no feedback vector.
+  assertEquals('negative', f(-1));
+  %PrepareFunctionForOptimization(f);
+  for (let i = 0; i < 1000; ++i) assertEquals('positive', f(i));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals('positive', f(1));
+  assertOptimized(f);
+  // Taking the cold branch does not deoptimize.
+  assertEquals('negative', f(-1));
+  assertOptimized(f);
+})();
+
+(function TestIfWithoutElse() {
+  function f(a, b) {
+    let result = 0;
+    if (a && b) result = 1;
+    if (!a) result = 2;
+    return result;
+  }
+  %PrepareFunctionForOptimization(f);
+  for (let i = 0; i < 1000; ++i) assertEquals(1, f(true, true));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(1, f(true, true));
+  assertOptimized(f);
+  assertEquals(0, f(true, false));
+  assertEquals(2, f(false, true));
+  assertOptimized(f);
+})();
+
+(function TestConditional() {
+  function f(x) {
+    return x === undefined ? 0 : x + 1;
+  }
+  %PrepareFunctionForOptimization(f);
+  for (let i = 0; i < 1000; ++i) assertEquals(i + 1, f(i));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(2, f(1));
+  assertOptimized(f);
+  assertEquals(0, f(undefined));
+  assertOptimized(f);
+})();
+
+(function TestBalancedBranches() {
+  function f(x) {
+    if (x & 1) return x - 1;
+    return x;
+  }
+  %PrepareFunctionForOptimization(f);
+  for (let i = 0; i < 1000; ++i) assertEquals(i & ~1, f(i));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(2, f(3));
+  assertEquals(4, f(4));
+  assertOptimized(f);
+})();
@@ -0,0 +1,81 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --opt --no-always-opt
+
+// The maps of iterators that are created in the optimized code are known, so
+// the iteration is inlined even if the feedback of the shared helper below
+// is megamorphic.
+function sum(iterable) {
+  let result = 0;
+  for (const x of iterable) result += x;
+  return result;
+}
+
+%PrepareFunctionForOptimization(sum);
+assertEquals(6, sum([1, 2, 3]));
+assertEquals(6, sum(new Set([1, 2, 3])));
+assertEquals(6, sum(new Map([[1, 'a'], [2, 'b'], [3, 'c']]).keys()));
+assertEquals(6, sum(new Map([['a', 1], ['b', 2], ['c', 3]]).values()));
+assertEquals(6, sum(new Int8Array([1, 2, 3])));
+assertEquals('0123', sum('123'));
+
+(function TestSetValues() {
+  function foo(set) {
+    return sum(set);
+  }
+  %PrepareFunctionForOptimization(foo);
+  const set = new Set([1, 2, 3, 4]);
+  assertEquals(10, foo(set));
+  %OptimizeFunctionOnNextCall(foo);
+  assertEquals(10, foo(set));
+  set.delete(2);
+  assertEquals(8, foo(set));
+  assertEquals(0, foo(new Set()));
+})();
+
+(function TestMapKeys() {
+  function foo(map) {
+    return sum(map.keys());
+  }
+  %PrepareFunctionForOptimization(foo);
+  const map = new Map([[1, 'a'], [2, 'b']]);
+  assertEquals(3, foo(map));
+  %OptimizeFunctionOnNextCall(foo);
+  assertEquals(3, foo(map));
+  map.set(3, 'c');
+  assertEquals(6, foo(map));
+})();
+
+(function TestMapEntries() {
+  function foo(map) {
+    let keys = 0;
+    let values = '';
+    for (const [key, value] of map) {
+      keys += key;
+      values += value;
+    }
+    return values + keys;
+  }
+  %PrepareFunctionForOptimization(foo);
+  const map = new Map([[1, 'a'], [2, 'b']]);
+  assertEquals('ab3', foo(map));
+  %OptimizeFunctionOnNextCall(foo);
+  assertEquals('ab3', foo(map));
+})();
+
+(function TestMutationDuringIteration() {
+  function foo(set) {
+    let result = 0;
+    for (const x of set) {
+      if (x < 3) set.add(x + 10);
+      result += x;
+    }
+    return result;
+  }
+  %PrepareFunctionForOptimization(foo);
+  assertEquals(1 + 2 + 11 + 12, foo(new Set([1, 2])));
+  %OptimizeFunctionOnNextCall(foo);
+  assertEquals(1 + 2 + 11 + 12, foo(new Set([1, 2])));
+})();
@@ -0,0 +1,69 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --concurrent-inlining
+// Flags: --opt --noalways-opt --noturboprop
+
+// Scope infos are read directly from the heap by the broker, including the
+// outer scope infos walked when checking context extensions.
+
+(function TestBlockAndFunctionContexts() {
+  function inner(x) {
+    let a = x;
+    {
+      let b = x + 1;
+      const f = () => a + b;
+      return f();
+    }
+  }
+  function outer(x) {
+    return inner(x) + inner(x + 1);
+  }
+  %PrepareFunctionForOptimization(inner);
+  %PrepareFunctionForOptimization(outer);
+  assertEquals(8, outer(1));
+  %OptimizeFunctionOnNextCall(outer);
+  assertEquals(8, outer(1));
+  assertOptimized(outer);
+})();
+
+(function TestCatchContext() {
+  function inner(x) {
+    try {
+      throw x;
+    } catch (e) {
+      return () => e;
+    }
+  }
+  function outer(x) {
+    return inner(x)();
+  }
+  %PrepareFunctionForOptimization(inner);
+  %PrepareFunctionForOptimization(outer);
+  assertEquals(1, outer(1));
+  %OptimizeFunctionOnNextCall(outer);
+  assertEquals(2, outer(2));
+  assertOptimized(outer);
+})();
+
+(function TestLookupThroughOuterScopes() {
+  var global_value = 42;
+  function make() {
+    return function(s) {
+      eval(s);
+      return function() {
+        return global_value;
+      };
+    };
+  }
+  const create = make();
+  function outer() {
+    return create('')();
+  }
+  %PrepareFunctionForOptimization(outer);
+  assertEquals(42, outer());
+  %OptimizeFunctionOnNextCall(outer);
+  assertEquals(42, outer());
+  assertEquals(7, create('var global_value = 7')());
+})();
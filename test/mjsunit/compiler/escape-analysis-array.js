@@ -32,3 +32,38 @@
   assertEquals("first", f(0));
   assertEquals("second", f(1));
 })();
+
+// Test variable index access to array with 4 elements.
+(function testFourElementArrayVariableIndex() {
+  function f(i) {
+    const a = new Array("first", "second", "third", "fourth");
+    return a[i];
+  }
+
+  %PrepareFunctionForOptimization(f);
+  assertEquals("first", f(0));
+  assertEquals("fourth", f(3));
+  %OptimizeFunctionOnNextCall(f);
+  for (let i = 0; i < 4; ++i) {
+    assertEquals(["first", "second", "third", "fourth"][i], f(i));
+  }
+})();
+
+// Test variable index access to a temporary array in a loop.
+(function testTemporaryArrayInLoop() {
+  function f(x, y, z) {
+    let sum = 0;
+    for (let i = 0; i < 3; ++i) {
+      const a = [x, y, z];
+      sum += a[i];
+    }
+    return sum;
+  }
+
+  %PrepareFunctionForOptimization(f);
+  assertEquals(6, f(1, 2, 3));
+  assertEquals(6, f(1, 2, 3));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(6, f(1, 2, 3));
+  assertEquals(60, f(10, 20, 30));
+})();
@@ -0,0 +1,82 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-loop-check-hoisting
+
+(function TestSumOfArray() {
+  function sum(a) {
+    let s = 0;
+    for (let i = 0; i < a.length; ++i) s += a[i];
+    return s;
+  }
+  %PrepareFunctionForOptimization(sum);
+  assertEquals(6, sum([1, 2, 3]));
+  assertEquals(10, sum([1, 2, 3, 4]));
+  %OptimizeFunctionOnNextCall(sum);
+  assertEquals(10, sum([1, 2, 3, 4]));
+  assertEquals(0, sum([]));
+  assertOptimized(sum);
+  // A hoisted map check deoptimizes to the state before the loop.
+  assertEquals(4.5, sum([1.5, 3]));
+})();
+
+(function TestInvariantIndex() {
+  function first(a, n) {
+    let s = 0;
+    for (let i = 0; i < n; ++i) s += a[0];
+    return s;
+  }
+  %PrepareFunctionForOptimization(first);
+  assertEquals(3, first([1], 3));
+  %OptimizeFunctionOnNextCall(first);
+  assertEquals(6, first([2], 3));
+  assertEquals(0, first([2], 0));
+  // The checks on {a} are behind the exit test, so calls that do not enter
+  // the loop must not fail them.
+  assertEquals(0, first([], 0));
+  assertEquals(0, first([1.5], 0));
+  assertOptimized(first);
+  assertEquals(NaN, first([], 1));
+})();
+
+(function TestStoresDoNotChangeLength() {
+  function scale(a, k) {
+    for (let i = 0; i < a.length; ++i) a[i] = a[i] * k;
+    return a;
+  }
+  %PrepareFunctionForOptimization(scale);
+  assertEquals([2, 4], scale([1, 2], 2));
+  %OptimizeFunctionOnNextCall(scale);
+  assertEquals([3, 6, 9], scale([1, 2, 3], 3));
+})();
+
+(function TestTypedArray() {
+  function sum(a) {
+    let s = 0;
+    for (let i = 0; i < a.length; ++i) s += a[i];
+    return s;
+  }
+  %PrepareFunctionForOptimization(sum);
+  assertEquals(6, sum(new Float64Array([1, 2, 3])));
+  %OptimizeFunctionOnNextCall(sum);
+  assertEquals(10, sum(new Float64Array([1, 2, 3, 4])));
+  assertEquals(3, sum(new Float64Array([3])));
+})();
+
+(function TestCallInLoop() {
+  // Calls might change the array, so the checks must stay in the loop.
+  function sum(a, f) {
+    let s = 0;
+    for (let i = 0; i < a.length; ++i) {
+      s += a[i];
+      f(a);
+    }
+    return s;
+  }
+  %PrepareFunctionForOptimization(sum);
+  assertEquals(3, sum([1, 2], () => {}));
+  %OptimizeFunctionOnNextCall(sum);
+  assertEquals(3, sum([1, 2], () => {}));
+  assertEquals(1, sum([1, 2], a => { a.length = 1; }));
+})();
@@ -0,0 +1,42 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-loop-unrolling
+
+(function TestValueLeavingLoop() {
+  // The value of {s} leaves the unrolled loop through each iteration's exit.
+  function sum(n) {
+    let s = 0;
+    for (let i = 0; i < n; ++i) s += i;
+    return s;
+  }
+  %PrepareFunctionForOptimization(sum);
+  assertEquals(10, sum(5));
+  assertEquals(45, sum(10));
+  %OptimizeFunctionOnNextCall(sum);
+  for (let n = 1; n < 10; ++n) assertEquals(n * (n - 1) / 2, sum(n));
+  assertEquals(0, sum(0));
+  assertOptimized(sum);
+})();
+
+(function TestDoubleLeavingLoop() {
+  function f(a) {
+    let x = 0.5;
+    let i = 0;
+    while (i < a.length) {
+      x = x * a[i];
+      if (x > 100) break;
+      ++i;
+    }
+    return x + i;
+  }
+  %PrepareFunctionForOptimization(f);
+  assertEquals(5, f([2, 3]));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(0.5, f([]));
+  assertEquals(2, f([2]));
+  assertEquals(5, f([2, 3]));
+  assertEquals(600 + 4, f([2, 4, 5, 5, 6]));
+  assertOptimized(f);
+})();
@@ -0,0 +1,101 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-loop-vectorization
+
+(function TestFloat64Add() {
+  function add(a, b, c) {
+    for (let i = 0; i < c.length; ++i) c[i] = a[i] + b[i];
+  }
+  function test(n) {
+    const a = new Float64Array(n);
+    const b = new Float64Array(n);
+    const c = new Float64Array(n);
+    for (let i = 0; i < n; ++i) {
+      a[i] = i + 0.5;
+      b[i] = 2 * i;
+    }
+    add(a, b, c);
+    for (let i = 0; i < n; ++i) assertEquals(3 * i + 0.5, c[i]);
+  }
+  %PrepareFunctionForOptimization(add);
+  test(7);
+  %OptimizeFunctionOnNextCall(add);
+  test(0);
+  test(1);
+  test(8);
+  test(11);
+  assertOptimized(add);
+})();
+
+(function TestInt32Operations() {
+  function f(a, b, c, k) {
+    for (let i = 0; i < c.length; ++i) c[i] = ((a[i] * k) ^ b[i]) >> 1;
+  }
+  function test(n) {
+    const a = new Int32Array(n);
+    const b = new Int32Array(n);
+    const c = new Int32Array(n);
+    for (let i = 0; i < n; ++i) {
+      a[i] = i - 3;
+      b[i] = 0x7fffffff - i;
+    }
+    f(a, b, c, 0x10001);
+    for (let i = 0; i < n; ++i) {
+      assertEquals((Math.imul(i - 3, 0x10001) ^ (0x7fffffff - i)) >> 1, c[i]);
+    }
+  }
+  %PrepareFunctionForOptimization(f);
+  test(9);
+  %OptimizeFunctionOnNextCall(f);
+  test(3);
+  test(4);
+  test(13);
+  assertOptimized(f);
+})();
+
+(function TestInPlace() {
+  function scale(a, k) {
+    for (let i = 0; i < a.length; ++i) a[i] = a[i] * k;
+  }
+  %PrepareFunctionForOptimization(scale);
+  scale(new Float64Array(3), 2);
+  %OptimizeFunctionOnNextCall(scale);
+  const a = new Float64Array([1, 2, 3, 4, 5]);
+  scale(a, 3);
+  assertEquals([3, 6, 9, 12, 15], Array.from(a));
+  assertOptimized(scale);
+})();
+
+(function TestOverlappingArrays() {
+  // Each element depends on the one stored in the previous iteration.
+  function copy(a, b) {
+    for (let i = 0; i < b.length; ++i) b[i] = a[i];
+  }
+  %PrepareFunctionForOptimization(copy);
+  copy(new Uint32Array(4), new Uint32Array(4));
+  %OptimizeFunctionOnNextCall(copy);
+  const buffer = new ArrayBuffer(10 * 4);
+  const a = new Uint32Array(buffer, 0, 9);
+  const b = new Uint32Array(buffer, 4, 9);
+  a[0] = 42;
+  copy(a, b);
+  assertEquals(new Array(10).fill(42), Array.from(new Uint32Array(buffer)));
+  assertOptimized(copy);
+})();
+
+(function TestShorterSource() {
+  // The loads are out of bounds in the last vector, which deoptimizes.
+  function add(a, b, c) {
+    for (let i = 0; i < c.length; ++i) c[i] = a[i] + b[i];
+  }
+  %PrepareFunctionForOptimization(add);
+  add(new Float64Array(4), new Float64Array(4), new Float64Array(4));
+  %OptimizeFunctionOnNextCall(add);
+  const a = new Float64Array([1, 2, 3, 4]);
+  const b = new Float64Array([1, 1, 1]);
+  const c = new Float64Array(4);
+  add(a, b, c);
+  assertEquals([2, 3, 4, NaN], Array.from(c));
+})();
@@ -0,0 +1,34 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --perf-prof --perf-prof-delete-file --perf-prof-unwinding-info
+// Flags: --interpreted-frames-native-stack --allow-natives-syntax
+// Flags: --liftoff --no-wasm-tier-up
+
+load('test/mjsunit/wasm/wasm-module-builder.js');
+
+// Debug info of optimized code with inlined functions, logged again after a
+// deopt and recompile.
+function inner(x) {
+  return x + 1;
+}
+function outer(x) {
+  return inner(x) + 1;
+}
+%PrepareFunctionForOptimization(outer);
+outer(1);
+outer(2);
+%OptimizeFunctionOnNextCall(outer);
+assertEquals(4, outer(2));
+assertEquals("a11", outer("a"));
+%PrepareFunctionForOptimization(outer);
+%OptimizeFunctionOnNextCall(outer);
+assertEquals("b11", outer("b"));
+
+// Liftoff code.
+const builder = new WasmModuleBuilder();
+builder.addFunction('add', kSig_i_ii)
+    .addBody([kExprLocalGet, 0, kExprLocalGet, 1, kExprI32Add])
+    .exportFunc();
+assertEquals(3, builder.instantiate().exports.add(1, 2));
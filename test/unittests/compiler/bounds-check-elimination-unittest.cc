@@ -0,0 +1,158 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/bounds-check-elimination.h"
+#include "src/compiler/access-builder.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+#include "test/unittests/compiler/graph-unittest.h"
+#include "test/unittests/compiler/node-test-utils.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class BoundsCheckEliminationTest : public GraphTest {
+ public:
+  BoundsCheckEliminationTest() : GraphTest(2), simplified_(zone()) {}
+  ~BoundsCheckEliminationTest() override = default;
+
+ protected:
+  // The nodes of the loop
+  //
+  //   for (i = 0; i < bound; ++i) CheckBounds(index, length);
+  //
+  // where the check is placed in the loop body or at the loop exit.
+  struct Loop {
+    Node* loop;
+    Node* phi;
+    Node* if_true;
+    Node* if_false;
+    Node* check;
+  };
+
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+  Node* Typed(Node* node, Type type) {
+    NodeProperties::SetType(node, type);
+    return node;
+  }
+
+  Node* NewLength() {
+    return Typed(graph()->NewNode(simplified()->LoadField(
+                                      AccessBuilder::ForJSArrayLength(
+                                          PACKED_ELEMENTS)),
+                                  Parameter(0), start(), start()),
+                 Type::Unsigned32());
+  }
+
+  Type IndexType() { return Type::Range(0, kMaxUInt32 - 1, zone()); }
+
+  // Builds the loop, where the {length} of the check defaults to {bound}.
+  Loop NewLoop(Node* bound, Node* length = nullptr) {
+    return NewLoop(bound, length, IndexType(), false);
+  }
+
+  Loop NewLoop(Node* bound, Node* length, Type index_type,
+               bool check_on_exit) {
+    if (length == nullptr) length = bound;
+    Loop l;
+    Node* zero = Typed(NumberConstant(0), Type::Range(0, 0, zone()));
+    Node* one = Typed(NumberConstant(1), Type::Range(1, 1, zone()));
+    l.loop = graph()->NewNode(common()->Loop(2), start(), start());
+    Node* effect_phi =
+        graph()->NewNode(common()->EffectPhi(2), start(), start(), l.loop);
+    l.phi = Typed(
+        graph()->NewNode(common()->Phi(MachineRepresentation::kTagged, 2),
+                         zero, zero, l.loop),
+        index_type);
+    Node* cmp = graph()->NewNode(
+        simplified()->SpeculativeNumberLessThan(
+            NumberOperationHint::kSignedSmall),
+        l.phi, bound, effect_phi, l.loop);
+    Node* branch = graph()->NewNode(common()->Branch(), cmp, l.loop);
+    l.if_true = graph()->NewNode(common()->IfTrue(), branch);
+    l.if_false = graph()->NewNode(common()->IfFalse(), branch);
+    l.check = Typed(
+        graph()->NewNode(simplified()->CheckBounds(FeedbackSource()), l.phi,
+                         length, cmp, check_on_exit ? l.if_false : l.if_true),
+        index_type);
+    Node* add = graph()->NewNode(simplified()->SpeculativeSafeIntegerAdd(
+                                     NumberOperationHint::kSignedSmall),
+                                 l.phi, one, check_on_exit ? cmp : l.check,
+                                 l.if_true);
+    l.phi->ReplaceInput(1, add);
+    effect_phi->ReplaceInput(1, add);
+    l.loop->ReplaceInput(1, l.if_true);
+
+    Node* value = check_on_exit ? l.check : l.phi;
+    Node* effect = check_on_exit ? l.check : cmp;
+    Node* ret = graph()->NewNode(common()->Return(), zero, value, effect,
+                                 l.if_false);
+    graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+    return l;
+  }
+
+  size_t Eliminate() {
+    return BoundsCheckElimination(graph(), common(), zone()).Run();
+  }
+
+ private:
+  SimplifiedOperatorBuilder simplified_;
+};
+
+TEST_F(BoundsCheckEliminationTest, EliminatesCheckAgainstLoopBound) {
+  Loop l = NewLoop(NewLength());
+  Type type = NodeProperties::GetType(l.check);
+
+  EXPECT_EQ(1u, Eliminate());
+
+  EXPECT_EQ(IrOpcode::kTypeGuard, l.check->opcode());
+  EXPECT_EQ(l.phi, NodeProperties::GetValueInput(l.check, 0));
+  EXPECT_EQ(l.if_true, NodeProperties::GetControlInput(l.check));
+  EXPECT_TRUE(TypeGuardTypeOf(l.check->op()).Equals(type));
+}
+
+TEST_F(BoundsCheckEliminationTest, EliminatesCheckAgainstDetachableLength) {
+  // The length of a typed array is zero if its buffer was detached.
+  Node* length = NewLength();
+  Node* zero = Typed(NumberConstant(0), Type::Range(0, 0, zone()));
+  Node* bound = Typed(
+      graph()->NewNode(common()->Select(MachineRepresentation::kTagged),
+                       Parameter(1), length, zero),
+      Type::Unsigned32());
+  Loop l = NewLoop(bound, length);
+
+  EXPECT_EQ(1u, Eliminate());
+
+  EXPECT_EQ(IrOpcode::kTypeGuard, l.check->opcode());
+}
+
+TEST_F(BoundsCheckEliminationTest, KeepsCheckAgainstOtherLength) {
+  Loop l = NewLoop(NewLength(), NewLength());
+
+  EXPECT_EQ(0u, Eliminate());
+
+  EXPECT_EQ(IrOpcode::kCheckBounds, l.check->opcode());
+}
+
+TEST_F(BoundsCheckEliminationTest, KeepsCheckOfPossiblyNegativeIndex) {
+  Loop l = NewLoop(NewLength(), nullptr, Type::Signed32(), false);
+
+  EXPECT_EQ(0u, Eliminate());
+
+  EXPECT_EQ(IrOpcode::kCheckBounds, l.check->opcode());
+}
+
+TEST_F(BoundsCheckEliminationTest, KeepsCheckAtLoopExit) {
+  Loop l = NewLoop(NewLength(), nullptr, IndexType(), true);
+
+  EXPECT_EQ(0u, Eliminate());
+
+  EXPECT_EQ(IrOpcode::kCheckBounds, l.check->opcode());
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,186 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-check-hoisting.h"
+#include "src/compiler/access-builder.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+#include "test/unittests/compiler/graph-unittest.h"
+#include "test/unittests/compiler/node-test-utils.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class LoopCheckHoistingTest : public GraphTest {
+ public:
+  LoopCheckHoistingTest() : GraphTest(2), simplified_(zone()) {}
+  ~LoopCheckHoistingTest() override = default;
+
+ protected:
+  // The nodes of a loop over the elements of an array:
+  //
+  //   while (p1) { p0.length; p0[index]; }
+  struct ArrayLoop {
+    Node* array;
+    Node* checkpoint;
+    Node* loop;
+    Node* effect_phi;
+    Node* check_maps;
+    Node* length;
+    Node* if_true;
+    Node* if_false;
+    Node* elements;
+    Node* bounds;
+    Node* load;
+  };
+
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+  size_t HoistChecks() {
+    LoopTree* loop_tree =
+        LoopFinder::BuildLoopTree(graph(), tick_counter(), zone());
+    return LoopCheckHoisting(loop_tree, zone()).HoistChecksOfTree();
+  }
+
+  // Builds a loop over {array} that exits on Parameter(1). The bounds check
+  // is either part of the exit test or behind it, next to the element load.
+  ArrayLoop NewArrayLoop(Node* index = nullptr, bool check_maps = true,
+                         bool bounds_before_exit = false) {
+    ArrayLoop l;
+    l.array = Parameter(0);
+    l.checkpoint = graph()->NewNode(common()->Checkpoint(), EmptyFrameState(),
+                                    start(), start());
+    l.loop = graph()->NewNode(common()->Loop(2), start(), start());
+    l.effect_phi = graph()->NewNode(common()->EffectPhi(2), l.checkpoint,
+                                    l.checkpoint, l.loop);
+    Node* effect = l.effect_phi;
+    l.check_maps = nullptr;
+    if (check_maps) {
+      effect = l.check_maps = graph()->NewNode(
+          simplified()->CheckMaps(CheckMapsFlag::kNone,
+                                  ZoneHandleSet<Map>(handle(
+                                      native_context()
+                                          ->js_array_packed_elements_map(),
+                                      isolate()))),
+          l.array, effect, l.loop);
+    }
+    l.length = graph()->NewNode(simplified()->LoadField(
+                                    AccessBuilder::ForJSArrayLength(
+                                        PACKED_ELEMENTS)),
+                                l.array, effect, l.loop);
+    if (index == nullptr) index = Int32Constant(0);
+    if (index->opcode() == IrOpcode::kPhi) index->ReplaceInput(2, l.loop);
+    if (bounds_before_exit) {
+      l.bounds = graph()->NewNode(simplified()->CheckBounds(FeedbackSource()),
+                                  index, l.length, l.length, l.loop);
+    }
+    Node* branch =
+        graph()->NewNode(common()->Branch(), Parameter(1), l.loop);
+    l.if_true = graph()->NewNode(common()->IfTrue(), branch);
+    l.if_false = graph()->NewNode(common()->IfFalse(), branch);
+    l.elements = graph()->NewNode(
+        simplified()->LoadField(AccessBuilder::ForJSObjectElements()),
+        l.array, bounds_before_exit ? l.bounds : l.length, l.if_true);
+    Node* load_effect = l.elements;
+    if (!bounds_before_exit) {
+      load_effect = l.bounds =
+          graph()->NewNode(simplified()->CheckBounds(FeedbackSource()),
+                           index, l.length, l.elements, l.if_true);
+    }
+    l.load = graph()->NewNode(
+        simplified()->LoadElement(AccessBuilder::ForFixedArrayElement()),
+        l.elements, l.bounds, load_effect, l.if_true);
+    l.effect_phi->ReplaceInput(1, l.load);
+    l.loop->ReplaceInput(1, l.if_true);
+
+    Node* zero = Int32Constant(0);
+    Node* ret = graph()->NewNode(common()->Return(), zero, l.array, l.length,
+                                 l.if_false);
+    graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+    return l;
+  }
+
+ private:
+  SimplifiedOperatorBuilder simplified_;
+};
+
+TEST_F(LoopCheckHoistingTest, HoistsInvariantChecksAndLoads) {
+  ArrayLoop l = NewArrayLoop(nullptr, true, true);
+
+  EXPECT_EQ(4u, HoistChecks());
+
+  EXPECT_EQ(l.checkpoint, NodeProperties::GetEffectInput(l.check_maps));
+  EXPECT_EQ(start(), NodeProperties::GetControlInput(l.check_maps));
+  EXPECT_THAT(l.length, IsLoadField(AccessBuilder::ForJSArrayLength(
+                                        PACKED_ELEMENTS),
+                                    l.array, l.check_maps, start()));
+  EXPECT_EQ(l.length, NodeProperties::GetEffectInput(l.bounds));
+  EXPECT_EQ(start(), NodeProperties::GetControlInput(l.bounds));
+  EXPECT_THAT(l.elements, IsLoadField(AccessBuilder::ForJSObjectElements(),
+                                      l.array, l.bounds, start()));
+  EXPECT_THAT(l.effect_phi, IsEffectPhi(l.elements, l.load, l.loop));
+  EXPECT_EQ(l.effect_phi, NodeProperties::GetEffectInput(l.load));
+}
+
+TEST_F(LoopCheckHoistingTest, KeepsChecksBehindLoopExit) {
+  // A loop that is left before the bounds check must not fail the check.
+  ArrayLoop l = NewArrayLoop();
+
+  EXPECT_EQ(3u, HoistChecks());
+
+  EXPECT_EQ(start(), NodeProperties::GetControlInput(l.check_maps));
+  EXPECT_THAT(l.elements, IsLoadField(AccessBuilder::ForJSObjectElements(),
+                                      l.array, l.length, start()));
+  EXPECT_THAT(l.effect_phi, IsEffectPhi(l.elements, l.load, l.loop));
+  EXPECT_EQ(l.effect_phi, NodeProperties::GetEffectInput(l.bounds));
+  EXPECT_EQ(l.if_true, NodeProperties::GetControlInput(l.bounds));
+}
+
+TEST_F(LoopCheckHoistingTest, KeepsBoundsCheckOfInductionVariable) {
+  Node* phi = graph()->NewNode(common()->Phi(MachineRepresentation::kTagged, 2),
+                               Int32Constant(0), Int32Constant(1), start());
+  ArrayLoop l = NewArrayLoop(phi, true, true);
+
+  EXPECT_EQ(3u, HoistChecks());
+
+  EXPECT_THAT(l.effect_phi, IsEffectPhi(l.elements, l.load, l.loop));
+  EXPECT_EQ(l.effect_phi, NodeProperties::GetEffectInput(l.bounds));
+  EXPECT_EQ(l.loop, NodeProperties::GetControlInput(l.bounds));
+}
+
+TEST_F(LoopCheckHoistingTest, DoesNotHoistLoadsOfUncheckedObjects) {
+  ArrayLoop l = NewArrayLoop(nullptr, false);
+
+  EXPECT_EQ(0u, HoistChecks());
+
+  EXPECT_EQ(l.effect_phi, NodeProperties::GetEffectInput(l.length));
+  EXPECT_EQ(l.loop, NodeProperties::GetControlInput(l.length));
+}
+
+TEST_F(LoopCheckHoistingTest, DoesNotHoistFromLoopsWithWrites) {
+  ArrayLoop l = NewArrayLoop();
+  Node* store = graph()->NewNode(
+      simplified()->StoreField(AccessBuilder::ForJSObjectElements()),
+      l.array, Parameter(1), l.load, l.if_true);
+  l.effect_phi->ReplaceInput(1, store);
+
+  EXPECT_EQ(0u, HoistChecks());
+
+  EXPECT_EQ(l.effect_phi, NodeProperties::GetEffectInput(l.check_maps));
+  EXPECT_EQ(l.loop, NodeProperties::GetControlInput(l.check_maps));
+}
+
+TEST_F(LoopCheckHoistingTest, DoesNotHoistWithoutCheckpoint) {
+  ArrayLoop l = NewArrayLoop();
+  l.effect_phi->ReplaceInput(0, start());
+
+  EXPECT_EQ(0u, HoistChecks());
+
+  EXPECT_EQ(l.effect_phi, NodeProperties::GetEffectInput(l.check_maps));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
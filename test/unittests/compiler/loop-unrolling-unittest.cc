@@ -0,0 +1,235 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-unrolling.h"
+#include "src/compiler/graph-visualizer.h"
+#include "src/compiler/graph.h"
+#include "src/compiler/js-operator.h"
+#include "src/compiler/machine-operator.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/node.h"
+#include "test/unittests/compiler/graph-unittest.h"
+#include "test/unittests/compiler/node-test-utils.h"
+#include "testing/gmock-support.h"
+
+using testing::AllOf;
+using testing::Capture;
+using testing::CaptureEq;
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class LoopUnrollingTest : public GraphTest {
+ public:
+  LoopUnrollingTest() : GraphTest(1), machine_(zone()), javascript_(zone()) {}
+  ~LoopUnrollingTest() override = default;
+
+ protected:
+  struct While {
+    Node* loop;
+    Node* branch;
+    Node* if_true;
+    Node* if_false;
+    Node* exit;
+  };
+
+  struct Counter {
+    Node* base;
+    Node* inc;
+    Node* phi;
+    Node* add;
+    Node* exit_marker;
+  };
+
+  MachineOperatorBuilder* machine() { return &machine_; }
+  JSOperatorBuilder* javascript() { return &javascript_; }
+
+  LoopTree* GetLoopTree() {
+    if (FLAG_trace_turbo_graph) {
+      StdoutStream{} << AsRPO(*graph());
+    }
+    return LoopFinder::BuildLoopTree(graph(), tick_counter(), zone());
+  }
+
+  LoopUnroller Unroller(LoopTree* loop_tree) {
+    return LoopUnroller(graph(), common(), loop_tree, zone(),
+                        source_positions(), node_origins());
+  }
+
+  UnrolledIterations* UnrollOne(size_t count) {
+    LoopTree* loop_tree = GetLoopTree();
+    LoopTree::Loop* loop = loop_tree->outer_loops()[0];
+    LoopUnroller unroller = Unroller(loop_tree);
+    EXPECT_TRUE(unroller.CanUnroll(loop));
+    UnrolledIterations* iterations = unroller.Unroll(loop, count);
+    if (FLAG_trace_turbo_graph) {
+      StdoutStream{} << AsRPO(*graph());
+    }
+    return iterations;
+  }
+
+  Node* ExpectCopied(Node* node, UnrolledIterations* iterations,
+                     size_t iteration) {
+    Node* copy = iterations->map(node, iteration);
+    EXPECT_NE(node, copy);
+    return copy;
+  }
+
+  Node* InsertReturn(Node* val, Node* effect, Node* control) {
+    Node* zero = graph()->NewNode(common()->Int32Constant(0));
+    Node* r = graph()->NewNode(common()->Return(), zero, val, effect, control);
+    graph()->SetEnd(r);
+    return r;
+  }
+
+  While NewWhile(Node* cond, Node* control = nullptr) {
+    if (control == nullptr) control = start();
+    While w;
+    w.loop = graph()->NewNode(common()->Loop(2), control, control);
+    w.branch = graph()->NewNode(common()->Branch(), cond, w.loop);
+    w.if_true = graph()->NewNode(common()->IfTrue(), w.branch);
+    w.if_false = graph()->NewNode(common()->IfFalse(), w.branch);
+    w.exit = graph()->NewNode(common()->LoopExit(), w.if_false, w.loop);
+    w.loop->ReplaceInput(1, w.if_true);
+    return w;
+  }
+
+  void Nest(While* a, While* b) {
+    b->loop->ReplaceInput(1, a->exit);
+    a->loop->ReplaceInput(0, b->if_true);
+  }
+
+  Counter NewCounter(While* w, int32_t b, int32_t k) {
+    Counter c;
+    c.base = Int32Constant(b);
+    c.inc = Int32Constant(k);
+    c.phi = graph()->NewNode(common()->Phi(MachineRepresentation::kTagged, 2),
+                             c.base, c.base, w->loop);
+    c.add = graph()->NewNode(machine()->Int32Add(), c.phi, c.inc);
+    c.phi->ReplaceInput(1, c.add);
+    c.exit_marker = graph()->NewNode(common()->LoopExitValue(), c.phi, w->exit);
+    return c;
+  }
+
+ private:
+  MachineOperatorBuilder machine_;
+  JSOperatorBuilder javascript_;
+};
+
+TEST_F(LoopUnrollingTest, SimpleLoop) {
+  Node* p0 = Parameter(0);
+  While w = NewWhile(p0);
+  Node* r = InsertReturn(p0, start(), w.exit);
+
+  UnrolledIterations* iterations = UnrollOne(2);
+
+  Node* br1 = ExpectCopied(w.branch, iterations, 1);
+  Node* if_true1 = ExpectCopied(w.if_true, iterations, 1);
+  Node* if_false1 = ExpectCopied(w.if_false, iterations, 1);
+  Node* exit1 = ExpectCopied(w.exit, iterations, 1);
+
+  EXPECT_THAT(br1, IsBranch(p0, w.if_true));
+  EXPECT_THAT(if_true1, IsIfTrue(br1));
+  EXPECT_THAT(if_false1, IsIfFalse(br1));
+  EXPECT_EQ(IrOpcode::kLoopExit, exit1->opcode());
+  EXPECT_EQ(if_false1, exit1->InputAt(0));
+  EXPECT_EQ(w.loop, exit1->InputAt(1));
+
+  EXPECT_THAT(w.loop, IsLoop(start(), if_true1));
+  EXPECT_THAT(r, IsReturn(p0, start(), IsMerge(w.exit, exit1)));
+}
+
+TEST_F(LoopUnrollingTest, SimpleLoopWithCounter) {
+  Node* p0 = Parameter(0);
+  While w = NewWhile(p0);
+  Counter c = NewCounter(&w, 0, 1);
+  Node* r = InsertReturn(c.exit_marker, start(), w.exit);
+
+  UnrolledIterations* iterations = UnrollOne(3);
+
+  Node* add1 = ExpectCopied(c.add, iterations, 1);
+  Node* add2 = ExpectCopied(c.add, iterations, 2);
+  EXPECT_THAT(add1, IsInt32Add(c.add, c.inc));
+  EXPECT_THAT(add2, IsInt32Add(add1, c.inc));
+  EXPECT_THAT(c.phi, IsPhi(MachineRepresentation::kTagged, c.base, add2,
+                           w.loop));
+
+  Node* exit1 = ExpectCopied(w.exit, iterations, 1);
+  Node* exit2 = ExpectCopied(w.exit, iterations, 2);
+  Node* marker1 = ExpectCopied(c.exit_marker, iterations, 1);
+  Node* marker2 = ExpectCopied(c.exit_marker, iterations, 2);
+  EXPECT_EQ(c.add, marker1->InputAt(0));
+  EXPECT_EQ(add1, marker2->InputAt(0));
+
+  Capture<Node*> merge;
+  EXPECT_THAT(r, IsReturn(IsPhi(MachineRepresentation::kTagged, c.exit_marker,
+                                marker1, marker2,
+                                AllOf(CaptureEq(&merge),
+                                      IsMerge(w.exit, exit1, exit2))),
+                          start(), CaptureEq(&merge)));
+}
+
+TEST_F(LoopUnrollingTest, RemovesStackChecksOfCopies) {
+  Node* p0 = Parameter(0);
+  While w = NewWhile(p0);
+  Node* effect_phi =
+      graph()->NewNode(common()->EffectPhi(2), start(), start(), w.loop);
+  Node* stack_check = graph()->NewNode(
+      javascript()->StackCheck(StackCheckKind::kJSIterationBody),
+      UndefinedConstant(), EmptyFrameState(), effect_phi, w.if_true);
+  effect_phi->ReplaceInput(1, stack_check);
+  w.loop->ReplaceInput(1, stack_check);
+  Node* exit_effect =
+      graph()->NewNode(common()->LoopExitEffect(), effect_phi, w.exit);
+  Node* r = InsertReturn(p0, exit_effect, w.exit);
+  USE(r);
+
+  UnrolledIterations* iterations = UnrollOne(2);
+
+  // The copy of the body continues directly with the second iteration, only
+  // the original stack check remains.
+  Node* if_true1 = ExpectCopied(w.if_true, iterations, 1);
+  EXPECT_THAT(w.loop, IsLoop(start(), if_true1));
+  EXPECT_THAT(effect_phi, IsEffectPhi(start(), stack_check, w.loop));
+  EXPECT_THAT(ExpectCopied(w.branch, iterations, 1),
+              IsBranch(p0, stack_check));
+}
+
+TEST_F(LoopUnrollingTest, DoesNotUnrollOuterLoops) {
+  Node* p0 = Parameter(0);
+  While outer = NewWhile(p0);
+  While inner = NewWhile(p0);
+  Nest(&inner, &outer);
+  InsertReturn(p0, start(), outer.exit);
+
+  LoopTree* loop_tree = GetLoopTree();
+  LoopTree::Loop* outer_loop = loop_tree->ContainingLoop(outer.loop);
+  LoopTree::Loop* inner_loop = loop_tree->ContainingLoop(inner.loop);
+  EXPECT_FALSE(Unroller(loop_tree).CanUnroll(outer_loop));
+  EXPECT_EQ(0u, LoopUnroller::UnrollingCount(outer_loop));
+  EXPECT_TRUE(Unroller(loop_tree).CanUnroll(inner_loop));
+  EXPECT_EQ(LoopUnroller::kMaxUnrollingCount,
+            LoopUnroller::UnrollingCount(inner_loop));
+}
+
+TEST_F(LoopUnrollingTest, DoesNotUnrollTwoBackedgeLoop) {
+  Node* p0 = Parameter(0);
+  Node* loop = graph()->NewNode(common()->Loop(3), start(), start(), start());
+  Node* branch1 = graph()->NewNode(common()->Branch(), p0, loop);
+  Node* if_true1 = graph()->NewNode(common()->IfTrue(), branch1);
+  Node* if_false1 = graph()->NewNode(common()->IfFalse(), branch1);
+  Node* branch2 = graph()->NewNode(common()->Branch(), p0, if_true1);
+  loop->ReplaceInput(1, graph()->NewNode(common()->IfTrue(), branch2));
+  loop->ReplaceInput(2, graph()->NewNode(common()->IfFalse(), branch2));
+  Node* exit = graph()->NewNode(common()->LoopExit(), if_false1, loop);
+  InsertReturn(p0, start(), exit);
+
+  LoopTree* loop_tree = GetLoopTree();
+  EXPECT_FALSE(Unroller(loop_tree).CanUnroll(loop_tree->outer_loops()[0]));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,321 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-vectorization.h"
+#include "src/compiler/access-builder.h"
+#include "src/compiler/js-graph.h"
+#include "src/compiler/js-operator.h"
+#include "src/compiler/machine-operator.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+#include "test/unittests/compiler/graph-unittest.h"
+#include "test/unittests/compiler/node-test-utils.h"
+
+using testing::_;
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class LoopVectorizationTest : public GraphTest {
+ public:
+  LoopVectorizationTest()
+      : GraphTest(11),
+        machine_(zone()),
+        javascript_(zone()),
+        simplified_(zone()),
+        jsgraph_(isolate(), graph(), common(), &javascript_, &simplified_,
+                 &machine_) {}
+  ~LoopVectorizationTest() override = default;
+
+ protected:
+  // The nodes of the loop
+  //
+  //   for (i = 0; i < bound; ++i) <body>
+  //
+  // as produced by simplified lowering, where the body accesses the typed
+  // arrays given by the parameters 1 to 9.
+  struct Loop {
+    Node* loop;
+    Node* phi;
+    Node* effect_phi;
+    Node* if_true;
+    Node* if_false;
+  };
+
+  MachineOperatorBuilder* machine() { return &machine_; }
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+  Node* Invariant() { return Parameter(10); }
+
+  void BeginLoop() {
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) arrays_[i][j] = Parameter(1 + 3 * i + j);
+    }
+    Node* zero = Int32Constant(0);
+    l_.loop = graph()->NewNode(common()->Loop(2), start(), start());
+    l_.effect_phi =
+        graph()->NewNode(common()->EffectPhi(2), start(), start(), l_.loop);
+    l_.phi = graph()->NewNode(common()->Phi(MachineRepresentation::kWord32, 2),
+                              zero, zero, l_.loop);
+    Node* branch = graph()->NewNode(
+        common()->Branch(),
+        graph()->NewNode(machine()->Int32LessThan(), l_.phi, Parameter(0)),
+        l_.loop);
+    l_.if_true = graph()->NewNode(common()->IfTrue(), branch);
+    l_.if_false = graph()->NewNode(common()->IfFalse(), branch);
+    effect_ = l_.effect_phi;
+  }
+
+  Node* Load(ExternalArrayType type, int array, Node* index = nullptr) {
+    effect_ = graph()->NewNode(simplified()->LoadTypedElement(type),
+                               arrays_[array][0], arrays_[array][1],
+                               arrays_[array][2], index ? index : l_.phi,
+                               effect_, l_.if_true);
+    return effect_;
+  }
+
+  Node* Store(ExternalArrayType type, int array, Node* value,
+              Node* index = nullptr) {
+    effect_ = graph()->NewNode(simplified()->StoreTypedElement(type),
+                               arrays_[array][0], arrays_[array][1],
+                               arrays_[array][2], index ? index : l_.phi,
+                               value, effect_, l_.if_true);
+    return effect_;
+  }
+
+  // Checks the induction variable against the invariant {length}.
+  Node* CheckBounds(Node* length) {
+    effect_ = graph()->NewNode(
+        simplified()->CheckedUint32Bounds(FeedbackSource(), {}), l_.phi,
+        length, effect_, l_.if_true);
+    return effect_;
+  }
+
+  // Reloads the data pointer of {array} in each iteration, as it is without
+  // load elimination.
+  void LoadExternalPointerInLoop(int array) {
+    effect_ = graph()->NewNode(
+        simplified()->LoadField(AccessBuilder::ForJSTypedArrayExternalPointer()),
+        arrays_[array][0], effect_, l_.if_true);
+    arrays_[array][2] = effect_;
+  }
+
+  Node* Checkpoint(Node* value) {
+    Node* locals = graph()->NewNode(
+        common()->StateValues(1, SparseInputMask::Dense()), value);
+    Node* empty =
+        graph()->NewNode(common()->StateValues(0, SparseInputMask::Dense()));
+    FrameStateFunctionInfo const* function_info =
+        common()->CreateFrameStateFunctionInfo(
+            FrameStateType::kInterpretedFunction, 0, 1,
+            Handle<SharedFunctionInfo>());
+    Node* frame_state = graph()->NewNode(
+        common()->FrameState(BailoutId(0), OutputFrameStateCombine::Ignore(),
+                             function_info),
+        empty, locals, empty, NumberConstant(0), UndefinedConstant(), start());
+    effect_ = graph()->NewNode(common()->Checkpoint(), frame_state, effect_,
+                               l_.if_true);
+    return effect_;
+  }
+
+  Loop EndLoop(int32_t step = 1) {
+    Node* increment =
+        graph()->NewNode(machine()->Int32Add(), l_.phi, Int32Constant(step));
+    l_.loop->ReplaceInput(1, l_.if_true);
+    l_.effect_phi->ReplaceInput(1, effect_);
+    l_.phi->ReplaceInput(1, increment);
+    Node* ret = graph()->NewNode(common()->Return(), Int32Constant(0), l_.phi,
+                                 l_.effect_phi, l_.if_false);
+    graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+    return l_;
+  }
+
+  bool Vectorize() {
+    LoopTree* loop_tree =
+        LoopFinder::BuildLoopTree(graph(), tick_counter(), zone());
+    return LoopVectorizer(&jsgraph_, loop_tree, zone(), source_positions(),
+                          node_origins())
+        .Vectorize(loop_tree->outer_loops()[0]);
+  }
+
+  // Returns the last effect in the vector loop in front of {l}.
+  Node* VectorBody(const Loop& l) {
+    Node* effect = NodeProperties::GetEffectInput(l.effect_phi, 0);
+    if (NodeProperties::GetControlInput(effect)->opcode() == IrOpcode::kMerge) {
+      effect = NodeProperties::GetEffectInput(effect, 0);
+    }
+    EXPECT_EQ(IrOpcode::kEffectPhi, effect->opcode());
+    return NodeProperties::GetEffectInput(effect, 1);
+  }
+
+ private:
+  MachineOperatorBuilder machine_;
+  JSOperatorBuilder javascript_;
+  SimplifiedOperatorBuilder simplified_;
+  JSGraph jsgraph_;
+  Node* arrays_[3][3];
+  Loop l_;
+  Node* effect_ = nullptr;
+};
+
+TEST_F(LoopVectorizationTest, VectorizesFloat64Add) {
+  BeginLoop();
+  Node* a = Load(kExternalFloat64Array, 0);
+  Node* b = Load(kExternalFloat64Array, 1);
+  Store(kExternalFloat64Array, 2,
+        graph()->NewNode(machine()->Float64Add(), a, b));
+  Loop l = EndLoop();
+
+  EXPECT_TRUE(Vectorize());
+
+  // The vector loop is skipped if the arrays overlap.
+  Node* merge = NodeProperties::GetControlInput(l.loop, 0);
+  EXPECT_THAT(merge, IsMerge(IsIfFalse(_), IsIfFalse(IsBranch(_, start()))));
+  EXPECT_THAT(l.phi->InputAt(0),
+              IsPhi(MachineRepresentation::kWord32, _, _, merge));
+  Node* vector_phi = l.phi->InputAt(0)->InputAt(0);
+  EXPECT_EQ(IrOpcode::kPhi, vector_phi->opcode());
+  EXPECT_THAT(vector_phi->InputAt(1),
+              IsInt32Add(vector_phi, IsInt32Constant(2)));
+
+  Node* store = VectorBody(l);
+  EXPECT_EQ(IrOpcode::kStoreTypedElementSimd128, store->opcode());
+  Node* add = NodeProperties::GetValueInput(store, 4);
+  EXPECT_EQ(IrOpcode::kF64x2Add, add->opcode());
+  EXPECT_EQ(IrOpcode::kLoadTypedElementSimd128, add->InputAt(0)->opcode());
+  EXPECT_EQ(IrOpcode::kLoadTypedElementSimd128, add->InputAt(1)->opcode());
+}
+
+TEST_F(LoopVectorizationTest, VectorizesInt32MulInPlace) {
+  BeginLoop();
+  Node* a = Load(kExternalInt32Array, 0);
+  Store(kExternalInt32Array, 0,
+        graph()->NewNode(machine()->Int32Mul(), a, Invariant()));
+  Loop l = EndLoop();
+
+  EXPECT_TRUE(Vectorize());
+
+  // A single array does not need an overlap check.
+  EXPECT_THAT(NodeProperties::GetControlInput(l.loop, 0),
+              IsIfFalse(IsBranch(_, IsLoop(start(), _))));
+  Node* store = VectorBody(l);
+  EXPECT_EQ(IrOpcode::kStoreTypedElementSimd128, store->opcode());
+  Node* mul = NodeProperties::GetValueInput(store, 4);
+  EXPECT_EQ(IrOpcode::kI32x4Mul, mul->opcode());
+  EXPECT_EQ(IrOpcode::kI32x4Splat, mul->InputAt(1)->opcode());
+}
+
+TEST_F(LoopVectorizationTest, VectorizesInt32ShiftAndXor) {
+  BeginLoop();
+  Node* a = Load(kExternalInt32Array, 0);
+  Node* shifted = graph()->NewNode(machine()->Word32Sar(), a, Int32Constant(3));
+  Store(kExternalInt32Array, 1,
+        graph()->NewNode(machine()->Word32Xor(), shifted, Invariant()));
+  Loop l = EndLoop();
+
+  EXPECT_TRUE(Vectorize());
+
+  Node* store = VectorBody(l);
+  EXPECT_EQ(IrOpcode::kStoreTypedElementSimd128, store->opcode());
+  Node* xor_node = NodeProperties::GetValueInput(store, 4);
+  EXPECT_EQ(IrOpcode::kS128Xor, xor_node->opcode());
+  EXPECT_EQ(IrOpcode::kI32x4Splat, xor_node->InputAt(1)->opcode());
+  // The shift amount stays scalar.
+  Node* shift = xor_node->InputAt(0);
+  EXPECT_EQ(IrOpcode::kI32x4ShrS, shift->opcode());
+  EXPECT_THAT(shift->InputAt(1), IsInt32Constant(3));
+}
+
+TEST_F(LoopVectorizationTest, ChecksBoundsOfLastLane) {
+  BeginLoop();
+  Node* index = CheckBounds(Invariant());
+  Node* a = Load(kExternalFloat64Array, 0, index);
+  Store(kExternalFloat64Array, 0,
+        graph()->NewNode(machine()->Float64Abs(), a), index);
+  Loop l = EndLoop();
+
+  EXPECT_TRUE(Vectorize());
+
+  Node* store = VectorBody(l);
+  EXPECT_EQ(IrOpcode::kStoreTypedElementSimd128, store->opcode());
+  Node* check = NodeProperties::GetEffectInput(
+      NodeProperties::GetEffectInput(store));
+  EXPECT_EQ(IrOpcode::kCheckedUint32Bounds, check->opcode());
+  Node* vector_phi = NodeProperties::GetValueInput(store, 3);
+  EXPECT_EQ(IrOpcode::kPhi, vector_phi->opcode());
+  EXPECT_THAT(check->InputAt(0), IsInt32Add(vector_phi, IsInt32Constant(1)));
+  EXPECT_EQ(Invariant(), check->InputAt(1));
+}
+
+TEST_F(LoopVectorizationTest, RefersToFirstLaneInFrameStateBeforeStore) {
+  BeginLoop();
+  Node* a = Load(kExternalFloat64Array, 0);
+  Node* checkpoint = Checkpoint(a);
+  Store(kExternalFloat64Array, 0,
+        graph()->NewNode(machine()->Float64Neg(), a));
+  Loop l = EndLoop();
+
+  EXPECT_TRUE(Vectorize());
+
+  Node* vector_checkpoint = NodeProperties::GetEffectInput(VectorBody(l));
+  EXPECT_NE(checkpoint, vector_checkpoint);
+  EXPECT_EQ(IrOpcode::kCheckpoint, vector_checkpoint->opcode());
+  Node* locals = NodeProperties::GetFrameStateInput(vector_checkpoint)
+                     ->InputAt(kFrameStateLocalsInput);
+  EXPECT_EQ(IrOpcode::kF64x2ExtractLane, locals->InputAt(0)->opcode());
+}
+
+TEST_F(LoopVectorizationTest, RejectsElementInFrameStateAfterStore) {
+  BeginLoop();
+  Node* a = Load(kExternalFloat64Array, 0);
+  Store(kExternalFloat64Array, 1, a);
+  Checkpoint(a);
+  EndLoop();
+
+  EXPECT_FALSE(Vectorize());
+}
+
+TEST_F(LoopVectorizationTest, RejectsMixedElementTypes) {
+  BeginLoop();
+  Node* a = Load(kExternalFloat64Array, 0);
+  Load(kExternalInt32Array, 1);
+  Store(kExternalFloat64Array, 2, a);
+  EndLoop();
+
+  EXPECT_FALSE(Vectorize());
+}
+
+TEST_F(LoopVectorizationTest, RejectsUnsupportedOperation) {
+  BeginLoop();
+  Node* a = Load(kExternalFloat64Array, 0);
+  Store(kExternalFloat64Array, 1,
+        graph()->NewNode(machine()->Float64Max(), a, Invariant()));
+  EndLoop();
+
+  EXPECT_FALSE(Vectorize());
+}
+
+TEST_F(LoopVectorizationTest, RejectsArrayReloadedInLoop) {
+  BeginLoop();
+  LoadExternalPointerInLoop(0);
+  Node* a = Load(kExternalInt32Array, 0);
+  Store(kExternalInt32Array, 1, a);
+  EndLoop();
+
+  EXPECT_FALSE(Vectorize());
+}
+
+TEST_F(LoopVectorizationTest, RejectsNonUnitStep) {
+  BeginLoop();
+  Node* a = Load(kExternalInt32Array, 0);
+  Store(kExternalInt32Array, 1, a);
+  EndLoop(2);
+
+  EXPECT_FALSE(Vectorize());
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
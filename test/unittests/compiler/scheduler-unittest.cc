@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "src/compiler/scheduler.h"
+#include "src/builtins/profile-data-reader.h"
 #include "src/codegen/tick-counter.h"
 #include "src/compiler/access-builder.h"
 #include "src/compiler/common-operator.h"
@@ -638,6 +639,62 @@ TARGET_TEST_F(SchedulerTest, Switch) {
 }
 
 
+namespace {
+
+class TestProfileData : public ProfileDataFromFile {
+ public:
+  void SetCounter(size_t block_id, uint32_t count) {
+    if (block_counts_by_id_.size() <= block_id) {
+      block_counts_by_id_.resize(block_id + 1, 0);
+    }
+    block_counts_by_id_[block_id] = count;
+  }
+};
+
+}  // namespace
+
+
+TARGET_TEST_F(SchedulerTest, SwitchWithProfileData) {
+  Node* start = graph()->NewNode(common()->Start(1));
+  graph()->SetStart(start);
+
+  Node* p0 = graph()->NewNode(common()->Parameter(0), start);
+  Node* sw = graph()->NewNode(common()->Switch(3), p0, start);
+  Node* c0 = graph()->NewNode(common()->IfValue(0), sw);
+  Node* v0 = graph()->NewNode(common()->Int32Constant(11));
+  Node* c1 = graph()->NewNode(common()->IfValue(1), sw);
+  Node* v1 = graph()->NewNode(common()->Int32Constant(22));
+  Node* d = graph()->NewNode(common()->IfDefault(), sw);
+  Node* vd = graph()->NewNode(common()->Int32Constant(33));
+  Node* m = graph()->NewNode(common()->Merge(3), c0, c1, d);
+  Node* phi = graph()->NewNode(common()->Phi(MachineRepresentation::kWord32, 3),
+                               v0, v1, vd, m);
+  Node* zero = graph()->NewNode(common()->Int32Constant(0));
+  Node* ret = graph()->NewNode(common()->Return(), zero, phi, start, m);
+  Node* end = graph()->NewNode(common()->End(1), ret);
+
+  graph()->SetEnd(end);
+
+  // Block IDs are deterministic, so a first schedule tells us which blocks
+  // the profile data has to refer to.
+  Schedule* schedule = ComputeAndVerifySchedule(17);
+  TestProfileData profile_data;
+  profile_data.SetCounter(schedule->block(c0)->id().ToSize(), 1000000);
+  profile_data.SetCounter(schedule->block(c1)->id().ToSize(), 100);
+  profile_data.SetCounter(schedule->block(d)->id().ToSize(), 1000);
+
+  schedule = Scheduler::ComputeSchedule(zone(), graph(), Scheduler::kSplitNodes,
+                                        tick_counter(), &profile_data);
+  ScheduleVerifier::Run(schedule);
+
+  // Make sure only the rarely taken case is marked as deferred.
+  EXPECT_FALSE(schedule->block(c0)->deferred());
+  EXPECT_TRUE(schedule->block(c1)->deferred());
+  EXPECT_FALSE(schedule->block(d)->deferred());
+  EXPECT_FALSE(schedule->block(m)->deferred());
+}
+
+
 TARGET_TEST_F(SchedulerTest, FloatingSwitch) {
   Node* start = graph()->NewNode(common()->Start(1));
   graph()->SetStart(start);
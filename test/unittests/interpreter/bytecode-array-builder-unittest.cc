@@ -434,6 +434,9 @@ TEST_F(BytecodeArrayBuilderTest, AllBytecodesGenerated) {
   // Emit block counter increments.
   builder.IncBlockCounter(0);
 
+  // Emit branch counter increments.
+  builder.IncBranchCounter(0);
+
   // Bind labels for long jumps at the very end.
   for (size_t i = 0; i < arraysize(end); i++) {
     builder.Bind(&end[i]);
@@ -70,6 +70,8 @@ class RuntimeCallStatsTest : public TestWithNativeContext {
     // printing the tests table. Comment the following line for debugging
     // purposes.
     TracingFlags::runtime_stats.store(0, std::memory_order_relaxed);
+    TracingFlags::runtime_stats_sampling_interval.store(
+        0, std::memory_order_relaxed);
   }
 
   static void SetUpTestCase() {
@@ -572,6 +574,118 @@ TEST_F(RuntimeCallStatsTest, NestedScopes) {
   EXPECT_EQ(100, counter3()->time().InMicroseconds());
 }
 
+TEST_F(RuntimeCallStatsTest, SampledScopes) {
+  TracingFlags::runtime_stats.store(
+      v8::tracing::TracingCategoryObserver::ENABLED_BY_SAMPLED_STATS,
+      std::memory_order_relaxed);
+  TracingFlags::runtime_stats_sampling_interval.store(
+      3, std::memory_order_relaxed);
+  for (int i = 0; i < 9; i++) {
+    RuntimeCallTimerScope scope(stats(), counter_id());
+    Sleep(10);
+  }
+  EXPECT_EQ(3, counter()->count());
+  EXPECT_EQ(30, counter()->time().InMicroseconds());
+
+  // Skipped scopes do not hide the scopes nested in them from sampling, and
+  // scopes nested in a recorded scope are always recorded.
+  for (int i = 0; i < 3; i++) {
+    RuntimeCallTimerScope scope(stats(), counter_id2());
+    Sleep(10);
+    {
+      RuntimeCallTimerScope inner_scope(stats(), counter_id3());
+      Sleep(5);
+    }
+  }
+  TracingFlags::runtime_stats_sampling_interval.store(
+      0, std::memory_order_relaxed);
+  EXPECT_EQ(1, counter2()->count());
+  EXPECT_EQ(10, counter2()->time().InMicroseconds());
+  EXPECT_EQ(1, counter3()->count());
+  EXPECT_EQ(5, counter3()->time().InMicroseconds());
+
+  ASSERT_TRUE(counter()->has_histogram());
+  // 10us and 5us fall into [4, 16).
+  EXPECT_EQ(3, counter()->histogram()[2]);
+  EXPECT_EQ(1, counter2()->histogram()[2]);
+  EXPECT_EQ(1, counter3()->histogram()[2]);
+}
+
+TEST_F(RuntimeCallStatsTest, OtherModesAreNotSampled) {
+  // Runtime call stats enabled by flags or tracing record all scopes, also
+  // while sampled runtime call stats are enabled.
+  TracingFlags::runtime_stats_sampling_interval.store(
+      3, std::memory_order_relaxed);
+  TracingFlags::runtime_stats.store(
+      v8::tracing::TracingCategoryObserver::ENABLED_BY_TRACING |
+          v8::tracing::TracingCategoryObserver::ENABLED_BY_SAMPLED_STATS,
+      std::memory_order_relaxed);
+  for (int i = 0; i < 3; i++) {
+    RuntimeCallTimerScope scope(stats(), counter_id());
+    Sleep(10);
+  }
+  EXPECT_EQ(3, counter()->count());
+  EXPECT_EQ(30, counter()->time().InMicroseconds());
+
+  TracingFlags::runtime_stats.store(
+      v8::tracing::TracingCategoryObserver::ENABLED_BY_NATIVE,
+      std::memory_order_relaxed);
+  for (int i = 0; i < 3; i++) {
+    RuntimeCallTimerScope scope(stats(), counter_id2());
+    Sleep(10);
+  }
+  EXPECT_EQ(3, counter2()->count());
+  EXPECT_EQ(30, counter2()->time().InMicroseconds());
+}
+
+TEST_F(RuntimeCallStatsTest, TakeHistograms) {
+  TracingFlags::runtime_stats.store(
+      v8::tracing::TracingCategoryObserver::ENABLED_BY_SAMPLED_STATS,
+      std::memory_order_relaxed);
+  TracingFlags::runtime_stats_sampling_interval.store(
+      1, std::memory_order_relaxed);
+  {
+    RuntimeCallTimerScope scope(stats(), counter_id());
+    Sleep(2);
+  }
+  {
+    RuntimeCallTimerScope scope(stats(), counter_id());
+    Sleep(100);
+  }
+  {
+    RuntimeCallTimerScope scope(stats(), counter_id2());
+    Sleep(20);
+
+    std::vector<debug::RuntimeCallCounterHistogram> histograms;
+    stats()->TakeHistograms(
+        [&histograms](const debug::RuntimeCallCounterHistogram& histogram) {
+          histograms.push_back(histogram);
+        });
+    ASSERT_EQ(2u, histograms.size());
+    const debug::RuntimeCallCounterHistogram* first = &histograms[0];
+    const debug::RuntimeCallCounterHistogram* second = &histograms[1];
+    if (strcmp(first->name, counter()->name()) != 0) std::swap(first, second);
+    EXPECT_STREQ(counter()->name(), first->name);
+    EXPECT_EQ(2, first->count);
+    EXPECT_EQ(102, first->time.InMicroseconds());
+    EXPECT_EQ(1, first->buckets[1]);
+    EXPECT_EQ(1, first->buckets[4]);
+    // The active scope is reported with the time elapsed so far.
+    EXPECT_STREQ(counter2()->name(), second->name);
+    EXPECT_EQ(0, second->count);
+    EXPECT_EQ(20, second->time.InMicroseconds());
+
+    EXPECT_EQ(0, counter()->count());
+    EXPECT_EQ(0, counter()->histogram()[1]);
+    Sleep(10);
+  }
+  TracingFlags::runtime_stats_sampling_interval.store(
+      0, std::memory_order_relaxed);
+  // The active timer kept running across TakeHistograms.
+  EXPECT_EQ(1, counter2()->count());
+  EXPECT_EQ(10, counter2()->time().InMicroseconds());
+}
+
 TEST_F(RuntimeCallStatsTest, BasicJavaScript) {
   RuntimeCallCounter* counter =
       stats()->GetCounter(RuntimeCallCounterId::kJS_Execution);
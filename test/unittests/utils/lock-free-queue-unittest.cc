@@ -0,0 +1,114 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/utils/lock-free-queue-inl.h"
+
+#include <memory>
+#include <vector>
+
+#include "src/base/platform/platform.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+using Record = int;
+
+}  // namespace
+
+namespace v8 {
+namespace internal {
+
+TEST(LockFreeQueue, ConstructorEmpty) {
+  LockFreeQueue<Record> queue;
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(LockFreeQueue, SingleRecordEnqueueDequeue) {
+  LockFreeQueue<Record> queue;
+  EXPECT_TRUE(queue.IsEmpty());
+  queue.Enqueue(1);
+  EXPECT_FALSE(queue.IsEmpty());
+  Record a = -1;
+  bool success = queue.Dequeue(&a);
+  EXPECT_TRUE(success);
+  EXPECT_EQ(a, 1);
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(LockFreeQueue, DequeueOnEmpty) {
+  LockFreeQueue<Record> queue;
+  Record a = -1;
+  EXPECT_FALSE(queue.Dequeue(&a));
+  EXPECT_EQ(a, -1);
+}
+
+TEST(LockFreeQueue, MultipleRecords) {
+  LockFreeQueue<Record> queue;
+  for (int i = 1; i <= 5; ++i) {
+    queue.Enqueue(i);
+    EXPECT_FALSE(queue.IsEmpty());
+  }
+  Record rec = 0;
+  for (int i = 1; i <= 4; ++i) {
+    EXPECT_TRUE(queue.Dequeue(&rec));
+    EXPECT_EQ(i, rec);
+  }
+  for (int i = 6; i <= 12; ++i) queue.Enqueue(i);
+  for (int i = 5; i <= 12; ++i) {
+    EXPECT_TRUE(queue.Dequeue(&rec));
+    EXPECT_EQ(i, rec);
+  }
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+namespace {
+
+class ProducerThread final : public base::Thread {
+ public:
+  ProducerThread(LockFreeQueue<Record>* queue, int id, int count)
+      : base::Thread(base::Thread::Options("ProducerThread")),
+        queue_(queue),
+        id_(id),
+        count_(count) {}
+
+  void Run() override {
+    for (int i = 0; i < count_; ++i) queue_->Enqueue(id_ * count_ + i);
+  }
+
+ private:
+  LockFreeQueue<Record>* queue_;
+  int id_;
+  int count_;
+};
+
+}  // namespace
+
+TEST(LockFreeQueue, MultipleProducers) {
+  constexpr int kProducers = 4;
+  constexpr int kRecordsPerProducer = 10000;
+  LockFreeQueue<Record> queue;
+  std::vector<std::unique_ptr<ProducerThread>> producers;
+  for (int i = 0; i < kProducers; ++i) {
+    producers.push_back(
+        std::make_unique<ProducerThread>(&queue, i, kRecordsPerProducer));
+    CHECK(producers.back()->Start());
+  }
+  // Records of each producer must come out in the order they were enqueued.
+  std::vector<int> last_seen(kProducers, -1);
+  int dequeued = 0;
+  while (dequeued < kProducers * kRecordsPerProducer) {
+    Record rec;
+    if (!queue.Dequeue(&rec)) continue;
+    int producer = rec / kRecordsPerProducer;
+    int index = rec % kRecordsPerProducer;
+    EXPECT_LT(last_seen[producer], index);
+    last_seen[producer] = index;
+    ++dequeued;
+  }
+  for (auto& producer : producers) producer->Join();
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+}  // namespace internal
+}  // namespace v8
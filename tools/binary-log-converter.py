@@ -0,0 +1,156 @@
+#!/usr/bin/env python
+# Copyright 2020 the V8 project authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+"""Converts a log written with --log-binary to the text log format.
+
+The output can be processed with the usual tools, e.g.
+
+  tools/binary-log-converter.py v8.log v8-text.log
+  tools/linux-tick-processor v8-text.log
+
+See src/logging/binary-log.h for a description of the format.
+"""
+
+# for py2/py3 compatibility
+from __future__ import print_function
+
+import argparse
+import sys
+
+MAGIC = b"V8BL"
+VERSION = 1
+
+# BinaryLogWriter::RecordType
+RECORD_TEXT = 0
+RECORD_CODE_CREATION = 1
+RECORD_MOVE = 2
+RECORD_TICK = 3
+
+
+class Reader(object):
+  def __init__(self, data, pos=0, end=None):
+    self.data = data
+    self.pos = pos
+    self.end = len(data) if end is None else end
+
+  def done(self):
+    return self.pos >= self.end
+
+  def byte(self):
+    value = bytearray(self.data[self.pos:self.pos + 1])[0]
+    self.pos += 1
+    return value
+
+  def varint(self):
+    result = 0
+    shift = 0
+    while True:
+      byte = self.byte()
+      result |= (byte & 0x7f) << shift
+      if byte < 0x80:
+        return result
+      shift += 7
+
+  def string(self):
+    length = self.varint()
+    value = self.data[self.pos:self.pos + length]
+    self.pos += length
+    return value.decode("latin-1")
+
+
+def Pointer(value):
+  return "0x%x" % value
+
+
+def ReadRecord(reader, names):
+  sequence_number = reader.varint()
+  record_type = reader.byte()
+  if record_type == RECORD_TEXT:
+    return sequence_number, reader.string()
+  if record_type == RECORD_CODE_CREATION:
+    tag = reader.varint()
+    kind = reader.varint()
+    timestamp = reader.varint()
+    address = reader.varint()
+    size = reader.varint()
+    columns = [names["code-creation"], names[tag], str(kind), str(timestamp),
+               Pointer(address), str(size), reader.string()]
+    return sequence_number, ",".join(columns)
+  if record_type == RECORD_MOVE:
+    event = reader.varint()
+    from_address = reader.varint()
+    to_address = reader.varint()
+    columns = [names[event], Pointer(from_address), Pointer(to_address)]
+    return sequence_number, ",".join(columns)
+  if record_type == RECORD_TICK:
+    pc = reader.varint()
+    timestamp = reader.varint()
+    has_external_callback = reader.varint()
+    tos_or_callback = reader.varint()
+    state = reader.varint()
+    overflow = reader.varint()
+    frames_count = reader.varint()
+    columns = [names["tick"], Pointer(pc), str(timestamp),
+               str(has_external_callback), Pointer(tos_or_callback),
+               str(state)]
+    if overflow:
+      columns.append("overflow")
+    for _ in range(frames_count):
+      columns.append(Pointer(reader.varint()))
+    return sequence_number, ",".join(columns)
+  raise ValueError("Unknown record type %d at offset %d" %
+                   (record_type, reader.pos - 1))
+
+
+def Convert(data):
+  if data[:len(MAGIC)] != MAGIC:
+    raise ValueError("Not a binary V8 log")
+  reader = Reader(data, len(MAGIC))
+  version = reader.varint()
+  if version != VERSION:
+    raise ValueError("Unsupported binary log version %d" % version)
+
+  # Event names are looked up both by index and by name.
+  names = {}
+  for index in range(reader.varint()):
+    name = reader.string()
+    names[index] = name
+    names[name] = name
+
+  # Chunks of different threads are not ordered, so collect all records and
+  # restore the order from their sequence numbers.
+  records = []
+  while not reader.done():
+    chunk_size = reader.varint()
+    chunk = Reader(data, reader.pos, reader.pos + chunk_size)
+    while not chunk.done():
+      records.append(ReadRecord(chunk, names))
+    reader.pos = chunk.end
+  records.sort(key=lambda record: record[0])
+  return [line for _, line in records]
+
+
+def Main():
+  parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+  parser.add_argument("input", help="binary log file")
+  parser.add_argument("output", nargs="?",
+                      help="text log file, defaults to stdout")
+  args = parser.parse_args()
+
+  with open(args.input, "rb") as f:
+    lines = Convert(f.read())
+  output = open(args.output, "w") if args.output else sys.stdout
+  try:
+    for line in lines:
+      output.write(line)
+      output.write("\n")
+  finally:
+    if args.output:
+      output.close()
+  return 0
+
+
+if __name__ == "__main__":
+  sys.exit(Main())